@@ -1,30 +1,38 @@
 // Xonix Game - DSA Project
 // Hash Table for fast player lookup by username
-// Uses chaining (linked list) for collision resolution
+// Open addressing with Robin Hood probing - slots live in one contiguous array
 
 #pragma once
 #include <string>
 using namespace std;
 
+// One slot of the table - keys stored inline (short usernames stay in std::string's SSO buffer)
 struct HashNode
 {
     string username;  // Key
     string playerId;  // Value - maps to player file
     int arrayIndex;   // Index in player array
-    HashNode *next;   // For chaining
+    unsigned int hash; // Cached full hash, compared before the key
+    int distance;     // Probe distance from home slot, -1 = empty
 
+    HashNode();
     HashNode(const string &user, const string &id, int idx);
 };
 
-// Hash Table with chaining - maps username to player ID
+// Hash Table with Robin Hood open addressing - maps username to player ID
+// Grows by doubling once count passes 7/8 of capacity
 class HashTable
 {
 private:
-    static const int TABLE_SIZE = 53;  // Prime number for better distribution
-    HashNode *table[TABLE_SIZE];
+    static const int INITIAL_CAPACITY = 64;  // Power of two, mask instead of modulo
+    HashNode *table;
+    int capacity;
     int count;
 
-    int hashFunction(const string &username) const;
+    unsigned int hashFunction(const string &username) const;
+    int findSlot(const string &username, unsigned int hash) const;
+    void place(HashNode &entry);
+    void grow();
 
 public:
     HashTable();
@@ -38,5 +46,6 @@ public:
     bool remove(const string &username);
     void clear();
     int getCount() const;
+    int getCapacity() const;
     void display() const;
 };
@@ -68,7 +68,7 @@ public:
         }
     }
 
-    bool isEmpty()
+    bool isEmpty() const
     {
         return !head;
     }
@@ -86,7 +86,7 @@ public:
         return temp1;
     }
 
-    bool search(string value)
+    bool search(string value) const
     {
         NodeList *curr = head;
         while (curr != nullptr)
@@ -48,12 +48,12 @@ public:
         return head->data;
     }
 
-    bool isEmpty()
+    bool isEmpty() const
     {
         return !head;
     }
 
-    int size()
+    int size() const
     {
         int count = 0;
         node *current = head;
@@ -85,7 +85,7 @@ public:
         cout << endl;
     }
 
-    bool search(string value)
+    bool search(string value) const
     {
         if (isEmpty())
             return false;
@@ -0,0 +1,158 @@
+// Xonix Game
+// Asset cache - every font, texture and sound is decoded once per process and shared by path
+// Screens hold AssetRef handles; an asset nobody holds stays resident until trim() or the budget
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <string>
+
+using namespace std;
+using namespace sf;
+
+enum AssetKind
+{
+    ASSET_TEXTURE,
+    ASSET_SMOOTH_TEXTURE,  // Same file with linear filtering - its own entry, filtering is per texture
+    ASSET_FONT,
+    ASSET_SOUND
+};
+
+// One decoded file - never moves, so sprites and texts may keep pointers into it
+struct AssetEntry
+{
+    string path;
+    AssetKind kind;
+    void *asset;        // Texture (either texture kind), Font or SoundBuffer
+    char *data;         // Font file read into memory by the preloader - the font reads from it
+    bool loaded;        // False if the file failed to decode - the asset is then empty
+    int refs;           // Live handles
+    long long bytes;    // Decoded size (pixels, samples; file size for fonts)
+    float loadMs;
+    AssetEntry *chain;  // Next entry in the same bucket
+
+    AssetEntry(const string &assetPath, AssetKind assetKind);
+    ~AssetEntry();
+    AssetEntry(const AssetEntry &) = delete;
+    AssetEntry &operator=(const AssetEntry &) = delete;
+};
+
+// Counted handle to a cached asset - dereferences to an empty asset if the file failed to load
+template <typename T>
+class AssetRef
+{
+private:
+    AssetEntry *entry;
+
+    void release()
+    {
+        if (entry)
+            entry->refs--;
+        entry = nullptr;
+    }
+
+public:
+    AssetRef() : entry(nullptr) {}
+
+    explicit AssetRef(AssetEntry *e) : entry(e)
+    {
+        if (entry)
+            entry->refs++;
+    }
+
+    AssetRef(const AssetRef &other) : entry(other.entry)
+    {
+        if (entry)
+            entry->refs++;
+    }
+
+    AssetRef &operator=(const AssetRef &other)
+    {
+        if (entry != other.entry)
+        {
+            release();
+            entry = other.entry;
+            if (entry)
+                entry->refs++;
+        }
+        return *this;
+    }
+
+    ~AssetRef()
+    {
+        release();
+    }
+
+    bool isLoaded() const
+    {
+        return entry && entry->loaded;
+    }
+
+    const T &operator*() const
+    {
+        return *static_cast<const T *>(entry->asset);
+    }
+
+    const T *operator->() const
+    {
+        return static_cast<const T *>(entry->asset);
+    }
+};
+
+// Process-wide cache keyed by path
+class AssetCache
+{
+private:
+    static const int BUCKET_COUNT = 127;
+    static const long long DEFAULT_BUDGET = 256LL * 1024 * 1024;
+
+    AssetEntry *buckets[BUCKET_COUNT];
+    int count;
+    long long bytes;
+    long long budget;  // Past this, unreferenced assets are dropped after each load
+
+    long long hits;
+    long long misses;
+    long long failures;
+    long long evictions;
+    double loadMs;     // Time spent decoding, all misses
+
+    AssetCache();
+    ~AssetCache();
+    AssetCache(const AssetCache &) = delete;
+    AssetCache &operator=(const AssetCache &) = delete;
+
+    int bucketOf(const string &path) const;
+    AssetEntry *find(const string &path, AssetKind kind) const;
+    AssetEntry *acquire(const string &path, AssetKind kind);
+    void decode(AssetEntry *e);
+    AssetEntry *adopt(const string &path, AssetKind kind, float decodeMs);
+    void adopted(AssetEntry *e, bool loaded, long long size);
+    void removeEntry(AssetEntry *e);
+
+public:
+    static AssetCache &instance();
+
+    // Cached asset, decoded now on the first request (or if an earlier attempt failed).
+    // Smooth and unsmoothed textures of one path are separate entries; the smooth one is
+    // copied from the other if that is already loaded
+    AssetRef<Texture> texture(const string &path, bool smooth = false);
+    AssetRef<Font> font(const string &path);
+    AssetRef<SoundBuffer> sound(const string &path);
+
+    // Hand over an asset decoded on another thread (AssetPreloader); call from the render thread.
+    // The cache takes ownership of `data` and `sound`. Ignored if the path is already loaded
+    void adoptTexture(const string &path, const Image &image, float decodeMs);
+    void adoptFont(const string &path, char *data, long long size, float decodeMs);
+    void adoptSound(const string &path, SoundBuffer *sound, float decodeMs);
+
+    int trim();  // Drop every asset no handle holds; returns how many
+
+    void setBudget(long long maxBytes);
+    int getSize() const;
+    long long getBytes() const;
+    long long getHits() const;
+    long long getMisses() const;
+    double getLoadMs() const;
+    void displayStats() const;
+};
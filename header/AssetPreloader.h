@@ -0,0 +1,65 @@
+// Xonix Game
+// Startup asset preloader - files are decoded in parallel on a TaskPool, and finished decodes
+// reach the render thread through a lock-free queue; the render thread uploads them into the AssetCache
+
+#pragma once
+#include <atomic>
+#include <string>
+#include "AssetCache.h"
+#include "TaskPool.h"
+
+using namespace std;
+
+class AssetPreloader;
+
+// One file, decoded off the render thread into whatever does not need a GL context
+struct PreloadJob
+{
+    AssetPreloader *owner;
+    string path;
+    AssetKind kind;
+    Image image;         // Texture pixels
+    char *data;          // Font file
+    long long size;
+    SoundBuffer *sound;  // Sounds decode completely on the worker
+    float decodeMs;
+
+    PreloadJob();
+    ~PreloadJob();
+    PreloadJob(const PreloadJob &) = delete;
+    PreloadJob &operator=(const PreloadJob &) = delete;
+};
+
+class AssetPreloader
+{
+private:
+    PreloadJob *jobs;
+    int jobCount;
+    TaskPool *pool;
+
+    // Completion queue, one slot per job so it never wraps: a worker claims the next slot and
+    // publishes into it; only the render thread reads, in slot order
+    PreloadJob **finished;
+    std::atomic<bool> *published;
+    std::atomic<int> claimed;
+    int consumed;
+
+    static void decodeJob(void *arg);
+    void complete(PreloadJob *job);
+
+public:
+    // Kind of each file comes from its extension (.png/.jpg, .ttf, .mp3/.ogg/.wav)
+    AssetPreloader(const char *const *paths, int count);
+    AssetPreloader(const AssetPreloader &) = delete;
+    AssetPreloader &operator=(const AssetPreloader &) = delete;
+    ~AssetPreloader();  // Waits for decodes still running
+
+    void start(int threads = 0);  // 0 = one per hardware thread
+
+    // Render thread: move every finished decode into the AssetCache; returns how many this call
+    int poll();
+
+    int getLoaded() const;  // Handed to the cache so far
+    int getTotal() const;
+    bool isDone() const;
+};
@@ -6,18 +6,20 @@
 #include <string>
 #include "System.h"
 #include "MatchmakingQueue.h"
+#include "AssetCache.h"
 using namespace std;
 using namespace sf;
 
 extern void toggleMusic();
 extern bool isMusicEnabled();
 extern void setMusicEnabled(bool enabled);
+extern void markFirstFrame();
 
 class AuthenticationSystem
 {
 private:
     RenderWindow *window;
-    Font font, sfont;
+    AssetRef<Font> font, sfont;
 
     Text usernameText, passwordText, messageText;
     Text usernameLabel, passwordLabel;
@@ -31,7 +33,7 @@ private:
 
     System system;
 
-    Texture backgroundTexture;
+    AssetRef<Texture> backgroundTexture;
     Sprite backgroundSprite;
 
     RectangleShape scheduledButton;
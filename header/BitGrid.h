@@ -0,0 +1,45 @@
+// Xonix Game
+// Bit-plane grid for capture resolution - one uint64 per row per plane (wall, trail, free, reach)
+// The int grid stays the source of truth for rendering and saves; this is rebuilt per capture
+
+#pragma once
+#include <cstdint>
+#include "FloodFill.h"
+
+class BitGrid
+{
+private:
+    int rows;
+    int cols;
+    int capacity;       // Rows allocated per plane
+    uint64_t *planes;   // wall | trail | free | reach, each `capacity` words
+    FloodFill wideFill; // Boards wider than one word use the scanline fill
+
+    uint64_t *plane(int index) const;
+
+public:
+    static const int MAX_COLS = 64;
+
+    BitGrid();
+    BitGrid(const BitGrid &) = delete;
+    BitGrid &operator=(const BitGrid &) = delete;
+    ~BitGrid();
+
+    // Pack a row-major int grid: 1 = wall, trailValue = trail, 0 = free. False if wider than MAX_COLS
+    bool load(const int *grid, int rows, int cols, int trailValue);
+
+    // Dilate the seeds through the free plane until nothing changes
+    void spreadFrom(const int *seeds, int seedCount);
+
+    // Trail and unreached free cells become walls in grid; returns trail cells captured
+    int commit(int *grid) const;
+
+    const uint64_t *wallPlane() const;
+    const uint64_t *trailPlane() const;
+    const uint64_t *freePlane() const;
+    const uint64_t *reachPlane() const;
+
+    // Whole capture step: enemies at seeds keep their area, the rest of the free cells and
+    // the trail become walls. Other values (e.g. the other player's trail) are left alone
+    int resolveCapture(int *grid, int rows, int cols, int trailValue, const int *seeds, int seedCount);
+};
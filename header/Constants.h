@@ -5,3 +5,9 @@
 
 const int M = 25;  // Grid rows
 const int N = 40;  // Grid columns
+const int TILE_SIZE = 18;  // Pixels per grid cell
+
+// Fixed-timestep simulation - speeds and delays were tuned at 60 frames per second
+const float SIM_STEP = 1.0f / 60.0f;  // Seconds per simulation tick
+const int MAX_SIM_STEPS = 8;          // Ticks a single frame may run before the backlog is dropped
+const float MAX_FRAME_TIME = 0.25f;   // Longer frames (window dragged, debugger) count as this
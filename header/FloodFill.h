@@ -0,0 +1,24 @@
+// Xonix Game
+// Scanline flood fill with an explicit stack - marks the area enemies can reach
+// Shared by SinglePlayer and Multiplayer; no recursion, so board size doesn't affect the call stack
+
+#pragma once
+
+class FloodFill
+{
+private:
+    int *stack;     // Pending seed cells (row * cols + col)
+    int capacity;
+
+    void reserve(int cells);
+
+public:
+    FloodFill();
+    FloodFill(const FloodFill &) = delete;
+    FloodFill &operator=(const FloodFill &) = delete;
+    ~FloodFill();
+
+    // Replace every `from` cell 4-connected to a seed with `to`, all seeds in one pass.
+    // grid is row-major rows x cols, seeds are cell indices; returns cells changed
+    int fill(int *grid, int rows, int cols, const int *seeds, int seedCount, int from = 0, int to = -1);
+};
@@ -0,0 +1,51 @@
+// Xonix Game
+// Frame time, draw-call and texture-bind overlay (toggled with F3) - draws go through it so they
+// can be counted
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+using namespace sf;
+
+class TileMap;
+class SpriteBatch;
+
+class FrameStats
+{
+private:
+    Clock frameClock;   // Between frames
+    Clock renderClock;  // From beginFrame() to endFrame()
+    float frameMs;      // Both smoothed over roughly the last second
+    float renderMs;
+    int drawCalls;      // This frame so far
+    int cellsRebuilt;
+    int textureBinds;             // Draws that used a different texture from the draw before
+    const Texture *lastTexture;
+    bool visible;
+    Text text;
+
+    void drawWith(RenderTarget &target, const Drawable &drawable, const Texture *texture);
+
+public:
+    FrameStats();
+
+    void setFont(const Font &font);
+    void toggle();
+
+    void beginFrame();
+
+    // target.draw(drawable), counted; shapes and other untextured drawables
+    void draw(RenderTarget &target, const Drawable &drawable);
+
+    // Same, for drawables whose texture is known - switching textures counts as a bind
+    void draw(RenderTarget &target, const Sprite &sprite);
+    void draw(RenderTarget &target, const Text &text);  // Glyph page for its character size
+    void draw(RenderTarget &target, const TileMap &map);
+    void draw(RenderTarget &target, const SpriteBatch &batch);
+
+    // Board cells rewritten this frame (TileMap::update)
+    void countRebuilt(int cells);
+
+    // Draw the overlay, if shown, on top of everything else; call just before display()
+    void endFrame(RenderTarget &target);
+};
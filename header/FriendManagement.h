@@ -5,6 +5,7 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include "System.h"
+#include "AssetCache.h"
 
 using namespace sf;
 using namespace std;
@@ -13,9 +14,9 @@ class FriendManagement
 {
 private:
     RenderWindow &window;
-    Font font;
+    AssetRef<Font> font;
 
-    Texture backgroundTexture;
+    AssetRef<Texture> backgroundTexture;
     Sprite backgroundSprite;
 
     Text friendsTitle;
@@ -8,6 +8,12 @@
 #include "Inventory.h"
 #include "System.h"
 #include "Constants.h"
+#include "XonixEngine.h"
+#include "Replay.h"
+#include "TileMap.h"
+#include "FrameStats.h"
+#include "AssetCache.h"
+#include "TextureAtlas.h"
 
 using namespace std;
 using namespace sf;
@@ -63,6 +69,7 @@ struct GameState
     // Level data
     int levelNo;
     int bgR, bgG, bgB, bgA;
+    uint64_t seed;  // Game seed (V2 saves), 0 if the save predates it
 
     // Enemy data (max 10)
     int enemyCount;
@@ -80,7 +87,7 @@ struct GameState
 
 /*
  * Class: SinglePlayer
- * Description: Main single-player game class with all game logic.
+ * Description: Single-player session - window, keyboard, drawing and saves around an XonixEngine.
  */
 class SinglePlayer
 {
@@ -89,45 +96,29 @@ private:
     string lastSaveID;
     Color backgroundColor;
     string backgroundImagePath;
-    Texture backgroundTexture;
+    AssetRef<Texture> backgroundTexture;
     Sprite backgroundSprite;
     bool useBackgroundImage;
-    int score;
     System system;
     Player *p;
-    int bonusCount;
-    int powerUps;
-    int nextPowerUpScore;
-    bool powerUpUsed;
-    Clock powerUpClock;
-    bool powerUpActive;
-    float powerUpRemainingTime;
     ThemeInventory TI;
 
-    struct Enemy
-    {
-        int x, y, dx, dy;
-        bool frozen;
-        Enemy();
-        void move(int grid[M][N], int ts, bool frozen, float speedMultiplier);
-    };
-
-    int grid[M][N];
+    XonixEngine engine;  // The rules; run() feeds it input ticks and draws its state
     int ts;
-    int x, y, dx, dy;
-    bool Game;
-    float timer;
-    int enemyCount;
-    Enemy a[10];
-    int currentLevel;
-    float delay;
-    float enemySpeed;
-    int levelNo;
+    bool Game;           // Session still running (the player may also end it from the pause menu)
 
-    void drop(int y, int x);  // Flood fill algorithm to mark enemy territory
-    void resetGame();
-    int countCapturedTiles();
-    void setLevel(int levelNo);
+    Replay recording;    // Inputs of the current game, written out as a replay when it ends
+    bool recordingGame;  // Off for games continued from a save - a replay starts from newGame()
+
+    TileMap board;            // Grid drawn in one call, only changed cells rebuilt
+    SpriteBatch spriteBatch;  // Player tile and enemies, from the sprite atlas
+    IntRect playerTile;
+    FrameStats stats;         // F3 overlay
+
+    void startGame(int level, int powerUps);
+    void saveReplay();
+    void prepareBoard(const TextureAtlas &atlas, const Font &font);
+    void drawFrame(RenderWindow &window, Sprite &sTile, Sprite &sEnemy, float alpha);
 
 public:
     SinglePlayer();
@@ -136,6 +127,9 @@ public:
             RenderWindow &window, const string &saveIDToLoad = "", string &savedGameID = *(new string()),
             const string &bgImagePath = "");
 
+    // Play a recorded game in the window at `speed` ticks per tick (Up/Down change it, Esc leaves)
+    int watchReplay(RenderWindow &window, const string &path, int speed = 1);
+
     string saveGame();
     bool loadGame(const string &saveIDToLoad = "");
     bool loadGameLegacy();
@@ -0,0 +1,28 @@
+// Xonix Game
+// Seedable per-game random numbers (xoshiro128**) - the same seed always gives the same enemies,
+// and every game or simulation thread owns its own generator instead of sharing rand()
+
+#pragma once
+#include <cstdint>
+
+class GameRng
+{
+private:
+    uint32_t s[4];
+    uint64_t seedValue;
+
+public:
+    explicit GameRng(uint64_t seed = 1);
+
+    // Restart the sequence; the four words are filled from the seed with splitmix64
+    void seed(uint64_t value);
+    uint64_t getSeed() const;
+
+    uint32_t next();
+
+    // Uniform in [0, n), n > 0
+    int below(int n);
+
+    // Different on every call, never 0 (0 marks "not recorded" in old saves)
+    static uint64_t freshSeed();
+};
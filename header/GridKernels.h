@@ -0,0 +1,22 @@
+// Xonix Game
+// Per-cell grid kernels (capture rewrite, counting, bit-plane packing) with runtime CPU dispatch
+// AVX2 on x86 when the CPU has it, NEON on ARM64, scalar otherwise - all produce identical results
+
+#pragma once
+#include <cstdint>
+
+struct GridKernels
+{
+    const char *name;
+
+    // -1 -> 0, trailValue -> 1, 0 -> 1 in one pass; returns how many trail cells were rewritten
+    int (*rewriteCapture)(int *cells, int count, int trailValue);
+
+    int (*countValue)(const int *cells, int count, int value);
+
+    // Bit c of each plane set when line[c] is 1 / trailValue / 0 (cols <= 64)
+    void (*packRow)(const int *line, int cols, int trailValue, uint64_t *wall, uint64_t *trail, uint64_t *empty);
+};
+
+const GridKernels &gridKernels();        // Fastest for this CPU, chosen on first call
+const GridKernels &scalarGridKernels();  // Reference implementation
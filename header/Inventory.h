@@ -61,6 +61,7 @@ public:
     
     string getThemeColorCode(int id);
     string getThemeImagePath(int id);
+    string getThemeMusicPath(int id);  // assets/Sounds/<Name>.ogg - only played if the file exists
     void browseThemes();
     int getSize() const;
     int getAllThemes(AVLNode **themes);
@@ -0,0 +1,44 @@
+// Xonix Game
+// Memory-mapped file wrapper (POSIX mmap / Win32 file mapping)
+
+#pragma once
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+class MappedFile
+{
+private:
+    char *data;
+    uint64_t size;
+#ifdef _WIN32
+    void *fileHandle;
+    void *mappingHandle;
+#else
+    int fd;
+#endif
+
+    bool map();
+    void unmap();
+
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const string &path, bool create);  // Maps the whole file read/write
+    bool resize(uint64_t newSize);               // Grows/shrinks the file and remaps (pointers go stale)
+    void flush();  // Starts writing dirty pages back, does not wait
+    void sync();   // Waits until the contents are on the disk
+    void close();
+
+    bool isOpen() const;
+    char *bytes() const;
+    uint64_t getSize() const;
+
+    // Plain files written with streams
+    static bool syncPath(const string &path);                          // Waits until a closed file is on the disk
+    static bool replaceFile(const string &tmpPath, const string &path);  // Syncs tmpPath, then renames it over path
+};
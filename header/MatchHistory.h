@@ -0,0 +1,101 @@
+// Xonix Game
+// Match history - append-only file of fixed-size records per player (data/<id>.matches)
+// Kept out of the profile so loading a player never depends on how many games they played
+
+#pragma once
+#include <string>
+#include <fstream>
+#include <cstdint>
+
+using namespace std;
+
+enum MatchResult
+{
+    MATCH_LOSS = 0,
+    MATCH_WIN = 1,
+    MATCH_SOLO = 2  // Single player game
+};
+
+const int32_t OPPONENT_NONE = -1;     // Single player
+const int32_t OPPONENT_UNKNOWN = -2;  // Imported from text whose username no longer resolves
+const int MATCH_LEVELS = 8;           // Levels indexed separately, higher ones share the last chain
+
+struct MatchRecord
+{
+    int64_t timestamp;         // Unix time, 0 if unknown (imported); never decreases along the file
+    int32_t opponentId;
+    int32_t score;
+    int32_t prevSameOpponent;  // Record index of the previous game vs this opponent, -1 = none
+    int32_t prevSameLevel;     // Same for the level
+    int16_t level;
+    uint8_t result;            // MatchResult
+    uint8_t padding;
+    uint32_t reserved;
+};
+
+// Aggregates kept in the file header, updated on every append
+struct MatchStats
+{
+    uint32_t count;
+    uint32_t wins;
+    uint32_t losses;
+    uint32_t solo;
+    int64_t totalScore;
+    int32_t bestScore;
+    int32_t padding;
+
+    double winRate() const;       // Wins / multiplayer games, 0 if none
+    double averageScore() const;
+};
+
+// Head-to-head totals, hashed by opponent id in data/<id>.opponents
+struct OpponentSummary
+{
+    int32_t opponentId;
+    uint32_t games;
+    uint32_t wins;
+    int32_t lastRecord;  // Newest game vs this opponent - head of its prevSameOpponent chain
+};
+
+struct HistoryHeader;
+
+class MatchHistory
+{
+private:
+    string dataDir;
+
+    string pathOf(const string &id) const;
+    string opponentsPathOf(const string &id) const;
+    bool loadHeader(const string &id, HistoryHeader &h) const;
+    bool readRecord(ifstream &in, int index, MatchRecord &out) const;
+    int followChain(const string &id, int32_t head, bool byOpponent, int level, int limit, MatchRecord *out) const;
+
+    MatchHistory();
+
+public:
+    static MatchHistory &instance();
+
+    void setDataDir(const string &dir);
+
+    // O(1) expected - links, stats and the opponent's slot updated in place; the opponent
+    // table doubles (rewritten once) when it fills up
+    bool append(const string &id, const MatchRecord &record);
+    int getCount(const string &id) const;
+    bool getStats(const string &id, MatchStats &out) const;
+
+    // Newest first: offset 0 is the latest match. Returns records written to out
+    int readPage(const string &id, int offset, int limit, MatchRecord *out) const;
+
+    // Queries, newest first - each touches only the records it returns
+    int lastMatches(const string &id, int n, MatchRecord *out) const;
+    int byOpponent(const string &id, int32_t opponentId, int limit, MatchRecord *out) const;
+    int byLevel(const string &id, int level, int limit, MatchRecord *out) const;
+    int inRange(const string &id, int64_t from, int64_t to, int limit, MatchRecord *out) const;  // Inclusive
+    bool headToHead(const string &id, int32_t opponentId, OpponentSummary &out) const;
+
+    // One-time conversion of the old "vs X - WIN (Score: N)" lines, newest first.
+    // Skipped if the player already has a history file
+    int importLegacy(const string &id, const string *lines, int count);
+
+    static string describe(const MatchRecord &record, const string &opponentName);
+};
@@ -7,7 +7,12 @@
 #include <string>
 #include "System.h"
 #include "Constants.h"
+#include "XonixEngine.h"
 #include "Inventory.h"
+#include "TileMap.h"
+#include "FrameStats.h"
+#include "AssetCache.h"
+#include "TextureAtlas.h"
 
 using namespace std;
 using namespace sf;
@@ -18,46 +23,16 @@ class Multiplayer
 {
 private:
     System system;
-    int grid[M][N];
+    XonixEngine engine;  // Both players, the enemies and the board - this class reads keys and draws
 
-    // Player 1 state
-    int score;
-    int bonusCount;
-    int powerUps;
-    int nextPowerUpScore;
-    bool powerUpUsed;
-    Clock powerUpClock;
-    bool powerUpActive;
-    float powerUpRemainingTime;
-    bool player2Frozen;
-
-    // Player 2 state
-    int score2;
-    int bonusCount2;
-    int powerUps2;
-    int nextPowerUpScore2;
-    bool powerUpUsed2;
-    Clock powerUpClock2;
-    bool powerUpActive2;
-    float powerUpRemainingTime2;
-    bool player1Frozen;
-
-    Texture backgroundTexture;
+    AssetRef<Texture> backgroundTexture;
     Sprite backgroundSprite;
     bool useBackgroundImage;
     string backgroundImagePath;
 
-    struct Enemy
-    {
-        int x, y, dx, dy;
-        bool frozen;
-        Enemy(int startX, int startY);
-        void move(int grid[M][N]);
-    };
-
-    void resetGame();
-    void drop(int y, int x);  // Flood fill to mark enemy territory
-    int countCapturedTiles();
+    TileMap board;  // Grid drawn in one call, only changed cells rebuilt
+    SpriteBatch spriteBatch;  // Players and enemies, from the sprite atlas
+    FrameStats stats;  // F3 overlay
 
 public:
     Multiplayer();
@@ -0,0 +1,50 @@
+// Xonix Game
+// Streamed background music - decodes a quarter second at a time into a small ring of chunks,
+// so memory stays the same whatever the track length; plays a playlist in a loop
+
+#pragma once
+#include <SFML/Audio.hpp>
+#include <string>
+
+using namespace std;
+using namespace sf;
+
+class MusicPlayer : public SoundStream
+{
+private:
+    static const int RING_CHUNKS = 3;  // As many as SoundStream keeps queued
+
+    string *tracks;
+    int trackCount;
+    int current;
+    InputSoundFile file;  // Only the streaming thread reads it while playing
+
+    Int16 *ring;
+    int chunkSamples;     // Per chunk, all channels
+    int nextChunk;
+    unsigned channels;
+    unsigned sampleRate;
+
+    bool openTrack(int index);
+
+protected:
+    bool onGetData(Chunk &data) override;
+    void onSeek(Time offset) override;
+
+public:
+    MusicPlayer();
+    MusicPlayer(const MusicPlayer &) = delete;
+    MusicPlayer &operator=(const MusicPlayer &) = delete;
+    ~MusicPlayer();
+
+    // Stops, then queues the tracks; play() starts at the first. Tracks whose channel count or
+    // sample rate differ from the first playable one are skipped. False if none can be opened
+    bool setPlaylist(const string *paths, int count);
+
+    // True if `path` is the only track queued
+    bool isOnlyTrack(const string &path) const;
+
+    int getTrack() const;
+    int getTrackCount() const;
+    long long getBufferBytes() const;  // Decoded audio held, independent of track length
+};
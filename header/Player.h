@@ -1,12 +1,23 @@
 // Xonix Game
-// Player class - stores profile, friends (LinkedList), match history (Stack), friend requests (Stack)
+// Player class - stores profile, friends (LinkedList), friend requests (Stack)
+// Match history is kept separately in MatchHistory
 
 #pragma once
 #include <string>
 #include "../data_structures/List.h"
 #include "../data_structures/Stack.h"
+#include "MatchHistory.h"
 using namespace std;
 
+// Sections a Player can be loaded with - the profile (names, scores, counts, theme) is always loaded
+enum PlayerFields
+{
+    FIELD_PROFILE = 1,
+    FIELD_FRIENDS = 2,
+    FIELD_REQUESTS = 4,
+    FIELD_ALL = 7
+};
+
 class Player
 {
 public:
@@ -24,24 +35,42 @@ public:
     // Social features using custom data structures
     LinkedList friendList;   // Friends stored in Linked List
     int noOfFriends;
-    Stack matchHistory;      // Match history stored in Stack (LIFO)
-    int noOfMatches;
     Stack friendRequest;     // Pending requests in Stack
     int noOfRequests;
 
     int preferredTheme;  // 1-5
+    unsigned int logSequence;  // Last PlayerLog entry reflected in this profile
+    int loadedFields;          // PlayerFields present in memory, counts are always valid
 
 public:
     Player();
+    Player(const Player &other);             // Deep copy, keeps list order
+    Player(const Player &other, int fields); // Projection - copies only the requested sections
+    Player &operator=(const Player &other);
     ~Player();
 
-    // Update match history and high score after a game
-    void addMatchUpdate(string opponent, bool win, int score, int powerUpsNow, int difficultyLevel = 1);
+    // Record a game in MatchHistory and update the high score - OPPONENT_NONE for single player
+    void addMatchUpdate(int opponentId, bool win, int score, int powerUpsNow, int difficultyLevel = 1);
     
-    void saveToFile();
+    // Base profile + pending log entries, parsing only the requested sections - caller must delete
+    static Player *load(const string &id, int fields = FIELD_ALL);
+    bool hasFields(int fields) const;
+    void ensureLoaded(int fields);  // Materialize missing sections on demand
+
+    bool saveToFile();  // Full profile write - player database when open, otherwise data/<id>.txt
+    bool loadFromTextFile(const string &filename, int fields = FIELD_ALL);
+    bool saveToTextFile(const string &filename) const;
     void addRequest(string request_id);
     void display();
     void rejectRequest(string id);
     void acceptRequest(string id);
+    void addFriend(string id);
+    void removeFriend(string id);
+    void setPreferredTheme(int theme);
     bool changePassword(string newPassword);
+
+private:
+    void logMutation(int op, const string &text, int a = 0, int b = 0, int c = 0);
+    void copyFrom(const Player &other, int fields = FIELD_ALL);
+    void clearLists();
 };
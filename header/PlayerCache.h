@@ -0,0 +1,105 @@
+// Xonix Game
+// Player cache - bounded LRU of parsed players shared by every System instance
+// Read-only views pin a snapshot, writers go through Player::saveToFile or the mutation log (write-through)
+
+#pragma once
+#include <string>
+#include "Player.h"
+
+using namespace std;
+
+struct LogEntry;
+
+// Immutable copy of a player shared between the cache and outstanding views
+struct PlayerSnapshot
+{
+    Player player;
+    int refs;  // Cache slot + live views
+
+    PlayerSnapshot(const Player &p);
+};
+
+// Read-only handle to a cached player - stays valid even if the entry is evicted
+class PlayerView
+{
+private:
+    PlayerSnapshot *snapshot;
+
+    void release();
+
+public:
+    PlayerView();
+    explicit PlayerView(PlayerSnapshot *snap);
+    PlayerView(const PlayerView &other);
+    PlayerView &operator=(const PlayerView &other);
+    ~PlayerView();
+
+    static PlayerView detached(const Player &p);  // Private snapshot, never cached
+
+    bool isValid() const;
+    const Player *operator->() const;
+    const Player &operator*() const;
+};
+
+// Node in both the LRU list and the id bucket chain
+struct CacheEntry
+{
+    string id;
+    PlayerSnapshot *snapshot;
+    CacheEntry *prev;   // Towards most recently used
+    CacheEntry *next;   // Towards least recently used
+    CacheEntry *chain;  // Next entry in the same bucket
+
+    CacheEntry(const string &playerId, PlayerSnapshot *snap);
+};
+
+// Process-wide LRU cache keyed by player ID
+class PlayerCache
+{
+private:
+    static const int DEFAULT_CAPACITY = 512;
+    static const int BUCKET_COUNT = 1031;  // Prime, roughly 2x capacity
+
+    CacheEntry *buckets[BUCKET_COUNT];
+    CacheEntry *head;  // Most recently used
+    CacheEntry *tail;  // Least recently used
+    int count;
+    int capacity;
+
+    long long hits;
+    long long misses;
+    long long evictions;
+
+    PlayerCache();
+    ~PlayerCache();
+    PlayerCache(const PlayerCache &) = delete;
+    PlayerCache &operator=(const PlayerCache &) = delete;
+
+    int bucketOf(const string &id) const;
+    CacheEntry *find(const string &id) const;
+    void unlink(CacheEntry *e);
+    void pushFront(CacheEntry *e);
+    void removeEntry(CacheEntry *e);
+    void evictIfNeeded();
+
+public:
+    static PlayerCache &instance();
+
+    // Returns a view on hit; on miss returns an invalid view and counts the miss
+    PlayerView lookup(const string &id);
+    // Inserts (or replaces) a freshly loaded player and returns a view on it
+    PlayerView insert(const Player &p);
+
+    void update(const Player &p);       // Write-through: refresh cached copy after a save
+    void applyLogged(const Player &p, const LogEntry &entry);  // Same, O(1) when no view pins the copy
+    void invalidate(const string &id);  // Drop entry after an out-of-band file rewrite
+    void clear();
+
+    void setCapacity(int cap);
+    int getCapacity() const;
+    int getSize() const;
+    long long getHits() const;
+    long long getMisses() const;
+    long long getEvictions() const;
+    void displayStats() const;
+};
@@ -0,0 +1,84 @@
+// Xonix Game
+// Write-ahead log of player mutations (data/players.wal)
+// Small changes are appended here instead of rewriting the whole profile, then folded in by compact()
+
+#pragma once
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include "Player.h"
+
+using namespace std;
+
+enum LogOp
+{
+    LOG_ADD_MATCH = 1,   // a/b/c = highScore/highScoreLevel/powerUps after the match
+    LOG_ADD_FRIEND,
+    LOG_REMOVE_FRIEND,
+    LOG_ADD_REQUEST,
+    LOG_REMOVE_REQUEST,
+    LOG_SET_THEME,       // a = theme
+    LOG_SET_HIGH_SCORE,  // a = score, b = level
+    LOG_SET_PASSWORD
+};
+
+struct LogEntry
+{
+    uint32_t seq;
+    int op;
+    string text;
+    int a, b, c;
+    LogEntry *next;
+};
+
+// Entries not yet folded into one player's base profile, oldest first
+struct PendingPlayer
+{
+    string id;
+    LogEntry *head;
+    LogEntry *tail;
+    PendingPlayer *next;
+};
+
+class PlayerLog
+{
+private:
+    static const int BUCKET_COUNT = 257;
+    static const uint64_t COMPACT_BYTES = 1 << 20;  // Fold into profiles past 1 MB of log
+
+    PendingPlayer *buckets[BUCKET_COUNT];
+    string path;
+    ofstream out;
+    uint32_t nextSeq;
+    uint64_t bytes;
+    int pendingEntries;
+
+    int bucketOf(const string &id) const;
+    PendingPlayer *find(const string &id) const;
+    void remember(const string &id, LogEntry *entry);
+    void clearPending();
+    bool writeHeader(const string &file, uint32_t firstSeq);
+
+    PlayerLog();
+    ~PlayerLog();
+
+public:
+    static const char *DEFAULT_PATH;
+
+    static PlayerLog &instance();
+
+    bool open(const string &logPath = DEFAULT_PATH);  // Scans the log, drops a torn tail
+    void close();
+    bool isOpen() const;
+
+    // Append one mutation and fsync the log, returns its sequence number (0 on failure)
+    uint32_t append(const string &id, int op, const string &text, int a = 0, int b = 0, int c = 0);
+
+    void apply(Player &p) const;  // Replay pending entries newer than p.logSequence
+    static void applyEntry(Player &p, const LogEntry &entry);
+
+    int compact();  // Fold every pending entry into its base profile, then truncate
+    bool needsCompaction() const;
+    int getPendingCount() const;
+    uint64_t getSize() const;
+};
@@ -0,0 +1,106 @@
+// Xonix Game
+// Binary player database - one memory-mapped file replacing data/<id>.txt
+// Fixed-width records (slot = numeric player ID) + append-only heap for variable sections
+
+#pragma once
+#include <string>
+#include <cstdint>
+#include "Player.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+const int STORE_USERNAME_LEN = 48;
+const int STORE_PASSWORD_LEN = 32;
+const int STORE_REGTIME_LEN = 32;
+
+// Location of one variable-length section (list of strings) in the heap
+struct SectionRef
+{
+    uint64_t offset;  // 0 = empty
+    uint32_t bytes;
+    uint32_t count;
+};
+
+// Fixed-size record, hot fields first so scans touch a single cache line
+struct PlayerRecord
+{
+    int32_t id;  // -1 = free slot
+    int32_t highScore;
+    int32_t highScoreLevel;
+    int32_t powerUps;
+    int32_t preferredTheme;
+    uint32_t logSequence;  // Last PlayerLog entry folded into this record
+    char username[STORE_USERNAME_LEN];
+    char password[STORE_PASSWORD_LEN];
+    char regTime[STORE_REGTIME_LEN];
+    SectionRef friends;
+    SectionRef matches;   // Legacy match strings, emptied once moved to MatchHistory
+    SectionRef requests;  // Top of stack first
+};
+
+struct StoreHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t capacity;   // Record slots
+    uint32_t count;      // Live records
+    uint64_t heapStart;
+    uint64_t heapEnd;    // Next free heap byte
+    uint64_t wasted;     // Bytes of superseded sections
+};
+
+class PlayerStore
+{
+private:
+    MappedFile file;
+    string path;
+
+    StoreHeader *header() const;
+    PlayerRecord *record(int slot) const;
+    int slotOf(const string &id) const;
+
+    bool initialize(int capacity);
+    bool ensureHeap(uint64_t extra);
+    bool ensureSlot(int slot);
+    bool rebuild(int newCapacity);
+
+    void encodeList(const NodeList *head, int count, string &out) const;
+    void encodeStack(const node *head, int count, string &out) const;
+    SectionRef &section(int slot, int which) const;  // 0 friends, 1 matches, 2 requests
+    bool writeSection(int slot, int which, const string &blob, int count);
+    void readSection(const SectionRef &ref, string *out) const;
+    void moveLegacyMatches(int slot, const string &id);
+
+    PlayerStore();
+
+public:
+    static const char *DEFAULT_PATH;
+
+    static PlayerStore &instance();
+
+    bool open(const string &dbPath = DEFAULT_PATH);  // Existing database only
+    bool create(const string &dbPath = DEFAULT_PATH, int capacity = 64);
+    void close();
+    bool isOpen() const;
+    void sync();  // Wait until every write so far is on the disk
+
+    bool exists(const string &id) const;
+    Player *load(const string &id, int fields = FIELD_ALL);  // Caller must delete, skips unrequested sections
+    bool save(const Player &p);            // Hot fields in place, changed sections appended
+
+    // Hot-field updates - no section rewrite
+    bool setPreferredTheme(const string &id, int theme);
+    int getPreferredTheme(const string &id) const;
+    bool readUsername(const string &id, string &out) const;
+    uint32_t getMaxLogSequence() const;
+
+    void compact();  // Rewrite heap without superseded sections
+    int getCount() const;
+    uint64_t getWastedBytes() const;
+
+    // One-shot conversion to/from data/AllPlayers.txt + data/<id>.txt
+    int migrateFromText(const string &dataDir = "data/");
+    int exportToText(const string &dataDir = "data/");
+};
@@ -0,0 +1,86 @@
+// Xonix Game
+// Input replays - the seed and starting values of a game plus every tick on which the player
+// pressed something; XonixEngine is deterministic, so that is enough to play the game again
+//
+// File: "XRPL", then varints: version, seed, level, power-ups, ticks, score, event count,
+// then one varint per event: (ticks since the previous event << 4) | input code
+
+#pragma once
+#include <string>
+#include "XonixEngine.h"
+
+using namespace std;
+
+const int REPLAY_VERSION = 1;
+const int MAX_REPLAY_SPEED = 4096;  // Fastest rendered playback, in ticks per real tick
+
+class Replay
+{
+private:
+    uint64_t seed;
+    int level;
+    int powerUps;
+    long long ticks;  // Length of the game
+    int score;        // Final score, checked on playback
+    int eventCount;
+
+    unsigned char *events;
+    int size;
+    int capacity;
+    long long lastTick;  // Tick of the last recorded event
+
+    void put(uint64_t value);
+
+    friend class ReplayPlayer;
+
+public:
+    Replay();
+    Replay(const Replay &) = delete;
+    Replay &operator=(const Replay &) = delete;
+    ~Replay();
+
+    // Start recording a game that newGame() just set up with these values
+    void begin(uint64_t seed, int level, int powerUps);
+
+    // The input about to be handed to step() in this state; inputs that change nothing
+    // (no key, or the direction the player already has) are not stored
+    void record(const EngineState &state, const EngineInput &input);
+
+    void finish(long long ticks, int score);
+
+    bool save(const string &path) const;
+    bool load(const string &path);
+
+    uint64_t getSeed() const;
+    int getLevel() const;
+    int getPowerUps() const;
+    long long getTicks() const;
+    int getScore() const;
+    int getEventCount() const;
+    int getEventBytes() const;
+};
+
+// Feeds a replay back into an engine one tick at a time - as fast as the caller likes
+class ReplayPlayer
+{
+private:
+    const Replay &replay;
+    int pos;  // Read position in the event bytes
+    int eventsLeft;
+    long long nextTick;
+    EngineInput nextInput;
+
+    void readEvent();
+
+public:
+    explicit ReplayPlayer(const Replay &replay);
+
+    // Rewind and start the recorded game on the engine
+    void start(XonixEngine &engine);
+
+    // Advance one tick; false once the recording is over or the player died
+    bool step(XonixEngine &engine);
+};
+
+// Re-simulate the whole replay headless; true if the recorded length and score come out again
+bool verifyReplay(const Replay &replay, XonixEngine &engine);
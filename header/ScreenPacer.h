@@ -0,0 +1,49 @@
+// Xonix Game
+// Event-driven redraw for menu screens - the loop sleeps in waitEvent until something happens
+// and draws only after a change, instead of clearing and redrawing at 60 FPS while idle
+//
+//     ScreenPacer pacer("Friends");
+//     while (window.isOpen())
+//     {
+//         while (pacer.nextEvent(window, event)) { ...handle... }
+//         if (pacer.redraw()) { ...clear, draw, display... }
+//     }
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+using namespace sf;
+
+class ScreenPacer
+{
+private:
+    const char *name;
+    bool dirty;     // Something changed since the last frame
+    int frames;
+    int events;
+    Clock wall;
+    double cpuStart;
+
+    static bool reporting;
+
+public:
+    explicit ScreenPacer(const char *name);
+    ScreenPacer(const ScreenPacer &) = delete;
+    ScreenPacer &operator=(const ScreenPacer &) = delete;
+    ~ScreenPacer();  // Reports frames and CPU use for the screen, if reporting is on
+
+    // Like pollEvent, but once the queue is empty and nothing needs drawing it blocks until the
+    // next event - or until `timeout`, for screens with something timed on them (Time::Zero waits
+    // for good; the screen calls invalidate() if the timed thing changed). Every event except
+    // mouse movement marks the screen for redrawing
+    bool nextEvent(Window &window, Event &event, Time timeout = Time::Zero);
+
+    // A change that did not come from an event
+    void invalidate();
+
+    // True if the screen should be drawn now; counts the frame
+    bool redraw();
+
+    // Print one line per screen visited (Xonix.exe --screen-stats)
+    static void setReporting(bool on);
+};
@@ -4,45 +4,66 @@
 #pragma once
 #include <string>
 #include "Player.h"
+#include "PlayerCache.h"
 #include "../data_structures/HashTable.h"
 
 using namespace std;
 
 // Central player management system
-// Uses: Dynamic Array for player IDs, Hash Table for username lookup
+// Uses: Dynamic Array for player IDs, Hash Table for username lookup,
+//       shared LRU PlayerCache so repeated lookups skip the disk
 class System
 {
 public:
-    string *ArrayOfPlayers;    // Dynamic array of all player IDs
+    string *ArrayOfPlayers;    // Dynamic array of all player IDs (grows by doubling)
     int noOfPlayers;
-    HashTable playerHashTable; // Username -> Player ID mapping
+    int capacityOfPlayers;
+    HashTable playerHashTable; // Username -> Player ID mapping (fallback when data/usernames.idx is unavailable)
 
 public:
     System();
     ~System();
 
+    void openPlayerStore();       // Open (or migrate to) the binary player database
     void createArrayOfPlayers();  // Load player IDs from AllPlayers.txt
-    void buildHashTable();        // Build hash table for O(1) username lookup
+    void buildHashTable();        // Map the persistent username index (rebuilt only if stale)
+    void rebuildIndex();          // Re-derive the index from every player record
+    int checkIndex();             // Verify index vs. player records, returns problem count
 
-    Player *returnPlayer(string id);  // Load player from file (caller must delete)
+    // Mutable copy (caller must delete) / shared read-only view; fields limits which sections are parsed
+    Player *returnPlayer(string id, int fields = FIELD_ALL);
+    PlayerView viewPlayer(const string &id, int fields = FIELD_ALL);
     
     bool isValid(string Username, string Password);  // Validate login credentials
     string returnId(string Username);                // Get player ID by username
     string returnIdByUsername(const string &username);
     bool usernameExists(string Username);
 
-    void addPlayer(string regtime, string Username, string Password);  // Register new player
+    bool addPlayer(string regtime, string Username, string Password);  // Register new player, false if refused
 
     // Friend request system
     bool sendFriendRequest(const string &senderId, const string &receiverId);
     bool acceptFriendRequest(const string &acceptorId, const string &requesterId);
     bool rejectFriendRequest(const string &rejecterId, const string &requesterId);
 
-    void savePlayers();  // Save master player list to file
+    void savePlayers();  // Compact master player list (rewrites AllPlayers.txt)
     void displayArrayOfPlayers();
     void displayHashTable();
+    void displayCacheStats();
     
     bool isIdPresent(const string &id);
     bool idExist(const string &id);
     Player *getPlayerByUsername(const string &username);
+
+private:
+    int compactedPlayers;  // IDs covered by the count line of AllPlayers.txt
+    int nextPlayerId;      // Monotonic, persisted in data/NextPlayerId.txt
+
+    void growArrayOfPlayers();
+    int loadNextPlayerId();
+    void saveNextPlayerId();
+    void appendPlayerId(const string &id);
+
+    string lookupId(const string &username);      // Index lookup, empty if unknown
+    bool readUsername(const string &id, string &username);
 };
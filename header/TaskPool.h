@@ -0,0 +1,65 @@
+// Xonix Game
+// Work-stealing thread pool - each worker has its own task deque (newest first for itself,
+// oldest first for thieves), so batches of uneven jobs keep every core busy
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class TaskPool
+{
+public:
+    typedef void (*TaskFn)(void *arg);
+
+private:
+    struct Task
+    {
+        TaskFn fn;
+        void *arg;
+    };
+
+    // Ring-buffer deque, grown on demand; the owner works the back, thieves the front
+    struct Queue
+    {
+        std::mutex lock;
+        Task *items;
+        int capacity;
+        int head;
+        int count;
+    };
+
+    Queue *queues;
+    std::thread *workers;
+    int workerCount;
+
+    std::atomic<int> queued;      // Tasks sitting in a deque
+    std::atomic<int> unfinished;  // Submitted and not yet returned
+    std::atomic<unsigned> nextQueue;  // Round-robin target for submits from outside the pool
+    bool stopping;
+
+    std::mutex sleepLock;
+    std::condition_variable wake;  // Work arrived or the pool is stopping
+    std::condition_variable done;  // unfinished reached zero
+
+    void push(int queue, const Task &task);
+    bool popBack(int queue, Task &task);
+    bool stealFront(int queue, Task &task);
+    bool findTask(int self, Task &task);
+    void workerLoop(int index);
+
+public:
+    explicit TaskPool(int threads = 0);  // 0 = one per hardware thread
+    TaskPool(const TaskPool &) = delete;
+    TaskPool &operator=(const TaskPool &) = delete;
+    ~TaskPool();                         // Finishes queued tasks, then joins
+
+    // Safe from any thread, including from inside a task (goes to that worker's own deque)
+    void submit(TaskFn fn, void *arg);
+
+    // Block until every task submitted so far has run
+    void wait();
+
+    int threadCount() const;
+};
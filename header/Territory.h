@@ -0,0 +1,62 @@
+// Xonix Game
+// Incremental capture - trail cells are recorded as they are laid, and a capture only looks at
+// the free regions touching a trail; cost follows the trail and the enclosed area, not the board
+
+#pragma once
+#include "BitGrid.h"
+
+class Territory
+{
+private:
+    int rows;
+    int cols;
+    int capacity;       // Cells allocated per array
+    bool synced;        // trail[] is complete and each free area, joined through the trails, holds an enemy
+
+    int *trail;         // Pending trail cells (either player) not yet turned into walls
+    int trailCount;
+
+    // Per cell, valid when the stamp matches this capture's epoch
+    int epoch;
+    int *stamp;         // Claimed by a region this capture
+    int *enemyStamp;    // An enemy stands here
+    int *owner;         // Region that claimed the cell
+    int *link;          // Next cell in that region's frontier
+    int *visited;       // Claimed cells in order, for the commit
+    int visitedCount;
+
+    // Per region: union-find over the regions grown from the trail's free neighbours
+    int *parent;
+    int *head;
+    int *tail;
+    unsigned char *state;
+    int *active;        // Regions still growing, visited round-robin
+
+    BitGrid full;       // Whole-board resolve when the tracker is out of step
+
+    void allocate(int cells);
+    void release();
+    void nextEpoch();
+    int find(int region);
+    void claim(int cell, int region);
+    int newRegion(int cell);
+    void merge(int into, int other);
+    bool canTrack(const int *grid, int rows, int cols, const int *seeds, int seedCount) const;
+    int resync(int *grid, int rows, int cols, int trailValue, const int *seeds, int seedCount);
+
+public:
+    Territory();
+    Territory(const Territory &) = delete;
+    Territory &operator=(const Territory &) = delete;
+    ~Territory();
+
+    // The board changed wholesale (new game, load) - the next capture scans it once
+    void reset();
+
+    // Call whenever a free cell becomes trail (row * cols + col)
+    void layTrail(int cell);
+
+    // Same result as BitGrid::resolveCapture: enemies at seeds keep their area, trailValue cells and
+    // free cells no enemy can reach become walls; returns trail cells captured
+    int resolveCapture(int *grid, int rows, int cols, int trailValue, const int *seeds, int seedCount);
+};
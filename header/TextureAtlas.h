@@ -0,0 +1,51 @@
+// Xonix Game
+// Texture atlas - small sprite sheets packed into one texture at startup, so the board, players
+// and enemies are drawn without switching textures; the manifest maps each name to its rect
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+
+using namespace std;
+using namespace sf;
+
+class TextureAtlas
+{
+private:
+    static const int MAX_SPRITES = 32;
+    static const int PADDING = 1;  // Transparent gutter, so rotated sprites never sample a neighbour
+
+    string names[MAX_SPRITES];
+    string paths[MAX_SPRITES];
+    IntRect rects[MAX_SPRITES];
+    int count;
+    Texture texture;
+    bool built;
+
+    int indexOf(const string &name) const;
+
+public:
+    TextureAtlas();
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+    // Queue an image file under `name`; call before build()
+    bool add(const string &name, const string &path);
+
+    // Shelf-pack everything queued (tallest first) into rows at most `width` wide and upload it.
+    // Images that fail to load get an empty rect
+    bool build(int width = 512);
+
+    const Texture &getTexture() const;
+
+    // Where a sprite sits in the atlas (empty if unknown), or a part of it given in the
+    // sprite's own coordinates - e.g. one tile of the tile sheet
+    IntRect rect(const string &name) const;
+    IntRect rect(const string &name, const IntRect &part) const;
+
+    // The packed image and a "name left top width height" line per sprite (Xonix.exe --dump-atlas)
+    bool save(const string &imagePath, const string &manifestPath) const;
+
+    // Tiles, enemy and game over sprites, built on first use
+    static const TextureAtlas &sprites();
+};
@@ -0,0 +1,64 @@
+// Xonix Game
+// Batched rendering - the whole board as one vertex array (one draw call instead of one per cell),
+// and SpriteBatch for sprites sharing a texture such as the enemies
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+using namespace sf;
+
+const int TILE_KINDS = 4;  // Grid values 0-3 can have a tile
+
+class TileMap : public Drawable
+{
+private:
+    VertexArray vertices;  // One quad per cell, row by row
+    const Texture *texture;
+    int rows, cols, tileSize;
+    int *shown;            // Grid value each quad shows, -1 until first built
+    IntRect rects[TILE_KINDS];
+    bool hasRect[TILE_KINDS];
+    Color tint;
+
+    void setCell(int index, int value);
+    void draw(RenderTarget &target, RenderStates states) const override;
+
+public:
+    TileMap();
+    TileMap(const TileMap &) = delete;
+    TileMap &operator=(const TileMap &) = delete;
+    ~TileMap();
+
+    // Allocate a rows x cols board of tileSize squares cut from `texture`
+    void create(const Texture &texture, int rows, int cols, int tileSize);
+
+    // Part of the texture shown for a grid value; values without one are left empty
+    void setTile(int value, const IntRect &rect);
+
+    // Bring the quads in line with the grid - only cells whose value changed are rewritten,
+    // all of them when the tint changes. Returns the number of cells rewritten
+    int update(const int *grid, const Color &tint);
+
+    const Texture *getTexture() const;
+};
+
+// Sprites that share one texture (an atlas), collected each frame and drawn with a single call
+class SpriteBatch : public Drawable
+{
+private:
+    VertexArray vertices;
+    const Texture *texture;
+
+    void draw(RenderTarget &target, RenderStates states) const override;
+
+public:
+    SpriteBatch();
+
+    void clear();
+
+    // Copies the sprite as it is now - position, rotation, scale, texture rect and color
+    void add(const Sprite &sprite);
+
+    bool isEmpty() const;
+    const Texture *getTexture() const;
+};
@@ -0,0 +1,66 @@
+// Xonix Game
+// Persistent username index - memory-mapped open-addressing table (data/usernames.idx)
+// Queried in place, so startup no longer rebuilds the HashTable from every player
+
+#pragma once
+#include <string>
+#include <cstdint>
+#include "MappedFile.h"
+#include "PlayerStore.h"
+
+using namespace std;
+
+struct IndexSlot
+{
+    uint32_t hash;
+    int32_t playerId;    // -1 = empty slot
+    int32_t arrayIndex;  // Position in System::ArrayOfPlayers
+    char username[STORE_USERNAME_LEN];
+};
+
+struct IndexHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t slotSize;
+    uint32_t capacity;  // Power of two
+    uint32_t count;
+    uint32_t listed;    // AllPlayers.txt rows this index reflects (staleness check)
+};
+
+class UsernameIndex
+{
+private:
+    MappedFile file;
+    string path;
+
+    IndexHeader *header() const;
+    IndexSlot *slot(uint32_t i) const;
+    uint32_t hashOf(const string &username) const;
+    const IndexSlot *findSlot(const string &username) const;
+    bool initialize(uint32_t capacity);
+    bool grow();
+
+    UsernameIndex();
+
+public:
+    static const char *DEFAULT_PATH;
+
+    static UsernameIndex &instance();
+
+    bool open(const string &indexPath = DEFAULT_PATH);
+    bool create(const string &indexPath = DEFAULT_PATH, uint32_t capacity = 1024);
+    void close();
+    bool isOpen() const;
+
+    bool insert(const string &username, const string &playerId, int arrayIndex);
+    string getPlayerId(const string &username) const;
+    int getArrayIndex(const string &username) const;
+    bool exists(const string &username) const;
+
+    int getCount() const;
+    int getListedCount() const;
+    void setListedCount(int listed);
+    void flush();
+    void display() const;
+};
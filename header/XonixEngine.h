@@ -0,0 +1,115 @@
+// Xonix Game
+// Headless Xonix rules - movement, collisions, captures, scoring and power-ups, no SFML
+// SinglePlayer and Multiplayer feed it keyboard input and draw state(); tools can run it without a display
+
+#pragma once
+#include "Constants.h"
+#include "Territory.h"
+#include "GameRng.h"
+
+const int MAX_ENEMIES = 10;
+const int MAX_PLAYERS = 2;
+const float FREEZE_TIME = 3.0f;  // Seconds a power-up keeps the enemies (and the other player) frozen
+
+// What the player asks for during one tick
+struct EngineInput
+{
+    int dx, dy;       // Direction pressed; 0, 0 keeps the current one
+    bool usePowerUp;  // Freeze the enemies, if one is in stock
+
+    EngineInput(int dx = 0, int dy = 0, bool usePowerUp = false);
+};
+
+struct EngineEnemy
+{
+    int x, y, dx, dy;  // Pixels, pixels per tick
+    int prevX, prevY;  // Position before the last tick, for interpolated drawing
+    bool frozen;
+};
+
+// One player's side of the game
+struct EnginePlayer
+{
+    int x, y, dx, dy;   // Cell and direction
+    bool alive;
+    bool frozen;        // Held still by the other player's power-up
+    bool constructing;  // Off the wall - the other player dies running into this player
+    int trail;          // Grid value this player's trail is laid with
+    float moveTimer;    // Time since the player last moved a cell
+
+    // Scoring and power-ups
+    int score;
+    int bonusCount;
+    int powerUps;
+    int nextPowerUpScore;
+    int powerUpsUsed;
+    bool powerUpActive;  // This player's freeze is running
+    float powerUpRemainingTime;
+
+    int captures;      // Captures that took at least one trail tile
+    int lastCaptured;  // Trail tiles taken this tick, 0 if none
+};
+
+// Everything a game is - copy it out to save, hand it to restore() to load
+struct EngineState
+{
+    int grid[M][N];  // 0 empty, 1 wall, 2 first player's trail, 3 second player's trail
+
+    int playerCount;  // 1, or 2 for a duel
+    EnginePlayer players[MAX_PLAYERS];
+
+    int enemyCount;
+    EngineEnemy enemies[MAX_ENEMIES];
+
+    // Difficulty (setLevel)
+    int level;
+    float moveDelay;
+    float enemySpeed;
+
+    uint64_t seed;    // newGame()/newDuel() seed - the same seed and inputs replay the same game
+    long long ticks;  // Simulation ticks since the game started
+
+    bool enemiesFrozen() const;  // Some player's freeze is running
+    bool anyAlive() const;
+};
+
+class XonixEngine
+{
+private:
+    EngineState current;
+    Territory capture;  // Told about every trail tile, so a capture only looks near the trail
+    GameRng rng;        // Owned per engine, so engines on different threads never share state
+
+    void resetBoard(int playerCount, uint64_t seed);
+    void placePlayer(int index, int x, int y, int powerUps);
+    void moveEnemy(EngineEnemy &enemy);
+    void movePlayer(EnginePlayer &player);
+    int captureArea(int trail);
+    void award(EnginePlayer &player, int captured);
+
+public:
+    XonixEngine();
+    XonixEngine(const XonixEngine &) = delete;
+    XonixEngine &operator=(const XonixEngine &) = delete;
+
+    // Fresh board: walls round the edge, player in the corner, enemies in the middle
+    // heading in directions drawn from seed
+    void newGame(int level, int powerUps, uint64_t seed);
+
+    // Two players on a level 1 board, in opposite corners, with an enemy near each corner.
+    // A power-up also freezes the other player, and running into the other player's trail,
+    // or into them while building, is fatal
+    void newDuel(int powerUps1, int powerUps2, uint64_t seed);
+
+    // Enemy count (levels 2-5), player move delay and enemy speed for a level
+    void setLevel(int level);
+
+    // Continue a saved game
+    void restore(const EngineState &saved);
+
+    // Advance one SIM_STEP tick - one input per player
+    void step(const EngineInput *inputs);
+    void step(const EngineInput &input);  // Single player
+
+    const EngineState &state() const;
+};
@@ -0,0 +1,360 @@
+// Xonix Game
+// Asset cache - chained path index over heap-allocated entries, handles count references
+
+#include "../header/AssetCache.h"
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+AssetEntry::AssetEntry(const string &assetPath, AssetKind assetKind)
+    : path(assetPath), kind(assetKind), asset(nullptr), data(nullptr), loaded(false), refs(0), bytes(0), loadMs(0),
+      chain(nullptr)
+{
+    if (kind == ASSET_TEXTURE)
+        asset = new Texture();
+    else if (kind == ASSET_SMOOTH_TEXTURE)
+    {
+        Texture *texture = new Texture();
+        texture->setSmooth(true);  // Kept through loadFromFile and loadFromImage
+        asset = texture;
+    }
+    else if (kind == ASSET_FONT)
+        asset = new Font();
+    else
+        asset = new SoundBuffer();
+}
+
+AssetEntry::~AssetEntry()
+{
+    if (kind == ASSET_TEXTURE || kind == ASSET_SMOOTH_TEXTURE)
+        delete static_cast<Texture *>(asset);
+    else if (kind == ASSET_FONT)
+        delete static_cast<Font *>(asset);
+    else
+        delete static_cast<SoundBuffer *>(asset);
+    delete[] data;
+}
+
+AssetCache::AssetCache()
+    : count(0), bytes(0), budget(DEFAULT_BUDGET), hits(0), misses(0), failures(0), evictions(0), loadMs(0)
+{
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        buckets[i] = nullptr;
+}
+
+// Handles must be gone by now - the cache outlives every screen
+AssetCache::~AssetCache()
+{
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        AssetEntry *curr = buckets[i];
+        while (curr)
+        {
+            AssetEntry *next = curr->chain;
+            delete curr;
+            curr = next;
+        }
+        buckets[i] = nullptr;
+    }
+}
+
+AssetCache &AssetCache::instance()
+{
+    static AssetCache cache;
+    return cache;
+}
+
+// Same polynomial hash as HashTable
+int AssetCache::bucketOf(const string &path) const
+{
+    unsigned long hash = 0;
+    for (int i = 0; i < (int)path.length(); i++)
+        hash = hash * 31 + path[i];
+    return hash % BUCKET_COUNT;
+}
+
+// A path may be cached once per kind
+AssetEntry *AssetCache::find(const string &path, AssetKind kind) const
+{
+    AssetEntry *curr = buckets[bucketOf(path)];
+    while (curr && (curr->kind != kind || curr->path != path))
+        curr = curr->chain;
+    return curr;
+}
+
+static long long fileSize(const string &path)
+{
+    ifstream file(path, ios::binary | ios::ate);
+    return file ? (long long)file.tellg() : 0;
+}
+
+void AssetCache::decode(AssetEntry *e)
+{
+    Clock clock;
+    if (e->kind == ASSET_TEXTURE || e->kind == ASSET_SMOOTH_TEXTURE)
+    {
+        Texture *texture = static_cast<Texture *>(e->asset);
+        e->loaded = texture->loadFromFile(e->path);
+        e->bytes = e->loaded ? (long long)texture->getSize().x * texture->getSize().y * 4 : 0;
+    }
+    else if (e->kind == ASSET_FONT)
+    {
+        // Font keeps the file open and rasterizes glyphs on demand - count the file
+        e->loaded = static_cast<Font *>(e->asset)->loadFromFile(e->path);
+        e->bytes = e->loaded ? fileSize(e->path) : 0;
+    }
+    else
+    {
+        SoundBuffer *sound = static_cast<SoundBuffer *>(e->asset);
+        e->loaded = sound->loadFromFile(e->path);
+        e->bytes = e->loaded ? (long long)sound->getSampleCount() * sizeof(Int16) : 0;
+    }
+    e->loadMs = clock.getElapsedTime().asSeconds() * 1000;
+
+    misses++;
+    loadMs += e->loadMs;
+    bytes += e->bytes;
+    if (!e->loaded)
+        failures++;
+}
+
+AssetEntry *AssetCache::acquire(const string &path, AssetKind kind)
+{
+    AssetEntry *e = find(path, kind);
+    if (e && e->loaded)
+    {
+        hits++;
+        return e;
+    }
+
+    if (!e)
+    {
+        e = new AssetEntry(path, kind);
+        int b = bucketOf(path);
+        e->chain = buckets[b];
+        buckets[b] = e;
+        count++;
+    }
+    decode(e);
+
+    // Over budget: let go of whatever no screen holds, but not the asset just asked for
+    if (bytes > budget)
+    {
+        e->refs++;
+        trim();
+        e->refs--;
+    }
+    return e;
+}
+
+void AssetCache::removeEntry(AssetEntry *e)
+{
+    int b = bucketOf(e->path);
+    AssetEntry *curr = buckets[b], *prev = nullptr;
+    while (curr && curr != e)
+    {
+        prev = curr;
+        curr = curr->chain;
+    }
+    if (curr)
+    {
+        if (prev)
+            prev->chain = curr->chain;
+        else
+            buckets[b] = curr->chain;
+    }
+
+    bytes -= e->bytes;
+    delete e;
+    count--;
+}
+
+AssetRef<Texture> AssetCache::texture(const string &path, bool smooth)
+{
+    if (!smooth)
+        return AssetRef<Texture>(acquire(path, ASSET_TEXTURE));
+
+    // Copy the unsmoothed texture on the GPU rather than decode the file again
+    AssetEntry *sharp = find(path, ASSET_TEXTURE);
+    AssetEntry *e = sharp && sharp->loaded ? adopt(path, ASSET_SMOOTH_TEXTURE, 0) : nullptr;
+    if (e)
+    {
+        Clock clock;
+        Texture *texture = static_cast<Texture *>(e->asset);
+        *texture = *static_cast<const Texture *>(sharp->asset);
+        texture->setSmooth(true);
+        e->loadMs = clock.getElapsedTime().asSeconds() * 1000;
+        adopted(e, true, sharp->bytes);
+        AssetRef<Texture> ref(e);
+        if (bytes > budget)
+            trim();
+        return ref;
+    }
+    return AssetRef<Texture>(acquire(path, ASSET_SMOOTH_TEXTURE));
+}
+
+AssetRef<Font> AssetCache::font(const string &path)
+{
+    return AssetRef<Font>(acquire(path, ASSET_FONT));
+}
+
+AssetRef<SoundBuffer> AssetCache::sound(const string &path)
+{
+    return AssetRef<SoundBuffer>(acquire(path, ASSET_SOUND));
+}
+
+// Entry to decode into from another thread's work - nullptr if the path is already loaded
+AssetEntry *AssetCache::adopt(const string &path, AssetKind kind, float decodeMs)
+{
+    AssetEntry *e = find(path, kind);
+    if (e && e->loaded)
+        return nullptr;
+
+    if (!e)
+    {
+        e = new AssetEntry(path, kind);
+        int b = bucketOf(path);
+        e->chain = buckets[b];
+        buckets[b] = e;
+        count++;
+    }
+    e->loadMs = decodeMs;
+    return e;
+}
+
+void AssetCache::adopted(AssetEntry *e, bool loaded, long long size)
+{
+    e->loaded = loaded;
+    e->bytes = loaded ? size : 0;
+    misses++;
+    loadMs += e->loadMs;
+    bytes += e->bytes;
+    if (!loaded)
+        failures++;
+}
+
+// Only the upload to the GPU happens here
+void AssetCache::adoptTexture(const string &path, const Image &image, float decodeMs)
+{
+    AssetEntry *e = adopt(path, ASSET_TEXTURE, decodeMs);
+    if (!e)
+        return;
+    Texture *texture = static_cast<Texture *>(e->asset);
+    bool loaded = image.getSize().x > 0 && texture->loadFromImage(image);
+    adopted(e, loaded, (long long)image.getSize().x * image.getSize().y * 4);
+}
+
+void AssetCache::adoptFont(const string &path, char *data, long long size, float decodeMs)
+{
+    AssetEntry *e = adopt(path, ASSET_FONT, decodeMs);
+    if (!e)
+    {
+        delete[] data;
+        return;
+    }
+    delete[] e->data;
+    e->data = data;
+    bool loaded = data && static_cast<Font *>(e->asset)->loadFromMemory(data, (size_t)size);
+    adopted(e, loaded, size);
+}
+
+void AssetCache::adoptSound(const string &path, SoundBuffer *sound, float decodeMs)
+{
+    AssetEntry *e = adopt(path, ASSET_SOUND, decodeMs);
+    if (!e)
+    {
+        delete sound;
+        return;
+    }
+    if (!sound)
+    {
+        adopted(e, false, 0);
+        return;
+    }
+
+    // A handle to the earlier failed load may be attached to a Sound - keep its buffer object
+    if (e->refs == 0)
+    {
+        delete static_cast<SoundBuffer *>(e->asset);
+        e->asset = sound;
+    }
+    else
+    {
+        *static_cast<SoundBuffer *>(e->asset) = *sound;
+        delete sound;
+        sound = static_cast<SoundBuffer *>(e->asset);
+    }
+    adopted(e, true, (long long)sound->getSampleCount() * sizeof(Int16));
+}
+
+int AssetCache::trim()
+{
+    int dropped = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        AssetEntry *curr = buckets[i];
+        while (curr)
+        {
+            AssetEntry *next = curr->chain;
+            if (curr->refs == 0)
+            {
+                removeEntry(curr);
+                dropped++;
+            }
+            curr = next;
+        }
+    }
+    evictions += dropped;
+    return dropped;
+}
+
+void AssetCache::setBudget(long long maxBytes)
+{
+    budget = maxBytes > 0 ? maxBytes : 0;
+    if (bytes > budget)
+        trim();
+}
+
+int AssetCache::getSize() const
+{
+    return count;
+}
+
+long long AssetCache::getBytes() const
+{
+    return bytes;
+}
+
+long long AssetCache::getHits() const
+{
+    return hits;
+}
+
+long long AssetCache::getMisses() const
+{
+    return misses;
+}
+
+double AssetCache::getLoadMs() const
+{
+    return loadMs;
+}
+
+void AssetCache::displayStats() const
+{
+    long long requests = hits + misses;
+    cout << "\n===== Asset Cache =====\n";
+    cout << "Assets: " << count << "  Memory: " << bytes / 1024 << " KB" << endl;
+    cout << "Hits: " << hits << "  Loads: " << misses << "  Failed: " << failures << "  Evicted: " << evictions << endl;
+    if (requests > 0)
+        cout << "Hit rate: " << (hits * 100 / requests) << "%" << endl;
+    cout << "Decode time: " << loadMs << " ms" << endl;
+
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        for (AssetEntry *e = buckets[i]; e; e = e->chain)
+            cout << "  " << e->path << (e->kind == ASSET_SMOOTH_TEXTURE ? " (smooth)" : "") << ": "
+                 << e->bytes / 1024 << " KB, " << e->loadMs << " ms, " << e->refs << " refs"
+                 << (e->loaded ? "" : " (failed)") << endl;
+    cout << "=======================\n";
+}
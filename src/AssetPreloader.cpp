@@ -0,0 +1,170 @@
+// Xonix Game
+// Startup asset preloader
+
+#include "../header/AssetPreloader.h"
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+PreloadJob::PreloadJob()
+    : owner(nullptr), kind(ASSET_TEXTURE), data(nullptr), size(0), sound(nullptr), decodeMs(0)
+{
+}
+
+// Whatever the cache did not take
+PreloadJob::~PreloadJob()
+{
+    delete[] data;
+    delete sound;
+}
+
+static AssetKind kindOf(const char *path)
+{
+    const char *dot = strrchr(path, '.');
+    if (!dot)
+        return ASSET_TEXTURE;
+    char ext[8] = {0};
+    for (int i = 0; i < 7 && dot[i + 1]; i++)
+        ext[i] = (char)tolower((unsigned char)dot[i + 1]);
+
+    if (strcmp(ext, "ttf") == 0 || strcmp(ext, "otf") == 0)
+        return ASSET_FONT;
+    if (strcmp(ext, "mp3") == 0 || strcmp(ext, "ogg") == 0 || strcmp(ext, "wav") == 0 || strcmp(ext, "flac") == 0)
+        return ASSET_SOUND;
+    return ASSET_TEXTURE;
+}
+
+AssetPreloader::AssetPreloader(const char *const *paths, int count)
+    : jobs(nullptr), jobCount(count > 0 ? count : 0), pool(nullptr), finished(nullptr), published(nullptr),
+      claimed(0), consumed(0)
+{
+    jobs = new PreloadJob[jobCount];
+    finished = new PreloadJob *[jobCount];
+    published = new std::atomic<bool>[jobCount];
+    for (int i = 0; i < jobCount; i++)
+    {
+        jobs[i].owner = this;
+        jobs[i].path = paths[i];
+        jobs[i].kind = kindOf(paths[i]);
+        finished[i] = nullptr;
+        published[i].store(false);
+    }
+}
+
+AssetPreloader::~AssetPreloader()
+{
+    delete pool;  // Joins - no worker touches the jobs after this
+    delete[] jobs;
+    delete[] finished;
+    delete[] published;
+}
+
+void AssetPreloader::start(int threads)
+{
+    if (pool || jobCount == 0)
+        return;
+    pool = new TaskPool(threads);
+
+    // Each worker takes its newest task first, so submit back to front: the head of the list
+    // (put the slowest file there) starts right away
+    for (int i = jobCount - 1; i >= 0; i--)
+        pool->submit(decodeJob, &jobs[i]);
+}
+
+// Worker thread - touches nothing but its own job
+void AssetPreloader::decodeJob(void *arg)
+{
+    PreloadJob *job = static_cast<PreloadJob *>(arg);
+    Clock clock;
+
+    if (job->kind == ASSET_TEXTURE)
+    {
+        if (!job->image.loadFromFile(job->path))
+            job->image = Image();
+    }
+    else if (job->kind == ASSET_FONT)
+    {
+        ifstream file(job->path, ios::binary | ios::ate);
+        if (file)
+        {
+            job->size = (long long)file.tellg();
+            job->data = new char[job->size > 0 ? job->size : 1];
+            file.seekg(0);
+            if (!file.read(job->data, job->size))
+            {
+                delete[] job->data;
+                job->data = nullptr;
+                job->size = 0;
+            }
+        }
+    }
+    else
+    {
+        job->sound = new SoundBuffer();
+        if (!job->sound->loadFromFile(job->path))
+        {
+            delete job->sound;
+            job->sound = nullptr;
+        }
+    }
+
+    job->decodeMs = clock.getElapsedTime().asSeconds() * 1000;
+    job->owner->complete(job);
+}
+
+// Claim the next slot, fill it, then publish it - the release store orders the decode before it
+void AssetPreloader::complete(PreloadJob *job)
+{
+    int slot = claimed.fetch_add(1, std::memory_order_relaxed);
+    finished[slot] = job;
+    published[slot].store(true, std::memory_order_release);
+}
+
+int AssetPreloader::poll()
+{
+    AssetCache &cache = AssetCache::instance();
+    int handed = 0;
+    while (consumed < jobCount && published[consumed].load(std::memory_order_acquire))
+    {
+        PreloadJob *job = finished[consumed++];
+        if (job->kind == ASSET_TEXTURE)
+        {
+            cache.adoptTexture(job->path, job->image, job->decodeMs);
+            job->image = Image();
+        }
+        else if (job->kind == ASSET_FONT)
+        {
+            cache.adoptFont(job->path, job->data, job->size, job->decodeMs);
+            job->data = nullptr;
+        }
+        else
+        {
+            cache.adoptSound(job->path, job->sound, job->decodeMs);
+            job->sound = nullptr;
+        }
+        handed++;
+    }
+
+    // Everything is in the cache - let the worker threads go
+    if (isDone() && pool)
+    {
+        delete pool;
+        pool = nullptr;
+    }
+    return handed;
+}
+
+int AssetPreloader::getLoaded() const
+{
+    return consumed;
+}
+
+int AssetPreloader::getTotal() const
+{
+    return jobCount;
+}
+
+bool AssetPreloader::isDone() const
+{
+    return consumed == jobCount;
+}
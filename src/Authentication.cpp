@@ -11,6 +11,8 @@
 #include "../header/FriendManagement.h"
 #include "../header/MatchmakingQueue.h"
 #include "../header/Multiplayer.h"
+#include "../header/PlayerStore.h"
+#include "../header/ScreenPacer.h"
 
 using namespace std;
 using namespace sf;
@@ -19,13 +21,17 @@ AuthenticationSystem::AuthenticationSystem(RenderWindow *win)
     : usernameInput(""), passwordInput(""), isRegisterMode(false), typingUsername(true)
 {
     window = win;
-    if (!font.loadFromFile("assets/fonts/COOPBL.ttf"))
+    AssetCache &assets = AssetCache::instance();
+    font = assets.font("assets/fonts/COOPBL.ttf");
+    sfont = assets.font("assets/fonts/MATURASC.ttf");
+    backgroundTexture = assets.texture("assets/images/authentication.png");
+    if (!font.isLoaded())
         cout << "Failed to load font.\n";
-    if (!sfont.loadFromFile("assets/fonts/MATURASC.ttf"))
+    if (!sfont.isLoaded())
         cout << "Failed to load font.\n";
-    if (!backgroundTexture.loadFromFile("assets/images/authentication.png"))
+    if (!backgroundTexture.isLoaded())
         cout << "Failed to load image\n";
-    backgroundSprite.setTexture(backgroundTexture);
+    backgroundSprite.setTexture(*backgroundTexture);
 
     setupUI();
 }
@@ -40,24 +46,24 @@ void AuthenticationSystem::setupUI()
     passwordBox.setPosition(240, 260);
     passwordBox.setFillColor(Color::White);
 
-    usernameLabel.setFont(font);
+    usernameLabel.setFont(*font);
     usernameLabel.setCharacterSize(22);
     usernameLabel.setPosition(240, 175);
     usernameLabel.setFillColor(Color::White);
     usernameLabel.setString("Username:");
 
-    passwordLabel.setFont(font);
+    passwordLabel.setFont(*font);
     passwordLabel.setCharacterSize(22);
     passwordLabel.setPosition(240, 235);
     passwordLabel.setFillColor(Color::White);
     passwordLabel.setString("Password:");
 
-    usernameText.setFont(font);
+    usernameText.setFont(*font);
     usernameText.setCharacterSize(20);
     usernameText.setPosition(245, 205);
     usernameText.setFillColor(Color::Black);
 
-    passwordText.setFont(font);
+    passwordText.setFont(*font);
     passwordText.setCharacterSize(20);
     passwordText.setPosition(245, 265);
     passwordText.setFillColor(Color::Black);
@@ -66,7 +72,7 @@ void AuthenticationSystem::setupUI()
     loginButton.setPosition(240, 330);
     loginButton.setFillColor(Color(100, 200, 100));
 
-    loginButtonText.setFont(font);
+    loginButtonText.setFont(*font);
     loginButtonText.setCharacterSize(27);
     loginButtonText.setPosition(255, 332);
     loginButtonText.setFillColor(Color::Black);
@@ -76,18 +82,18 @@ void AuthenticationSystem::setupUI()
     switchModeButton.setPosition(400, 330);
     switchModeButton.setFillColor(Color(200, 100, 100));
 
-    switchModeButtonText.setFont(font);
+    switchModeButtonText.setFont(*font);
     switchModeButtonText.setCharacterSize(27);
     switchModeButtonText.setPosition(410, 332);
     switchModeButtonText.setFillColor(Color::Black);
     switchModeButtonText.setString("Register");
 
-    messageText.setFont(font);
+    messageText.setFont(*font);
     messageText.setCharacterSize(18);
     messageText.setFillColor(Color::Red);
     messageText.setPosition(40, 450);
 
-    screenText.setFont(sfont);
+    screenText.setFont(*sfont);
     screenText.setCharacterSize(100);
     screenText.setPosition(55, 50);
     screenText.setFillColor(Color::Red);
@@ -97,7 +103,7 @@ void AuthenticationSystem::setupUI()
     scheduledButton.setPosition(230, 390);
     scheduledButton.setFillColor(Color(100, 100, 200));
 
-    scheduledButtonText.setFont(font);
+    scheduledButtonText.setFont(*font);
     scheduledButtonText.setCharacterSize(24);
     scheduledButtonText.setPosition(290, 392);
     scheduledButtonText.setFillColor(Color::White);
@@ -106,10 +112,11 @@ void AuthenticationSystem::setupUI()
 
 void AuthenticationSystem::authenticationLoop()
 {
+    ScreenPacer pacer("Login");
     while (window->isOpen())
     {
         Event evnt;
-        while (window->pollEvent(evnt))
+        while (pacer.nextEvent(*window, evnt))
         {
             if (evnt.type == Event::Closed)
                 window->close();
@@ -119,7 +126,11 @@ void AuthenticationSystem::authenticationLoop()
                 handleMouseClick(Mouse::getPosition(*window));
         }
 
-        render();
+        if (pacer.redraw())
+        {
+            render();
+            markFirstFrame();
+        }
     }
 }
 
@@ -231,7 +242,12 @@ void AuthenticationSystem::attemptRegister()
         messageText.setString(msg);
         return;
     }
-    system.addPlayer(getCurrentTimeString(), usernameInput, passwordInput);
+    if (!system.addPlayer(getCurrentTimeString(), usernameInput, passwordInput))
+    {
+        messageText.setFillColor(Color::Red);
+        messageText.setString("Registration failed. Please try again.");
+        return;
+    }
     messageText.setFillColor(Color::Green);
     messageText.setString("Registration successful!");
 }
@@ -239,21 +255,22 @@ void AuthenticationSystem::attemptRegister()
 // Username validation - no spaces allowed
 bool AuthenticationSystem::isValidUsername(string &u, string &msg)
 {
-    Player *temp;
     while (!u.empty() && u.back() == ' ')
         u.pop_back();
     int len = static_cast<int>(u.length());
 
     // Check if username already exists in the system
-    for (int i = 0; i < system.noOfPlayers; i++)
+    if (system.usernameExists(u))
     {
-        temp = system.returnPlayer(system.ArrayOfPlayers[i]);
-        if (temp->username == u)
-        {
-            msg = "Username already exists.";
-            return false;
-        }
-        delete temp;
+        msg = "Username already exists.";
+        return false;
+    }
+
+    // Must fit the fixed-width username field of the player database
+    if (len >= STORE_USERNAME_LEN)
+    {
+        msg = "Username too long (max " + to_string(STORE_USERNAME_LEN - 1) + " characters).";
+        return false;
     }
 
     // Check for spaces within the username
@@ -393,8 +410,8 @@ void AuthenticationSystem::openGameRoom()
 {
     GameRoom gameRoom(&system);
 
-    Font roomFont;
-    if (!roomFont.loadFromFile("assets/fonts/arial.ttf"))
+    AssetRef<Font> roomFont = AssetCache::instance().font("assets/fonts/arial.ttf");
+    if (!roomFont.isLoaded())
     {
         cerr << "Failed to load font\n";
         return;
@@ -406,12 +423,12 @@ void AuthenticationSystem::openGameRoom()
     (void)H; // Suppress unused variable warnings
 
     // Title
-    Text titleText("Game Room", roomFont, 36);
+    Text titleText("Game Room", *roomFont, 36);
     titleText.setFillColor(Color::Cyan);
     titleText.setPosition(320, 15);
 
     // Join Queue Section
-    Text joinLabel("Enter Player ID to Join Queue:", roomFont, 18);
+    Text joinLabel("Enter Player ID to Join Queue:", *roomFont, 18);
     joinLabel.setFillColor(Color::White);
     joinLabel.setPosition(50, 70);
 
@@ -421,7 +438,7 @@ void AuthenticationSystem::openGameRoom()
     idBox.setOutlineThickness(2);
     idBox.setOutlineColor(Color::Yellow);
 
-    Text idInput("", roomFont, 20);
+    Text idInput("", *roomFont, 20);
     idInput.setFillColor(Color::Black);
     idInput.setPosition(290, 70);
 
@@ -429,12 +446,12 @@ void AuthenticationSystem::openGameRoom()
     joinButton.setPosition(450, 65);
     joinButton.setFillColor(Color(100, 200, 100));
 
-    Text joinButtonText("Join Queue", roomFont, 16);
+    Text joinButtonText("Join Queue", *roomFont, 16);
     joinButtonText.setFillColor(Color::Black);
     joinButtonText.setPosition(465, 72);
 
     // Waiting Queue Display
-    Text queueLabel("Waiting Queue (Highest Score First):", roomFont, 16);
+    Text queueLabel("Waiting Queue (Highest Score First):", *roomFont, 16);
     queueLabel.setFillColor(Color::Yellow);
     queueLabel.setPosition(50, 120);
 
@@ -445,7 +462,7 @@ void AuthenticationSystem::openGameRoom()
     queuePanel.setOutlineThickness(2);
 
     // Match Queue Display
-    Text matchLabel("Scheduled Matches:", roomFont, 16);
+    Text matchLabel("Scheduled Matches:", *roomFont, 16);
     matchLabel.setFillColor(Color::Yellow);
     matchLabel.setPosition(420, 120);
 
@@ -460,7 +477,7 @@ void AuthenticationSystem::openGameRoom()
     startMatchmakingBtn.setPosition(120, 420);
     startMatchmakingBtn.setFillColor(Color(200, 150, 50));
 
-    Text startMatchmakingText("Start Matchmaking", roomFont, 16);
+    Text startMatchmakingText("Start Matchmaking", *roomFont, 16);
     startMatchmakingText.setFillColor(Color::Black);
     startMatchmakingText.setPosition(135, 430);
 
@@ -468,7 +485,7 @@ void AuthenticationSystem::openGameRoom()
     playMatchesBtn.setPosition(500, 420);
     playMatchesBtn.setFillColor(Color(50, 150, 200));
 
-    Text playMatchesText("Play Matches", roomFont, 16);
+    Text playMatchesText("Play Matches", *roomFont, 16);
     playMatchesText.setFillColor(Color::Black);
     playMatchesText.setPosition(535, 430);
 
@@ -476,7 +493,7 @@ void AuthenticationSystem::openGameRoom()
     clearQueueBtn.setPosition(330, 422);
     clearQueueBtn.setFillColor(Color(150, 100, 100));
 
-    Text clearQueueText("Clear All", roomFont, 14);
+    Text clearQueueText("Clear All", *roomFont, 14);
     clearQueueText.setFillColor(Color::White);
     clearQueueText.setPosition(355, 430);
 
@@ -484,26 +501,27 @@ void AuthenticationSystem::openGameRoom()
     backBtn.setPosition(350, 550);
     backBtn.setFillColor(Color(200, 100, 100));
 
-    Text backBtnText("Back", roomFont, 16);
+    Text backBtnText("Back", *roomFont, 16);
     backBtnText.setFillColor(Color::White);
     backBtnText.setPosition(380, 557);
 
     // Message text
-    Text msgText("", roomFont, 16);
+    Text msgText("", *roomFont, 16);
     msgText.setPosition(50, 480);
 
     // Instructions
-    Text instrText("Enter Player ID (e.g., 0, 1, 2) and click 'Join Queue' | ESC: Back", roomFont, 13);
+    Text instrText("Enter Player ID (e.g., 0, 1, 2) and click 'Join Queue' | ESC: Back", *roomFont, 13);
     instrText.setFillColor(Color(180, 180, 180));
     instrText.setPosition(180, 520);
 
     // State variables
     string playerIdInput = "";
 
+    ScreenPacer pacer("Game room");
     while (window->isOpen())
     {
         Event e;
-        while (window->pollEvent(e))
+        while (pacer.nextEvent(*window, e))
         {
             if (e.type == Event::Closed)
             {
@@ -524,10 +542,8 @@ void AuthenticationSystem::openGameRoom()
                     {
                         if (gameRoom.addPlayerByID(playerIdInput))
                         {
-                            Player *p = system.returnPlayer(playerIdInput);
-                            string name = p ? p->username : playerIdInput;
-                            if (p)
-                                delete p;
+                            PlayerView p = system.viewPlayer(playerIdInput, FIELD_PROFILE);
+                            string name = p.isValid() ? p->username : playerIdInput;
                             msgText.setFillColor(Color::Green);
                             msgText.setString(name + " (ID: " + playerIdInput + ") joined the queue!");
                             playerIdInput.clear();
@@ -566,10 +582,8 @@ void AuthenticationSystem::openGameRoom()
                     {
                         if (gameRoom.addPlayerByID(playerIdInput))
                         {
-                            Player *p = system.returnPlayer(playerIdInput);
-                            string name = p ? p->username : playerIdInput;
-                            if (p)
-                                delete p;
+                            PlayerView p = system.viewPlayer(playerIdInput, FIELD_PROFILE);
+                            string name = p.isValid() ? p->username : playerIdInput;
                             msgText.setFillColor(Color::Green);
                             msgText.setString(name + " (ID: " + playerIdInput + ") joined the queue!");
                             playerIdInput.clear();
@@ -634,6 +648,9 @@ void AuthenticationSystem::openGameRoom()
         // Update input display
         idInput.setString(playerIdInput + "_");
 
+        if (!pacer.redraw())
+            continue;
+
         // Draw everything
         window->clear(Color(30, 30, 50));
 
@@ -656,7 +673,7 @@ void AuthenticationSystem::openGameRoom()
         for (int i = 0; i < queueCount && i < 7; i++)
         {
             QueuedPlayer qp = gameRoom.getWaitingPlayer(i);
-            Text playerText(to_string(i + 1) + ". " + qp.username + " (ID:" + qp.playerID + ", Score:" + to_string(qp.score) + ")", roomFont, 14);
+            Text playerText(to_string(i + 1) + ". " + qp.username + " (ID:" + qp.playerID + ", Score:" + to_string(qp.score) + ")", *roomFont, 14);
             playerText.setFillColor(i == 0 ? Color::Yellow : Color::White);
             playerText.setPosition(60, 155 + i * 32);
             window->draw(playerText);
@@ -664,14 +681,14 @@ void AuthenticationSystem::openGameRoom()
 
         if (queueCount == 0)
         {
-            Text emptyText("No players in queue", roomFont, 14);
+            Text emptyText("No players in queue", *roomFont, 14);
             emptyText.setFillColor(Color(150, 150, 150));
             emptyText.setPosition(130, 250);
             window->draw(emptyText);
         }
 
         // Queue count
-        Text countText("Total: " + to_string(queueCount) + " player(s)", roomFont, 12);
+        Text countText("Total: " + to_string(queueCount) + " player(s)", *roomFont, 12);
         countText.setFillColor(Color::Cyan);
         countText.setPosition(60, 375);
         window->draw(countText);
@@ -685,12 +702,12 @@ void AuthenticationSystem::openGameRoom()
         for (int i = 0; i < matchCount && i < 6; i++)
         {
             Match m = gameRoom.getMatchAt(i);
-            Text matchText("Match " + to_string(i + 1) + ": " + m.p1Username + " vs " + m.p2Username, roomFont, 13);
+            Text matchText("Match " + to_string(i + 1) + ": " + m.p1Username + " vs " + m.p2Username, *roomFont, 13);
             matchText.setFillColor(Color::White);
             matchText.setPosition(430, 155 + i * 38);
             window->draw(matchText);
 
-            Text scoreText("(Score: " + to_string(m.p1Score) + " vs " + to_string(m.p2Score) + ")", roomFont, 11);
+            Text scoreText("(Score: " + to_string(m.p1Score) + " vs " + to_string(m.p2Score) + ")", *roomFont, 11);
             scoreText.setFillColor(Color(180, 180, 180));
             scoreText.setPosition(440, 172 + i * 38);
             window->draw(scoreText);
@@ -698,14 +715,14 @@ void AuthenticationSystem::openGameRoom()
 
         if (matchCount == 0)
         {
-            Text emptyMatchText("No matches scheduled", roomFont, 14);
+            Text emptyMatchText("No matches scheduled", *roomFont, 14);
             emptyMatchText.setFillColor(Color(150, 150, 150));
             emptyMatchText.setPosition(500, 250);
             window->draw(emptyMatchText);
         }
 
         // Match count
-        Text matchCountText("Total: " + to_string(matchCount) + " match(es)", roomFont, 12);
+        Text matchCountText("Total: " + to_string(matchCount) + " match(es)", *roomFont, 12);
         matchCountText.setFillColor(Color::Cyan);
         matchCountText.setPosition(430, 375);
         window->draw(matchCountText);
@@ -0,0 +1,184 @@
+// Xonix Game
+// Bit-plane capture - word-parallel flood fill, popcount for the score
+
+#include "../header/BitGrid.h"
+#include "../header/GridKernels.h"
+
+static inline int popcount(uint64_t v)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(v);
+#else
+    int n = 0;
+    for (; v; v &= v - 1)
+        n++;
+    return n;
+#endif
+}
+
+static inline int lowestBit(uint64_t v)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while (!(v & 1))
+    {
+        v >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// Occluded fill (Kogge-Stone): extend g along the row in both directions
+// through the cells set in p, six shifts per direction for a 64-bit row
+static inline uint64_t spreadRow(uint64_t g, uint64_t p)
+{
+    uint64_t left = g, pl = p;
+    left |= pl & (left << 1);
+    pl &= pl << 1;
+    left |= pl & (left << 2);
+    pl &= pl << 2;
+    left |= pl & (left << 4);
+    pl &= pl << 4;
+    left |= pl & (left << 8);
+    pl &= pl << 8;
+    left |= pl & (left << 16);
+    pl &= pl << 16;
+    left |= pl & (left << 32);
+
+    uint64_t right = g, pr = p;
+    right |= pr & (right >> 1);
+    pr &= pr >> 1;
+    right |= pr & (right >> 2);
+    pr &= pr >> 2;
+    right |= pr & (right >> 4);
+    pr &= pr >> 4;
+    right |= pr & (right >> 8);
+    pr &= pr >> 8;
+    right |= pr & (right >> 16);
+    pr &= pr >> 16;
+    right |= pr & (right >> 32);
+
+    return left | right;
+}
+
+BitGrid::BitGrid() : rows(0), cols(0), capacity(0), planes(nullptr) {}
+
+BitGrid::~BitGrid()
+{
+    delete[] planes;
+}
+
+uint64_t *BitGrid::plane(int index) const
+{
+    return planes + index * capacity;
+}
+
+bool BitGrid::load(const int *grid, int rowCount, int colCount, int trailValue)
+{
+    if (colCount <= 0 || colCount > MAX_COLS || rowCount <= 0)
+        return false;
+
+    if (rowCount > capacity)
+    {
+        delete[] planes;
+        planes = new uint64_t[4 * rowCount];
+        capacity = rowCount;
+    }
+    rows = rowCount;
+    cols = colCount;
+
+    const GridKernels &kernels = gridKernels();
+    uint64_t *wall = plane(0), *trail = plane(1), *empty = plane(2), *reach = plane(3);
+    for (int r = 0; r < rows; r++)
+    {
+        kernels.packRow(grid + r * cols, cols, trailValue, &wall[r], &trail[r], &empty[r]);
+        reach[r] = 0;
+    }
+    return true;
+}
+
+void BitGrid::spreadFrom(const int *seeds, int seedCount)
+{
+    uint64_t *empty = plane(2), *reach = plane(3);
+    for (int i = 0; i < seedCount; i++)
+    {
+        if (seeds[i] < 0 || seeds[i] >= rows * cols)
+            continue;
+        int r = seeds[i] / cols;
+        reach[r] |= ((uint64_t)1 << (seeds[i] % cols)) & empty[r];
+    }
+
+    // Sweep down then up, spreading along each row as we go; a few rounds
+    // settle any shape, each round is 2 * rows word operations
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int r = 0; r < rows; r++)
+        {
+            uint64_t from = reach[r] | (r > 0 ? reach[r - 1] : 0) | (r + 1 < rows ? reach[r + 1] : 0);
+            uint64_t next = spreadRow(from & empty[r], empty[r]);
+            changed |= next != reach[r];
+            reach[r] = next;
+        }
+        for (int r = rows - 1; r >= 0; r--)
+        {
+            uint64_t from = reach[r] | (r > 0 ? reach[r - 1] : 0) | (r + 1 < rows ? reach[r + 1] : 0);
+            uint64_t next = spreadRow(from & empty[r], empty[r]);
+            changed |= next != reach[r];
+            reach[r] = next;
+        }
+    }
+}
+
+int BitGrid::commit(int *grid) const
+{
+    const uint64_t *trail = plane(1), *empty = plane(2), *reach = plane(3);
+    int captured = 0;
+    for (int r = 0; r < rows; r++)
+    {
+        captured += popcount(trail[r]);
+
+        // Only cells that change are touched - reached cells are already 0
+        int *line = grid + r * cols;
+        for (uint64_t toWall = trail[r] | (empty[r] & ~reach[r]); toWall; toWall &= toWall - 1)
+            line[lowestBit(toWall)] = 1;
+    }
+    return captured;
+}
+
+const uint64_t *BitGrid::wallPlane() const
+{
+    return plane(0);
+}
+
+const uint64_t *BitGrid::trailPlane() const
+{
+    return plane(1);
+}
+
+const uint64_t *BitGrid::freePlane() const
+{
+    return plane(2);
+}
+
+const uint64_t *BitGrid::reachPlane() const
+{
+    return plane(3);
+}
+
+int BitGrid::resolveCapture(int *grid, int rowCount, int colCount, int trailValue, const int *seeds, int seedCount)
+{
+    if (load(grid, rowCount, colCount, trailValue))
+    {
+        spreadFrom(seeds, seedCount);
+        return commit(grid);
+    }
+
+    // Too wide for one word per row - mark the enemy area with -1, then convert
+    wideFill.fill(grid, rowCount, colCount, seeds, seedCount, 0, -1);
+    return gridKernels().rewriteCapture(grid, rowCount * colCount, trailValue);
+}
@@ -0,0 +1,83 @@
+// Xonix Game
+// Scanline flood fill - fills a whole horizontal run per pop, pushes one seed per run above/below
+
+#include "../header/FloodFill.h"
+
+FloodFill::FloodFill() : stack(nullptr), capacity(0) {}
+
+FloodFill::~FloodFill()
+{
+    delete[] stack;
+}
+
+// Sized once for the board; only grows for a larger board or a pathological seed list
+void FloodFill::reserve(int cells)
+{
+    if (cells <= capacity)
+        return;
+    int *bigger = new int[cells];
+    delete[] stack;
+    stack = bigger;
+    capacity = cells;
+}
+
+int FloodFill::fill(int *grid, int rows, int cols, const int *seeds, int seedCount, int from, int to)
+{
+    if (from == to || rows <= 0 || cols <= 0)
+        return 0;
+
+    // A seed is pushed at most once per neighbouring span fill, which never exceeds
+    // two per cell - plus the initial seeds
+    reserve(2 * rows * cols + seedCount);
+
+    int top = 0;
+    for (int i = 0; i < seedCount; i++)
+    {
+        if (seeds[i] >= 0 && seeds[i] < rows * cols && grid[seeds[i]] == from)
+            stack[top++] = seeds[i];
+    }
+
+    int changed = 0;
+    while (top > 0)
+    {
+        int cell = stack[--top];
+        if (grid[cell] != from)
+            continue;  // Filled through another seed meanwhile
+
+        int row = cell / cols;
+        int *line = grid + row * cols;
+        int left = cell - row * cols;
+        int right = left;
+        while (left > 0 && line[left - 1] == from)
+            left--;
+        while (right < cols - 1 && line[right + 1] == from)
+            right++;
+
+        for (int x = left; x <= right; x++)
+            line[x] = to;
+        changed += right - left + 1;
+
+        // One seed per run of fillable cells directly above and below the span
+        for (int r = row - 1; r <= row + 1; r += 2)
+        {
+            if (r < 0 || r >= rows)
+                continue;
+            int *next = grid + r * cols;
+            bool inRun = false;
+            for (int x = left; x <= right; x++)
+            {
+                if (next[x] == from)
+                {
+                    if (!inRun)
+                        stack[top++] = r * cols + x;
+                    inRun = true;
+                }
+                else
+                {
+                    inRun = false;
+                }
+            }
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,98 @@
+// Xonix Game
+// Frame time and draw-call overlay
+
+#include "../header/FrameStats.h"
+#include "../header/TileMap.h"
+#include <cstdio>
+
+static const float SMOOTHING = 0.05f;  // Weight of the newest frame
+
+FrameStats::FrameStats()
+    : frameMs(0), renderMs(0), drawCalls(0), cellsRebuilt(0), textureBinds(0), lastTexture(nullptr), visible(false)
+{
+    text.setCharacterSize(14);
+    text.setFillColor(Color::Green);
+    text.setPosition(10, 50);
+}
+
+void FrameStats::setFont(const Font &font)
+{
+    text.setFont(font);
+}
+
+void FrameStats::toggle()
+{
+    visible = !visible;
+}
+
+void FrameStats::beginFrame()
+{
+    float frame = frameClock.restart().asSeconds() * 1000;
+    frameMs += (frame - frameMs) * SMOOTHING;
+    renderClock.restart();
+    drawCalls = 0;
+    cellsRebuilt = 0;
+    textureBinds = 0;
+    lastTexture = nullptr;
+}
+
+// The first textured draw of a frame counts as a bind; untextured draws unbind
+void FrameStats::drawWith(RenderTarget &target, const Drawable &drawable, const Texture *texture)
+{
+    target.draw(drawable);
+    drawCalls++;
+    if (texture != lastTexture)
+    {
+        if (texture)
+            textureBinds++;
+        lastTexture = texture;
+    }
+}
+
+void FrameStats::draw(RenderTarget &target, const Drawable &drawable)
+{
+    drawWith(target, drawable, nullptr);
+}
+
+void FrameStats::draw(RenderTarget &target, const Sprite &sprite)
+{
+    drawWith(target, sprite, sprite.getTexture());
+}
+
+void FrameStats::draw(RenderTarget &target, const Text &text)
+{
+    const Font *font = text.getFont();
+    drawWith(target, text, font ? &font->getTexture(text.getCharacterSize()) : nullptr);
+}
+
+void FrameStats::draw(RenderTarget &target, const TileMap &map)
+{
+    drawWith(target, map, map.getTexture());
+}
+
+// An empty batch draws nothing - no draw call, and the bound texture is left alone
+void FrameStats::draw(RenderTarget &target, const SpriteBatch &batch)
+{
+    if (batch.isEmpty())
+        return;
+    drawWith(target, batch, batch.getTexture());
+}
+
+void FrameStats::countRebuilt(int cells)
+{
+    cellsRebuilt += cells;
+}
+
+void FrameStats::endFrame(RenderTarget &target)
+{
+    float render = renderClock.getElapsedTime().asSeconds() * 1000;
+    renderMs += (render - renderMs) * SMOOTHING;
+    if (!visible)
+        return;
+
+    char line[128];
+    snprintf(line, sizeof(line), "%.2f ms/frame  %.2f ms drawing  %d draw calls  %d texture binds  %d cells rebuilt",
+             frameMs, renderMs, drawCalls, textureBinds, cellsRebuilt);
+    text.setString(line);
+    target.draw(text);
+}
@@ -2,6 +2,7 @@
 // Friend management - uses Hash Table for username search, Linked List for friends, Stack for requests
 
 #include "../header/FriendManagement.h"
+#include "../header/ScreenPacer.h"
 #include <iostream>
 
 using namespace sf;
@@ -13,14 +14,16 @@ FriendManagement::FriendManagement(RenderWindow &win, string &id)
       requestOffset(0), visibleLimit(8), currentPlayer(nullptr),
       isSearching(false), searchText(""), isFriendMenuOpen(true), selectedRequest(0)
 {
-    if (!font.loadFromFile("assets/fonts/arial.ttf"))
+    font = AssetCache::instance().font("assets/fonts/arial.ttf");
+    if (!font.isLoaded())
         cout << "Failed to load arial font\n";
 
-    if (!backgroundTexture.loadFromFile("assets/images/FriendsBackground.png"))
+    backgroundTexture = AssetCache::instance().texture("assets/images/FriendsBackground.png");
+    if (!backgroundTexture.isLoaded())
         cout << "Failed to load friends background image\n";
-    backgroundSprite.setTexture(backgroundTexture);
+    backgroundSprite.setTexture(*backgroundTexture);
 
-    currentPlayer = system.returnPlayer(playerId);
+    currentPlayer = system.returnPlayer(playerId, FIELD_PROFILE | FIELD_FRIENDS | FIELD_REQUESTS);
     if (!currentPlayer)
     {
         cout << "Error: Could not load player data\n";
@@ -88,41 +91,41 @@ void FriendManagement::initializeArrays()
 void FriendManagement::setupUI()
 {
     // Friends section title
-    friendsTitle.setFont(font);
+    friendsTitle.setFont(*font);
     friendsTitle.setString("Your Friends (" + to_string(currentPlayer->noOfFriends) + ")");
     friendsTitle.setCharacterSize(22);
     friendsTitle.setFillColor(Color::Green);
     friendsTitle.setPosition(30, 70);
 
     // Requests section title
-    requestsTitle.setFont(font);
+    requestsTitle.setFont(*font);
     requestsTitle.setString("Pending Requests (" + to_string(currentPlayer->noOfRequests) + ")");
     requestsTitle.setCharacterSize(22);
     requestsTitle.setFillColor(Color::Magenta);
     requestsTitle.setPosition(400, 70);
 
     // Search label
-    searchLabel.setFont(font);
+    searchLabel.setFont(*font);
     searchLabel.setString("Search Username to Add Friend:");
     searchLabel.setCharacterSize(18);
     searchLabel.setFillColor(Color::White);
     searchLabel.setPosition(30, 420);
 
     // Search input
-    searchInput.setFont(font);
+    searchInput.setFont(*font);
     searchInput.setCharacterSize(20);
     searchInput.setFillColor(Color::Yellow);
     searchInput.setPosition(30, 450);
     searchInput.setString("_");
 
     // Status message
-    statusMessage.setFont(font);
+    statusMessage.setFont(*font);
     statusMessage.setCharacterSize(18);
     statusMessage.setFillColor(Color::White);
     statusMessage.setPosition(30, 490);
 
     // Instructions
-    instructionsText.setFont(font);
+    instructionsText.setFont(*font);
     instructionsText.setString(
         "Controls: [TAB] Search | [A] Accept Request | [R] Reject Request | [UP/DOWN] Scroll | [ESC] Back");
     instructionsText.setCharacterSize(14);
@@ -137,7 +140,7 @@ void FriendManagement::refreshPlayerData()
     {
         delete currentPlayer;
     }
-    currentPlayer = system.returnPlayer(playerId);
+    currentPlayer = system.returnPlayer(playerId, FIELD_PROFILE | FIELD_FRIENDS | FIELD_REQUESTS);
 
     // Reinitialize arrays
     cleanup();
@@ -156,10 +159,11 @@ void FriendManagement::refreshPlayerData()
 
 void FriendManagement::run()
 {
+    ScreenPacer pacer("Friends");
     while (window.isOpen() && isFriendMenuOpen)
     {
         Event event;
-        while (window.pollEvent(event))
+        while (pacer.nextEvent(window, event))
         {
             if (event.type == Event::Closed)
             {
@@ -167,7 +171,8 @@ void FriendManagement::run()
             }
             handleInput(event);
         }
-        render();
+        if (pacer.redraw())
+            render();
     }
 }
 
@@ -333,18 +338,16 @@ void FriendManagement::sendFriendRequest()
     }
 
     // Check if request already sent (check target's pending requests)
-    Player *targetPlayer = system.returnPlayer(targetId);
-    if (targetPlayer)
+    PlayerView targetPlayer = system.viewPlayer(targetId, FIELD_PROFILE | FIELD_REQUESTS);
+    if (targetPlayer.isValid())
     {
         if (targetPlayer->friendRequest.search(playerId))
         {
             statusMessage.setString("Friend request already pending!");
             statusMessage.setFillColor(Color::Yellow);
-            delete targetPlayer;
             searchText.clear();
             return;
         }
-        delete targetPlayer;
     }
 
     // Send the friend request
@@ -382,10 +385,8 @@ void FriendManagement::acceptRequest()
     if (system.acceptFriendRequest(playerId, requesterId))
     {
         // Get requester's username for display
-        Player *requester = system.returnPlayer(requesterId);
-        string requesterName = requester ? requester->username : requesterId;
-        if (requester)
-            delete requester;
+        PlayerView requester = system.viewPlayer(requesterId, FIELD_PROFILE);
+        string requesterName = requester.isValid() ? requester->username : requesterId;
 
         statusMessage.setString("You are now friends with " + requesterName + "!");
         statusMessage.setFillColor(Color::Green);
@@ -440,7 +441,7 @@ void FriendManagement::renderFriendList()
     if (currentPlayer->noOfFriends == 0)
     {
         Text noFriends;
-        noFriends.setFont(font);
+        noFriends.setFont(*font);
         noFriends.setString("No friends yet. Add some!");
         noFriends.setCharacterSize(16);
         noFriends.setFillColor(Color(150, 150, 150));
@@ -454,12 +455,10 @@ void FriendManagement::renderFriendList()
         string friendId = friends[friendOffset + i];
 
         // Get friend's username
-        Player *friendPlayer = system.returnPlayer(friendId);
-        string displayName = friendPlayer ? friendPlayer->username : friendId;
-        if (friendPlayer)
-            delete friendPlayer;
+        PlayerView friendPlayer = system.viewPlayer(friendId, FIELD_PROFILE);
+        string displayName = friendPlayer.isValid() ? friendPlayer->username : friendId;
 
-        friendTexts[i].setFont(font);
+        friendTexts[i].setFont(*font);
         friendTexts[i].setString(to_string(friendOffset + i + 1) + ". " + displayName);
         friendTexts[i].setCharacterSize(18);
         friendTexts[i].setFillColor(Color::Green);
@@ -471,7 +470,7 @@ void FriendManagement::renderFriendList()
     if (currentPlayer->noOfFriends > visibleLimit)
     {
         Text scrollIndicator;
-        scrollIndicator.setFont(font);
+        scrollIndicator.setFont(*font);
         scrollIndicator.setString("[" + to_string(friendOffset + 1) + "-" +
                                   to_string(min(friendOffset + visibleLimit, currentPlayer->noOfFriends)) +
                                   " of " + to_string(currentPlayer->noOfFriends) + "]");
@@ -490,7 +489,7 @@ void FriendManagement::renderRequestList()
     if (currentPlayer->noOfRequests == 0)
     {
         Text noRequests;
-        noRequests.setFont(font);
+        noRequests.setFont(*font);
         noRequests.setString("No pending requests.");
         noRequests.setCharacterSize(16);
         noRequests.setFillColor(Color(150, 150, 150));
@@ -504,12 +503,10 @@ void FriendManagement::renderRequestList()
         string requesterId = requests[requestOffset + i];
 
         // Get requester's username
-        Player *requesterPlayer = system.returnPlayer(requesterId);
-        string displayName = requesterPlayer ? requesterPlayer->username : requesterId;
-        if (requesterPlayer)
-            delete requesterPlayer;
+        PlayerView requesterPlayer = system.viewPlayer(requesterId, FIELD_PROFILE);
+        string displayName = requesterPlayer.isValid() ? requesterPlayer->username : requesterId;
 
-        requestTexts[i].setFont(font);
+        requestTexts[i].setFont(*font);
         requestTexts[i].setString(to_string(requestOffset + i + 1) + ". " + displayName);
         requestTexts[i].setCharacterSize(18);
 
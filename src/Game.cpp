@@ -7,6 +7,12 @@
 #include <ctime>
 #include <cstring>
 
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
 using namespace std;
 using namespace sf;
 
@@ -69,6 +75,7 @@ GameState::GameState()
     levelNo = 1;
     bgR = bgG = bgB = 0;
     bgA = 255;
+    seed = 0;
     enemyCount = 4;
     for (int i = 0; i < 10; i++)
     {
@@ -130,7 +137,7 @@ bool GameState::serialize() const
     }
 
     // Write save data
-    file << "XONIX_SAVE_V1" << endl;
+    file << "XONIX_SAVE_V2" << endl;
     file << saveID << endl;
     file << timestamp << endl;
     file << playerID << endl;
@@ -144,6 +151,7 @@ bool GameState::serialize() const
     file << powerUpRemainingTime << endl;
     file << levelNo << endl;
     file << bgR << " " << bgG << " " << bgB << " " << bgA << endl;
+    file << seed << endl;
 
     file << enemyCount << endl;
     for (int i = 0; i < enemyCount; i++)
@@ -236,7 +244,9 @@ bool GameState::deserialize(const string &saveIDToLoad)
     // Verify file format
     string header;
     getline(file, header);
-    if (header != "XONIX_SAVE_V1")
+    // V1 is V2 without the seed line
+    bool hasSeed = header == "XONIX_SAVE_V2";
+    if (!hasSeed && header != "XONIX_SAVE_V1")
     {
         cerr << "Error: Invalid save file format!" << endl;
         file.close();
@@ -265,6 +275,9 @@ bool GameState::deserialize(const string &saveIDToLoad)
 
     file >> levelNo;
     file >> bgR >> bgG >> bgB >> bgA;
+    seed = 0;
+    if (hasSeed)
+        file >> seed;
 
     file >> enemyCount;
     for (int i = 0; i < enemyCount; i++)
@@ -301,170 +314,17 @@ bool GameState::deserialize(const string &saveIDToLoad)
     return true;
 }
 
-SinglePlayer::Enemy::Enemy()
-{
-    x = y = 300;
-    dx = 4 - rand() % 8;
-    dy = 4 - rand() % 8;
-    frozen = false;
-}
-
-void SinglePlayer::Enemy::move(int grid[M][N], int ts, bool frozen, float speedMultiplier)
-{
-    if (frozen)
-        return;
-
-    float newX = x + dx * speedMultiplier;
-    float newY = y + dy * speedMultiplier;
-
-    if (newX < 0)
-        newX = 0;
-    if (newX > (N - 1) * ts)
-        newX = (N - 1) * ts;
-    if (newY < 0)
-        newY = 0;
-    if (newY > (M - 1) * ts)
-        newY = (M - 1) * ts;
-
-    int rowOld = int(y) / ts;
-    int colNewX = int(newX) / ts;
-    if (grid[rowOld][colNewX] == 1)
-    {
-        dx = -dx;
-    }
-    else
-    {
-        x = newX;
-    }
-
-    int colOld = int(x) / ts;
-    int rowNewY = int(newY) / ts;
-    if (grid[rowNewY][colOld] == 1)
-    {
-        dy = -dy;
-    }
-    else
-    {
-        y = newY;
-    }
-}
-
 SinglePlayer::SinglePlayer()
     : playerId(""),
       lastSaveID(""),
       backgroundColor(Color::Black),
       backgroundImagePath(""),
       useBackgroundImage(false),
-      score(0),
       p(nullptr),
-      bonusCount(0),
-      powerUps(0),
-      nextPowerUpScore(50),
-      powerUpUsed(false),
-      powerUpActive(false),
-      powerUpRemainingTime(0),
-      ts(18),
-      x(0),
-      y(0),
-      dx(0),
-      dy(0),
+      ts(TILE_SIZE),
       Game(true),
-      timer(0),
-      enemyCount(4),
-      currentLevel(1),
-      delay(0.07f),
-      enemySpeed(1.0f),
-      levelNo(1)
-{
-    for (int i = 0; i < M; i++)
-        for (int j = 0; j < N; j++)
-            grid[i][j] = 0;
-}
-
-// Flood fill to mark enemy-reachable areas (these won't be captured)
-void SinglePlayer::drop(int y, int x)
-{
-    if (y < 0 || y >= M || x < 0 || x >= N)
-        return;
-    if (grid[y][x] != 0)
-        return;
-
-    grid[y][x] = -1;
-    
-    drop(y - 1, x);
-    drop(y + 1, x);
-    drop(y, x - 1);
-    drop(y, x + 1);
-}
-
-void SinglePlayer::resetGame()
-{
-    for (int i = 0; i < M; i++)
-        for (int j = 0; j < N; j++)
-            grid[i][j] = 0;
-
-    for (int i = 0; i < M; i++)
-        for (int j = 0; j < N; j++)
-            if (i == 0 || j == 0 || i == M - 1 || j == N - 1)
-                grid[i][j] = 1;
-
-    score = 0;
-    bonusCount = 0;
-
-    powerUps = 0;
-    powerUpActive = false;
-    nextPowerUpScore = 50;
-}
-
-int SinglePlayer::countCapturedTiles()
-{
-    int count = 0;
-    for (int i = 0; i < M; i++)
-    {
-        for (int j = 0; j < N; j++)
-        {
-            if (grid[i][j] == -1)
-            {
-                count++;
-            }
-        }
-    }
-    return count;
-}
-
-// Adjust difficulty based on level
-void SinglePlayer::setLevel(int levelNo)
+      recordingGame(false)
 {
-    currentLevel = levelNo;
-    switch (levelNo)
-    {
-    case 1:
-        delay = 0.07f;
-        enemySpeed = 1.0f;
-        break;
-    case 2:
-        delay = 0.06f;
-        enemySpeed = 1.2f;
-        enemyCount = 5;
-        break;
-    case 3:
-        delay = 0.05f;
-        enemySpeed = 1.5f;
-        enemyCount = 6;
-        break;
-    case 4:
-        delay = 0.04f;
-        enemySpeed = 1.8f;
-        enemyCount = 7;
-        break;
-    case 5:
-        delay = 0.03f;
-        enemySpeed = 2.0f;
-        enemyCount = 10;
-        break;
-    default:
-        break;
-    }
 }
 
 // Main game loop - returns final score or -1 if saved
@@ -472,13 +332,12 @@ int SinglePlayer::run(Color bgColor, string id, bool &madeSave, bool playingSave
                       RenderWindow &window, const string &saveIDToLoad, string &savedGameID,
                       const string &bgImagePath)
 {
-    levelNo = level;
     backgroundColor = bgColor;
     backgroundImagePath = bgImagePath;
-    srand(time(0));
-    p = system.returnPlayer(id);
-    powerUps = p->powerUps;
+    p = system.returnPlayer(id, FIELD_PROFILE);
     playerId = id;
+    startGame(level, p->powerUps);
+    Game = true;
 
     window.setSize(Vector2u(N * ts, M * ts));
     View view(FloatRect(0, 0, N * ts, M * ts));
@@ -489,18 +348,17 @@ int SinglePlayer::run(Color bgColor, string id, bool &madeSave, bool playingSave
     useBackgroundImage = false;
     if (!bgImagePath.empty())
     {
-        if (backgroundTexture.loadFromFile(bgImagePath))
+        backgroundTexture = AssetCache::instance().texture(bgImagePath, true);
+        if (backgroundTexture.isLoaded())
         {
-            // Set texture with repeated mode disabled
-            backgroundTexture.setSmooth(true);
-            backgroundSprite.setTexture(backgroundTexture, true); // resetRect = true
+            backgroundSprite.setTexture(*backgroundTexture, true); // resetRect = true
             backgroundSprite.setPosition(0, 0);
 
             // Calculate scale to fill entire game window
             float windowWidth = (float)(N * ts);
             float windowHeight = (float)(M * ts);
-            float textureWidth = (float)backgroundTexture.getSize().x;
-            float textureHeight = (float)backgroundTexture.getSize().y;
+            float textureWidth = (float)backgroundTexture->getSize().x;
+            float textureHeight = (float)backgroundTexture->getSize().y;
 
             float scaleX = windowWidth / textureWidth;
             float scaleY = windowHeight / textureHeight;
@@ -515,46 +373,28 @@ int SinglePlayer::run(Color bgColor, string id, bool &madeSave, bool playingSave
         }
     }
 
-    Texture t1, t2, t3;
-    t1.loadFromFile("assets/images/tiles.png");
-    t2.loadFromFile("assets/images/gameover.png");
-    t3.loadFromFile("assets/images/enemy.png");
-
-    Sprite sTile(t1), sGameover(t2), sEnemy(t3);
+    // Tiles, enemy and game over all come from one atlas texture
+    const TextureAtlas &atlas = TextureAtlas::sprites();
+    Sprite sTile(atlas.getTexture()), sGameover(atlas.getTexture(), atlas.rect("gameover"));
+    Sprite sEnemy(atlas.getTexture(), atlas.rect("enemy"));
     sGameover.setPosition(100, 100);
     sEnemy.setOrigin(20, 20);
 
     Clock clock;
-    Font font;
-    if (!font.loadFromFile("assets/fonts/COOPBL.ttf"))
+    AssetRef<Font> font = AssetCache::instance().font("assets/fonts/COOPBL.ttf");
+    if (!font.isLoaded())
     {
         cout << "Failed to load font\n";
     }
 
     Text scoreText;
-    scoreText.setFont(font);
+    scoreText.setFont(*font);
     scoreText.setCharacterSize(20);
     scoreText.setFillColor(Color::White);
     scoreText.setPosition(10, 5);
     scoreText.setStyle(Text::Bold);
 
-    Text bonusText;
-    bonusText.setFont(font);
-    bonusText.setCharacterSize(16);
-    bonusText.setFillColor(Color::Yellow);
-    bonusText.setPosition(10, 25);
-
-    Text powerUpText;
-    powerUpText.setFont(font);
-    powerUpText.setCharacterSize(16);
-    powerUpText.setFillColor(Color::Cyan);
-    powerUpText.setPosition(N - 2, N - 2);
-
-    // Initialize grid borders
-    for (int i = 0; i < M; i++)
-        for (int j = 0; j < N; j++)
-            if (i == 0 || j == 0 || i == M - 1 || j == N - 1)
-                grid[i][j] = 1;
+    prepareBoard(atlas, *font);
 
     // Load saved game if requested
     if (playingSave)
@@ -566,29 +406,27 @@ int SinglePlayer::run(Color bgColor, string id, bool &madeSave, bool playingSave
             {
                 cout << "Failed to load save, starting new game." << endl;
             }
+            else
+            {
+                recordingGame = false;
+            }
         }
         else
         {
             // Try legacy load
-            loadGame("");
+            if (loadGame(""))
+                recordingGame = false;
         }
     }
-    setLevel(levelNo);
+    // Frame time is banked and spent in fixed SIM_STEP ticks, so enemy speed, the player's
+    // move delay and the freeze timer come out the same at any frame rate
+    float accumulator = 0;
+    EngineInput pending;  // Input gathered this frame, handed to every tick the frame runs
     while (window.isOpen())
     {
         float time = clock.getElapsedTime().asSeconds();
         clock.restart();
-        timer += time;
-
-        if (powerUpActive)
-        {
-            powerUpRemainingTime = 3.0f - powerUpClock.getElapsedTime().asSeconds();
-            if (powerUpRemainingTime <= 0)
-            {
-                powerUpActive = false;
-                powerUpRemainingTime = 0;
-            }
-        }
+        accumulator += time < MAX_FRAME_TIME ? time : MAX_FRAME_TIME;
 
         Event e;
         while (window.pollEvent(e))
@@ -603,23 +441,13 @@ int SinglePlayer::run(Color bgColor, string id, bool &madeSave, bool playingSave
                     // ESC or P pressed - show pause menu (same as multiplayer)
                     bool shouldReset = false;
                     showPauseMenu(window, Game, madeSave, savedGameID, shouldReset);
+                    clock.restart();  // Time spent paused is not played
 
                     if (shouldReset)
                     {
-                        // Reset game - restore initial state
-                        resetGame();
-                        x = 0;
-                        y = 0;
-                        dx = 0;
-                        dy = 0;
-                        // Re-initialize enemies
-                        for (int i = 0; i < enemyCount; i++)
-                        {
-                            a[i].x = a[i].y = 300;
-                            a[i].dx = 4 - rand() % 8;
-                            a[i].dy = 4 - rand() % 8;
-                            a[i].frozen = false;
-                        }
+                        // Reset game - fresh board and enemies, score and power-ups cleared
+                        startGame(engine.state().level, 0);
+                        pending = EngineInput();
                         Game = true;
                     }
                     else if (!Game && madeSave)
@@ -630,9 +458,11 @@ int SinglePlayer::run(Color bgColor, string id, bool &madeSave, bool playingSave
                     else if (!Game)
                     {
                         // Game ended without saving
-                        p->addMatchUpdate("PC", 1, score, powerUps, levelNo);
+                        saveReplay();
+                        const EngineState &end = engine.state();
+                        p->addMatchUpdate(OPPONENT_NONE, 1, end.players[0].score, end.players[0].powerUps, end.level);
                         delete p;
-                        return score;
+                        return end.players[0].score;
                     }
                 }
                 /*
@@ -643,248 +473,304 @@ int SinglePlayer::run(Color bgColor, string id, bool &madeSave, bool playingSave
                  * - Key: SPACE
                  * Effect: Freezes all enemies for 3 seconds
                  */
-                else if (e.key.code == Keyboard::Space && Game && powerUps > 0 && !powerUpActive)
+                else if (e.key.code == Keyboard::Space && Game)
                 {
-                    powerUps--;
-                    powerUpUsed = true;
-                    powerUpClock.restart();
-                    powerUpActive = true;
-                    powerUpRemainingTime = 3.0f;
+                    pending.usePowerUp = true;
+                }
+                else if (e.key.code == Keyboard::F3)
+                {
+                    stats.toggle();
                 }
             }
         }
         if (Keyboard::isKeyPressed(Keyboard::A))
         {
-            dx = -1;
-            dy = 0;
+            pending.dx = -1;
+            pending.dy = 0;
         };
         if (Keyboard::isKeyPressed(Keyboard::D))
         {
-            dx = 1;
-            dy = 0;
+            pending.dx = 1;
+            pending.dy = 0;
         };
         if (Keyboard::isKeyPressed(Keyboard::W))
         {
-            dx = 0;
-            dy = -1;
+            pending.dx = 0;
+            pending.dy = -1;
         };
         if (Keyboard::isKeyPressed(Keyboard::S))
         {
-            dx = 0;
-            dy = 1;
+            pending.dx = 0;
+            pending.dy = 1;
         };
 
         if (!Game)
             continue;
 
-        if (timer > delay)
-        {
-            x += dx;
-            y += dy;
-
-            if (x < 0)
-                x = 0;
-            if (x > N - 1)
-                x = N - 1;
-            if (y < 0)
-                y = 0;
-            if (y > M - 1)
-                y = M - 1;
-
-            if (grid[y][x] == 2)
-                Game = false;
-            if (grid[y][x] == 0)
-                grid[y][x] = 2;
-            timer = 0;
-        }
-
-        for (int i = 0; i < enemyCount; i++)
+        int steps = 0;
+        while (accumulator >= SIM_STEP && engine.state().players[0].alive)
         {
-            if (!powerUpActive)
-            {
-                a[i].frozen = false;
-                a[i].move(grid, ts, a[i].frozen, enemySpeed);
-            }
-            else
+            // Too far behind (slow machine) - drop the backlog rather than spiral
+            if (steps++ == MAX_SIM_STEPS)
             {
-                a[i].frozen = true;
+                accumulator = 0;
+                break;
             }
+            accumulator -= SIM_STEP;
+
+            if (recordingGame)
+                recording.record(engine.state(), pending);
+            engine.step(pending);
+            pending.usePowerUp = false;  // One press, one freeze
+            sEnemy.rotate(10);
         }
-        if (grid[y][x] == 1)
+        // Held keys are sampled again next frame; a frame that ran no tick keeps its input
+        if (steps > 0)
         {
-            dx = dy = 0;
+            pending.dx = 0;
+            pending.dy = 0;
+        }
+        Game = engine.state().players[0].alive;
 
-            // Flood fill algorithm to determine enclosed areas
-            // Step 1: Mark all areas reachable by enemies with -1 (don't fill these)
-            for (int i = 0; i < enemyCount; i++)
-                drop(a[i].y / ts, a[i].x / ts);
+        // How far the next tick has come, for drawing enemies between ticks
+        float alpha = accumulator / SIM_STEP;
+        const EngineState &state = engine.state();
+        const EnginePlayer &you = state.players[0];
 
-            int captured = 0;
+        drawFrame(window, sTile, sEnemy, alpha);
 
-            // Step 2: Convert player trail (2) to walls (1), count captured tiles
-            //         Fill enclosed areas with walls but don't count them for score
-            //         Leave enemy-reachable areas (-1) as empty (0)
-            for (int i = 0; i < M; i++)
-            {
-                for (int j = 0; j < N; j++)
-                {
-                    if (grid[i][j] == -1)
-                    {
-                        // Enemy-reachable area - reset to empty
-                        grid[i][j] = 0;
-                    }
-                    else if (grid[i][j] == 2)
-                    {
-                        // Player trail becomes wall - COUNT THIS
-                        grid[i][j] = 1;
-                        captured++;
-                    }
-                    else if (grid[i][j] == 0)
-                    {
-                        // Enclosed empty area - fill with walls but DON'T count
-                        grid[i][j] = 1;
-                    }
-                }
-            }
+        scoreText.setString("Player: " + p->username + " Score: " + to_string(you.score) + "  Power-Ups: " + to_string(you.powerUps) + (you.powerUpActive ? "  [ENEMIES FROZEN]" : ""));
+        stats.draw(window, scoreText);
+        stats.endFrame(window);
+        if (!Game)
+        {
+            saveReplay();
+            p->addMatchUpdate(OPPONENT_NONE, 1, you.score, you.powerUps, state.level);
+            delete p;
+            return you.score;
+        }
 
-            /*
-             * Points System Implementation:
-             * - Each tile captured = 1 point
-             * - Capturing >10 tiles in single move = x2 points (double)
-             * - After 3 bonus occurrences: threshold reduces to 5 tiles for double
-             * - After 5 bonus occurrences: capturing >5 tiles = x4 points
-             */
-            int bonusThreshold = (bonusCount >= 3) ? 5 : 10;
-            int multiplier = 1;
-
-            if (captured > bonusThreshold)
-            {
-                // Award bonus multiplier for THIS capture
-                if (bonusCount >= 5)
-                {
-                    multiplier = 4; // x4 after 5 bonus occurrences
-                }
-                else
-                {
-                    multiplier = 2; // x2 for bonus capture
-                }
-                bonusCount++; // Increment AFTER determining multiplier
-            }
+        window.display();
+    }
 
-            score += captured * multiplier;
+    // Return final score if loop exits normally
+    return engine.state().players[0].score;
+}
 
-            /*
-             * Power-up System:
-             * - First power-up at score 50
-             * - Additional at 70, 100, 130, then every +30 points
-             * - Power-ups stack and are stored in inventory
-             */
-            while (score >= nextPowerUpScore)
-            {
-                powerUps++;
-                // Power-up thresholds: 50, 70, 100, 130, 160, 190...
-                if (nextPowerUpScore == 50)
-                {
-                    nextPowerUpScore = 70;
-                }
-                else if (nextPowerUpScore == 70)
-                {
-                    nextPowerUpScore = 100;
-                }
-                else
-                {
-                    nextPowerUpScore += 30;
-                }
-            }
-        }
+// Tile rects for the board; the font is only for the F3 overlay
+void SinglePlayer::prepareBoard(const TextureAtlas &atlas, const Font &font)
+{
+    board.create(atlas.getTexture(), M, N, ts);
+    board.setTile(1, atlas.rect("tiles", IntRect(0, 0, ts, ts)));
+    board.setTile(2, atlas.rect("tiles", IntRect(54, 0, ts, ts)));
+    board.setTile(3, atlas.rect("tiles", IntRect(72, 0, ts, ts)));
+    playerTile = atlas.rect("tiles", IntRect(36, 0, ts, ts));
+    stats.setFont(font);
+}
+
+// Board, player and enemies for the engine's current state; enemies are drawn `alpha` of the
+// way from their previous tick position to the current one
+void SinglePlayer::drawFrame(RenderWindow &window, Sprite &sTile, Sprite &sEnemy, float alpha)
+{
+    const EngineState &state = engine.state();
+    stats.beginFrame();
+
+    // Drawing - use background image if available, otherwise solid color
+    if (useBackgroundImage)
+    {
+        window.clear();
+        stats.draw(window, backgroundSprite);
+    }
+    else
+    {
+        window.clear(backgroundColor);
+    }
+
+    // The whole board in one call; blue tint for tiles when freeze power-up is active
+    stats.countRebuilt(board.update(&state.grid[0][0], state.players[0].powerUpActive ? Color(150, 150, 255, 255) : Color::White));
+    stats.draw(window, board);
 
-        for (int i = 0; i < enemyCount; i++)
-            if (grid[a[i].y / ts][a[i].x / ts] == 2)
-                Game = false;
+    // Player and enemies share the atlas with the board - one more call, no texture switch
+    spriteBatch.clear();
+    sTile.setTextureRect(playerTile);
+    sTile.setColor(Color::White);
+    sTile.setPosition(state.players[0].x * ts, state.players[0].y * ts);
+    spriteBatch.add(sTile);
 
-        // Drawing - use background image if available, otherwise solid color
-        if (useBackgroundImage)
+    for (int i = 0; i < state.enemyCount; i++)
+    {
+        const EngineEnemy &enemy = state.enemies[i];
+
+        // Blue tint for frozen enemies (visual consistency with multiplayer)
+        if (enemy.frozen)
         {
-            window.clear();
-            window.draw(backgroundSprite);
+            sEnemy.setColor(Color(100, 100, 255, 200)); // Blue tint for frozen enemies
         }
         else
         {
-            window.clear(backgroundColor);
+            sEnemy.setColor(Color(255, 255, 255, 255)); // Normal color
         }
+        sEnemy.setPosition(enemy.prevX + (enemy.x - enemy.prevX) * alpha,
+                           enemy.prevY + (enemy.y - enemy.prevY) * alpha);
+        spriteBatch.add(sEnemy);
+    }
+    stats.draw(window, spriteBatch);
 
-        for (int i = 0; i < M; i++)
-            for (int j = 0; j < N; j++)
-            {
-                if (grid[i][j] == 0)
-                    continue;
-
-                if (grid[i][j] == 1)
-                    sTile.setTextureRect(IntRect(0, 0, ts, ts));
-                if (grid[i][j] == 2)
-                    sTile.setTextureRect(IntRect(54, 0, ts, ts));
-                if (grid[i][j] == 3)
-                    sTile.setTextureRect(IntRect(72, 0, ts, ts));
-
-                // Blue tint for tiles when freeze power-up is active
-                if (powerUpActive)
-                {
-                    sTile.setColor(Color(150, 150, 255, 255)); // Blue tint for frozen effect
-                }
-                else
-                {
-                    sTile.setColor(Color::White); // Normal color
-                }
+    // Blue overlay effect when power-up (freeze) is active
+    if (state.players[0].powerUpActive)
+    {
+        RectangleShape blueEffect(Vector2f(N * ts, M * ts));
+        blueEffect.setFillColor(Color(0, 100, 255, 50)); // Semi-transparent blue overlay
+        stats.draw(window, blueEffect);
+    }
+}
 
-                sTile.setPosition(j * ts, i * ts);
-                window.draw(sTile);
-            }
+// Fresh game with a new seed; everything from here is recorded
+void SinglePlayer::startGame(int level, int powerUps)
+{
+    uint64_t seed = GameRng::freshSeed();
+    engine.newGame(level, powerUps, seed);
+    recording.begin(seed, level, powerUps);
+    recordingGame = true;
+}
+
+// data/replays is created on first use; an existing one is left alone
+static void makeReplayDirectory()
+{
+#ifdef _WIN32
+    _mkdir("data/replays");
+#else
+    mkdir("data/replays", 0755);
+#endif
+}
+
+// data/replays/playerID_YYYYMMDD_HHMMSS.xrp, next to the executable if that cannot be written
+void SinglePlayer::saveReplay()
+{
+    if (!recordingGame)
+        return;
+    recordingGame = false;
+
+    const EngineState &end = engine.state();
+    recording.finish(end.ticks, end.players[0].score);
+
+    time_t now = time(nullptr);
+    char timeStr[20];
+    strftime(timeStr, sizeof(timeStr), "%Y%m%d_%H%M%S", localtime(&now));
+    string name = playerId + "_" + timeStr + ".xrp";
+
+    makeReplayDirectory();
+    string path = "data/replays/" + name;
+    if (!recording.save(path))
+    {
+        path = name;
+        if (!recording.save(path))
+            return;
+    }
+    cout << "Replay saved: " << path << " (" << recording.getEventBytes() << " bytes)" << endl;
+}
+
+/*
+ * Method: watchReplay
+ * Description: Plays a recorded game back in the window. The replay drives the engine
+ *              tick by tick, `speed` ticks for every tick of real time.
+ *              Up/Down double or halve the speed, Escape leaves.
+ *
+ * Returns: Score reached, -1 if the replay could not be loaded
+ */
+int SinglePlayer::watchReplay(RenderWindow &window, const string &path, int speed)
+{
+    Replay replay;
+    if (!replay.load(path))
+        return -1;
+    recordingGame = false;
 
-        sTile.setTextureRect(IntRect(36, 0, ts, ts));
-        sTile.setPosition(x * ts, y * ts);
-        window.draw(sTile);
+    window.setSize(Vector2u(N * ts, M * ts));
+    View view(FloatRect(0, 0, N * ts, M * ts));
+    window.setView(view);
+    window.setFramerateLimit(60);
+    useBackgroundImage = false;
+
+    const TextureAtlas &atlas = TextureAtlas::sprites();
+    Sprite sTile(atlas.getTexture()), sEnemy(atlas.getTexture(), atlas.rect("enemy"));
+    sEnemy.setOrigin(20, 20);
 
-        sEnemy.rotate(10);
-        for (int i = 0; i < enemyCount; i++)
+    AssetRef<Font> font = AssetCache::instance().font("assets/fonts/COOPBL.ttf");
+    if (!font.isLoaded())
+    {
+        cout << "Failed to load font\n";
+    }
+    prepareBoard(atlas, *font);
+
+    Text infoText;
+    infoText.setFont(*font);
+    infoText.setCharacterSize(20);
+    infoText.setFillColor(Color::White);
+    infoText.setPosition(10, 5);
+    infoText.setStyle(Text::Bold);
+
+    ReplayPlayer player(replay);
+    player.start(engine);
+    bool playing = true;
+
+    Clock clock;
+    float accumulator = 0;
+    while (window.isOpen())
+    {
+        float time = clock.getElapsedTime().asSeconds();
+        clock.restart();
+        accumulator += (time < MAX_FRAME_TIME ? time : MAX_FRAME_TIME) * speed;
+
+        Event e;
+        while (window.pollEvent(e))
         {
-            // Blue tint for frozen enemies (visual consistency with multiplayer)
-            if (a[i].frozen)
-            {
-                sEnemy.setColor(Color(100, 100, 255, 200)); // Blue tint for frozen enemies
-            }
-            else
+            if (e.type == Event::Closed)
+                window.close();
+            if (e.type == Event::KeyPressed)
             {
-                sEnemy.setColor(Color(255, 255, 255, 255)); // Normal color
+                if (e.key.code == Keyboard::Escape)
+                    return engine.state().players[0].score;
+                if (e.key.code == Keyboard::Up && speed < MAX_REPLAY_SPEED)
+                    speed *= 2;
+                if (e.key.code == Keyboard::Down && speed > 1)
+                    speed /= 2;
+                if (e.key.code == Keyboard::F3)
+                    stats.toggle();
             }
-            sEnemy.setPosition(a[i].x, a[i].y);
-            window.draw(sEnemy);
         }
 
-        // Blue overlay effect when power-up (freeze) is active
-        if (powerUpActive)
+        int steps = 0;
+        while (playing && accumulator >= SIM_STEP)
         {
-            RectangleShape blueEffect(Vector2f(N * ts, M * ts));
-            blueEffect.setFillColor(Color(0, 100, 255, 50)); // Semi-transparent blue overlay
-            window.draw(blueEffect);
+            if (steps++ == MAX_SIM_STEPS * speed)
+            {
+                accumulator = 0;
+                break;
+            }
+            accumulator -= SIM_STEP;
+
+            playing = player.step(engine);
+            sEnemy.rotate(10);
         }
+        if (!playing)
+            accumulator = 0;
 
-        window.draw(scoreText);
-        window.draw(bonusText);
-        window.draw(powerUpText);
-        scoreText.setString("Player: " + p->username + " Score: " + to_string(score) + "  Power-Ups: " + to_string(powerUps) + (powerUpActive ? "  [ENEMIES FROZEN]" : ""));
-        window.draw(scoreText);
-        if (!Game)
+        const EngineState &state = engine.state();
+        drawFrame(window, sTile, sEnemy, speed == 1 ? accumulator / SIM_STEP : 1);
+
+        string info = "Replay x" + to_string(speed) + "  Score: " + to_string(state.players[0].score);
+        if (!playing)
         {
-            p->addMatchUpdate("PC", 1, score, powerUps, levelNo);
-            delete p;
-            return score;
+            bool matches = state.ticks == replay.getTicks() && state.players[0].score == replay.getScore();
+            info += matches ? "  [FINISHED]" : "  [DIFFERS FROM RECORDING: " + to_string(replay.getScore()) + "]";
         }
-
+        infoText.setString(info);
+        stats.draw(window, infoText);
+        stats.endFrame(window);
         window.display();
     }
 
-    // Return final score if loop exits normally
-    return score;
+    return engine.state().players[0].score;
 }
 
 /*
@@ -905,6 +791,8 @@ int SinglePlayer::run(Color bgColor, string id, bool &madeSave, bool playingSave
 string SinglePlayer::saveGame()
 {
     GameState state;
+    const EngineState &game = engine.state();
+    const EnginePlayer &you = game.players[0];
 
     // Set identification info
     strncpy(state.playerID, playerId.c_str(), sizeof(state.playerID) - 1);
@@ -913,36 +801,37 @@ string SinglePlayer::saveGame()
     state.setTimestamp();
 
     // Set game progress
-    state.score = score;
-    state.bonusCount = bonusCount;
-    state.powerUps = powerUps;
-    state.nextPowerUpScore = nextPowerUpScore;
+    state.score = you.score;
+    state.bonusCount = you.bonusCount;
+    state.powerUps = you.powerUps;
+    state.nextPowerUpScore = you.nextPowerUpScore;
 
     // Set player state
-    state.playerX = x;
-    state.playerY = y;
-    state.playerDX = dx;
-    state.playerDY = dy;
+    state.playerX = you.x;
+    state.playerY = you.y;
+    state.playerDX = you.dx;
+    state.playerDY = you.dy;
 
     // Set power-up state
-    state.powerUpActive = powerUpActive;
-    state.powerUpRemainingTime = powerUpRemainingTime;
+    state.powerUpActive = you.powerUpActive;
+    state.powerUpRemainingTime = you.powerUpRemainingTime;
 
     // Set level info
-    state.levelNo = levelNo;
+    state.levelNo = game.level;
     state.bgR = backgroundColor.r;
     state.bgG = backgroundColor.g;
     state.bgB = backgroundColor.b;
     state.bgA = backgroundColor.a;
+    state.seed = game.seed;
 
     // Set enemy data
-    state.enemyCount = enemyCount;
-    for (int i = 0; i < enemyCount; i++)
+    state.enemyCount = game.enemyCount;
+    for (int i = 0; i < game.enemyCount; i++)
     {
-        state.enemyX[i] = a[i].x;
-        state.enemyY[i] = a[i].y;
-        state.enemyDX[i] = a[i].dx;
-        state.enemyDY[i] = a[i].dy;
+        state.enemyX[i] = game.enemies[i].x;
+        state.enemyY[i] = game.enemies[i].y;
+        state.enemyDX[i] = game.enemies[i].dx;
+        state.enemyDY[i] = game.enemies[i].dy;
     }
 
     // Copy grid state
@@ -950,7 +839,7 @@ string SinglePlayer::saveGame()
     {
         for (int j = 0; j < N; j++)
         {
-            state.grid[i][j] = grid[i][j];
+            state.grid[i][j] = game.grid[i][j];
         }
     }
 
@@ -961,15 +850,15 @@ string SinglePlayer::saveGame()
         for (int j = 0; j < N; j++)
         {
             // Store tiles that are part of player's trail or modified
-            if (grid[i][j] == 2)
+            if (game.grid[i][j] == 2)
             { // Player trail
-                state.tiles.insert(i, j, grid[i][j]);
+                state.tiles.insert(i, j, game.grid[i][j]);
             }
         }
     }
 
     // Also store current player position tile
-    state.tiles.insert(y, x, grid[y][x]);
+    state.tiles.insert(you.y, you.x, game.grid[you.y][you.x]);
 
     // Serialize to file
     if (state.serialize())
@@ -1008,43 +897,45 @@ bool SinglePlayer::loadGame(const string &saveIDToLoad)
         return false;
     }
 
+    // Enemies the save does not cover keep their fresh-game values
+    EngineState game = engine.state();
+    EnginePlayer &you = game.players[0];
+
     // Restore game progress
-    score = state.score;
-    bonusCount = state.bonusCount;
-    powerUps = state.powerUps;
-    nextPowerUpScore = state.nextPowerUpScore;
+    you.score = state.score;
+    you.bonusCount = state.bonusCount;
+    you.powerUps = state.powerUps;
+    you.nextPowerUpScore = state.nextPowerUpScore;
 
     // Restore player state
-    x = state.playerX;
-    y = state.playerY;
-    dx = state.playerDX;
-    dy = state.playerDY;
+    you.x = state.playerX;
+    you.y = state.playerY;
+    you.dx = state.playerDX;
+    you.dy = state.playerDY;
 
     // Restore power-up state
-    powerUpActive = state.powerUpActive;
-    powerUpRemainingTime = state.powerUpRemainingTime;
-    if (powerUpActive)
-    {
-        powerUpClock.restart();
-    }
+    you.powerUpActive = state.powerUpActive;
+    you.powerUpRemainingTime = state.powerUpRemainingTime;
 
     // Restore level info
-    levelNo = state.levelNo;
+    game.level = state.levelNo;
     backgroundColor = Color(
         (Uint8)state.bgR,
         (Uint8)state.bgG,
         (Uint8)state.bgB,
         (Uint8)state.bgA);
+    if (state.seed != 0)
+        game.seed = state.seed;  // V1 saves keep the seed of the fresh game
 
     // Restore enemy data
-    enemyCount = state.enemyCount;
-    for (int i = 0; i < enemyCount; i++)
+    game.enemyCount = state.enemyCount;
+    for (int i = 0; i < state.enemyCount && i < MAX_ENEMIES; i++)
     {
-        a[i].x = state.enemyX[i];
-        a[i].y = state.enemyY[i];
-        a[i].dx = state.enemyDX[i];
-        a[i].dy = state.enemyDY[i];
-        a[i].frozen = false;
+        game.enemies[i].x = state.enemyX[i];
+        game.enemies[i].y = state.enemyY[i];
+        game.enemies[i].dx = state.enemyDX[i];
+        game.enemies[i].dy = state.enemyDY[i];
+        game.enemies[i].frozen = false;
     }
 
     // Restore grid state
@@ -1052,9 +943,11 @@ bool SinglePlayer::loadGame(const string &saveIDToLoad)
     {
         for (int j = 0; j < N; j++)
         {
-            grid[i][j] = state.grid[i][j];
+            game.grid[i][j] = state.grid[i][j];
         }
     }
+    engine.restore(game);
+    engine.setLevel(game.level);
 
     // The linked list of tiles is already loaded in state.tiles
     // We can use this for verification or additional processing if needed
@@ -1077,42 +970,41 @@ bool SinglePlayer::loadGameLegacy()
     if (!saveFile.is_open())
         return false;
 
-    saveFile >> score;
-    saveFile >> powerUps;
-    saveFile >> bonusCount;
+    EngineState game = engine.state();
+    EnginePlayer &you = game.players[0];
+    saveFile >> you.score;
+    saveFile >> you.powerUps;
+    saveFile >> you.bonusCount;
 
     int activeFlag;
     saveFile >> activeFlag;
-    powerUpActive = (activeFlag != 0);
-    saveFile >> powerUpRemainingTime;
-    saveFile >> nextPowerUpScore;
-
-    if (powerUpActive)
-    {
-        powerUpClock.restart();
-    }
-
-    saveFile >> x >> y;
-    saveFile >> dx >> dy;
-    saveFile >> enemyCount;
-    for (int i = 0; i < enemyCount; i++)
+    you.powerUpActive = (activeFlag != 0);
+    saveFile >> you.powerUpRemainingTime;
+    saveFile >> you.nextPowerUpScore;
+
+    saveFile >> you.x >> you.y;
+    saveFile >> you.dx >> you.dy;
+    saveFile >> game.enemyCount;
+    for (int i = 0; i < game.enemyCount && i < MAX_ENEMIES; i++)
     {
-        saveFile >> a[i].x >> a[i].y >> a[i].dx >> a[i].dy;
+        saveFile >> game.enemies[i].x >> game.enemies[i].y >> game.enemies[i].dx >> game.enemies[i].dy;
     }
 
     for (int i = 0; i < M; i++)
     {
         for (int j = 0; j < N; j++)
         {
-            saveFile >> grid[i][j];
+            saveFile >> game.grid[i][j];
         }
     }
-    saveFile >> levelNo;
+    saveFile >> game.level;
     int r, g, b, aVal;
     saveFile >> r >> g >> b >> aVal;
     backgroundColor = Color((Uint8)r, (Uint8)g, (Uint8)b, (Uint8)aVal);
 
     saveFile.close();
+    engine.restore(game);
+    engine.setLevel(game.level);
     return true;
 }
 
@@ -1129,46 +1021,45 @@ string SinglePlayer::getLastSaveID() const
  */
 void SinglePlayer::showSaveConfirmationScreen(RenderWindow &window, const string &savedID)
 {
-    Font font;
-    font.loadFromFile("assets/fonts/arial.ttf");
+    AssetRef<Font> font = AssetCache::instance().font("assets/fonts/arial.ttf");
 
     Text titleText;
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("Game Saved Successfully!");
     titleText.setCharacterSize(36);
     titleText.setFillColor(Color::Green);
     titleText.setPosition(150.f, 100.f);
 
     Text saveIDLabel;
-    saveIDLabel.setFont(font);
+    saveIDLabel.setFont(*font);
     saveIDLabel.setString("Your Save ID:");
     saveIDLabel.setCharacterSize(24);
     saveIDLabel.setFillColor(Color::White);
     saveIDLabel.setPosition(150.f, 200.f);
 
     Text saveIDText;
-    saveIDText.setFont(font);
+    saveIDText.setFont(*font);
     saveIDText.setString(savedID);
     saveIDText.setCharacterSize(22);
     saveIDText.setFillColor(Color::Yellow);
     saveIDText.setPosition(150.f, 240.f);
 
     Text instructionText;
-    instructionText.setFont(font);
+    instructionText.setFont(*font);
     instructionText.setString("View and Copy Save IDs in Settings to resume your game later!");
     instructionText.setCharacterSize(18);
     instructionText.setFillColor(Color::Cyan);
     instructionText.setPosition(100.f, 320.f);
 
     Text tipText;
-    tipText.setFont(font);
+    tipText.setFont(*font);
     tipText.setString("Tip: You can also find your saved games in Settings menu.");
     tipText.setCharacterSize(16);
     tipText.setFillColor(Color(180, 180, 180));
     tipText.setPosition(100.f, 360.f);
 
     Text promptText;
-    promptText.setFont(font);
+    promptText.setFont(*font);
     promptText.setString("Press ESC or ENTER to return to Main Menu");
     promptText.setCharacterSize(20);
     promptText.setFillColor(Color::White);
@@ -1223,12 +1114,11 @@ void SinglePlayer::showPauseMenu(RenderWindow &window, bool &Game, bool &madeSav
         "2) Save Game",
         "3) Reset Game",
         "4) End Game"};
-    Font font;
-    font.loadFromFile("assets/fonts/arial.ttf");
+    AssetRef<Font> font = AssetCache::instance().font("assets/fonts/arial.ttf");
 
     // Title
     Text titleText;
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("PAUSED");
     titleText.setCharacterSize(40);
     titleText.setFillColor(Color::Cyan);
@@ -1237,7 +1127,7 @@ void SinglePlayer::showPauseMenu(RenderWindow &window, bool &Game, bool &madeSav
     Text texts[optionCount];
     for (int i = 0; i < optionCount; ++i)
     {
-        texts[i].setFont(font);
+        texts[i].setFont(*font);
         texts[i].setString(labels[i]);
         texts[i].setCharacterSize(30);
         texts[i].setFillColor(i == 0 ? Color::Yellow : Color::White);
@@ -0,0 +1,69 @@
+// Xonix Game
+// Seedable per-game random numbers (xoshiro128**)
+
+#include "../header/GameRng.h"
+#include <atomic>
+#include <chrono>
+
+static uint64_t splitmix64(uint64_t &x)
+{
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static uint32_t rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+GameRng::GameRng(uint64_t value)
+{
+    seed(value);
+}
+
+void GameRng::seed(uint64_t value)
+{
+    seedValue = value;
+    uint64_t x = value;
+    uint64_t a = splitmix64(x), b = splitmix64(x);
+    s[0] = (uint32_t)a;
+    s[1] = (uint32_t)(a >> 32);
+    s[2] = (uint32_t)b;
+    s[3] = (uint32_t)(b >> 32);
+}
+
+uint64_t GameRng::getSeed() const
+{
+    return seedValue;
+}
+
+uint32_t GameRng::next()
+{
+    uint32_t result = rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+
+    return result;
+}
+
+// Multiply-shift instead of %, so small ranges take the high (best mixed) bits
+int GameRng::below(int n)
+{
+    return (int)(((uint64_t)next() * (uint32_t)n) >> 32);
+}
+
+uint64_t GameRng::freshSeed()
+{
+    static std::atomic<uint64_t> counter(0);
+    uint64_t x = (uint64_t)std::chrono::system_clock::now().time_since_epoch().count() + counter.fetch_add(1);
+    uint64_t value = splitmix64(x);
+    return value != 0 ? value : 1;
+}
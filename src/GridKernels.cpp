@@ -0,0 +1,213 @@
+// Xonix Game
+// Grid kernels - scalar reference plus AVX2 / NEON versions; vector loops finish with the scalar tail
+
+#include "../header/GridKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GRID_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define GRID_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Scalar reference
+
+static int rewriteCaptureScalar(int *cells, int count, int trailValue)
+{
+    int captured = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int v = cells[i];
+        int isTrail = v == trailValue;
+        captured += isTrail;
+        cells[i] = v == -1 ? 0 : ((isTrail || v == 0) ? 1 : v);
+    }
+    return captured;
+}
+
+static int countValueScalar(const int *cells, int count, int value)
+{
+    int n = 0;
+    for (int i = 0; i < count; i++)
+        n += cells[i] == value;
+    return n;
+}
+
+static void packRowScalar(const int *line, int cols, int trailValue, uint64_t *wall, uint64_t *trail, uint64_t *empty)
+{
+    uint64_t w = 0, t = 0, e = 0;
+    for (int c = 0; c < cols; c++)
+    {
+        w |= (uint64_t)(line[c] == 1) << c;
+        t |= (uint64_t)(line[c] == trailValue) << c;
+        e |= (uint64_t)(line[c] == 0) << c;
+    }
+    *wall = w;
+    *trail = t;
+    *empty = e;
+}
+
+#ifdef GRID_KERNELS_X86
+
+// 8 cells per step; compare masks pick the new value, movemask feeds popcount
+
+__attribute__((target("avx2"))) static int rewriteCaptureAvx2(int *cells, int count, int trailValue)
+{
+    const __m256i minusOne = _mm256_set1_epi32(-1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i trailV = _mm256_set1_epi32(trailValue);
+
+    int captured = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(cells + i));
+        __m256i isReach = _mm256_cmpeq_epi32(v, minusOne);
+        __m256i isTrail = _mm256_cmpeq_epi32(v, trailV);
+        __m256i toWall = _mm256_or_si256(isTrail, _mm256_cmpeq_epi32(v, zero));
+
+        v = _mm256_andnot_si256(isReach, v);
+        v = _mm256_blendv_epi8(v, one, toWall);
+        _mm256_storeu_si256((__m256i *)(cells + i), v);
+        captured += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(isTrail)));
+    }
+    return captured + rewriteCaptureScalar(cells + i, count - i, trailValue);
+}
+
+__attribute__((target("avx2"))) static int countValueAvx2(const int *cells, int count, int value)
+{
+    const __m256i target = _mm256_set1_epi32(value);
+    __m256i matches = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(cells + i));
+        matches = _mm256_sub_epi32(matches, _mm256_cmpeq_epi32(v, target));  // -1 per match
+    }
+
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, matches);
+    int n = 0;
+    for (int k = 0; k < 8; k++)
+        n += lanes[k];
+    return n + countValueScalar(cells + i, count - i, value);
+}
+
+__attribute__((target("avx2"))) static void packRowAvx2(const int *line, int cols, int trailValue, uint64_t *wall, uint64_t *trail, uint64_t *empty)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i trailV = _mm256_set1_epi32(trailValue);
+
+    uint64_t w = 0, t = 0, e = 0;
+    int c = 0;
+    for (; c + 8 <= cols; c += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(line + c));
+        w |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, one))) << c;
+        t |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, trailV))) << c;
+        e |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, zero))) << c;
+    }
+
+    uint64_t tw, tt, te;
+    packRowScalar(line + c, cols - c, trailValue, &tw, &tt, &te);
+    *wall = w | (c < 64 ? tw << c : 0);
+    *trail = t | (c < 64 ? tt << c : 0);
+    *empty = e | (c < 64 ? te << c : 0);
+}
+
+#endif
+
+#ifdef GRID_KERNELS_NEON
+
+// 4 cells per step; NEON is always present on ARM64, so no runtime check
+
+static int rewriteCaptureNeon(int *cells, int count, int trailValue)
+{
+    const int32x4_t minusOne = vdupq_n_s32(-1);
+    const int32x4_t zero = vdupq_n_s32(0);
+    const int32x4_t one = vdupq_n_s32(1);
+    const int32x4_t trailV = vdupq_n_s32(trailValue);
+
+    int32x4_t trailCount = vdupq_n_s32(0);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        int32x4_t v = vld1q_s32(cells + i);
+        uint32x4_t isReach = vceqq_s32(v, minusOne);
+        uint32x4_t isTrail = vceqq_s32(v, trailV);
+        uint32x4_t toWall = vorrq_u32(isTrail, vceqq_s32(v, zero));
+
+        v = vbslq_s32(isReach, zero, v);
+        v = vbslq_s32(toWall, one, v);
+        vst1q_s32(cells + i, v);
+        trailCount = vsubq_s32(trailCount, vreinterpretq_s32_u32(isTrail));
+    }
+    return vaddvq_s32(trailCount) + rewriteCaptureScalar(cells + i, count - i, trailValue);
+}
+
+static int countValueNeon(const int *cells, int count, int value)
+{
+    const int32x4_t target = vdupq_n_s32(value);
+    int32x4_t matches = vdupq_n_s32(0);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        matches = vsubq_s32(matches, vreinterpretq_s32_u32(vceqq_s32(vld1q_s32(cells + i), target)));
+    return vaddvq_s32(matches) + countValueScalar(cells + i, count - i, value);
+}
+
+static void packRowNeon(const int *line, int cols, int trailValue, uint64_t *wall, uint64_t *trail, uint64_t *empty)
+{
+    static const uint32_t laneBits[4] = {1, 2, 4, 8};
+    const uint32x4_t bits = vld1q_u32(laneBits);
+    const int32x4_t one = vdupq_n_s32(1);
+    const int32x4_t zero = vdupq_n_s32(0);
+    const int32x4_t trailV = vdupq_n_s32(trailValue);
+
+    uint64_t w = 0, t = 0, e = 0;
+    int c = 0;
+    for (; c + 4 <= cols; c += 4)
+    {
+        int32x4_t v = vld1q_s32(line + c);
+        w |= (uint64_t)vaddvq_u32(vandq_u32(vceqq_s32(v, one), bits)) << c;
+        t |= (uint64_t)vaddvq_u32(vandq_u32(vceqq_s32(v, trailV), bits)) << c;
+        e |= (uint64_t)vaddvq_u32(vandq_u32(vceqq_s32(v, zero), bits)) << c;
+    }
+
+    uint64_t tw, tt, te;
+    packRowScalar(line + c, cols - c, trailValue, &tw, &tt, &te);
+    *wall = w | (c < 64 ? tw << c : 0);
+    *trail = t | (c < 64 ? tt << c : 0);
+    *empty = e | (c < 64 ? te << c : 0);
+}
+
+#endif
+
+static const GridKernels SCALAR = {"scalar", rewriteCaptureScalar, countValueScalar, packRowScalar};
+
+static const GridKernels &detect()
+{
+#if defined(GRID_KERNELS_X86)
+    static const GridKernels AVX2 = {"avx2", rewriteCaptureAvx2, countValueAvx2, packRowAvx2};
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return AVX2;
+#elif defined(GRID_KERNELS_NEON)
+    static const GridKernels NEON = {"neon", rewriteCaptureNeon, countValueNeon, packRowNeon};
+    return NEON;
+#endif
+    return SCALAR;
+}
+
+const GridKernels &gridKernels()
+{
+    static const GridKernels &best = detect();
+    return best;
+}
+
+const GridKernels &scalarGridKernels()
+{
+    return SCALAR;
+}
@@ -3,23 +3,25 @@
 
 #include "../data_structures/HashTable.h"
 #include <iostream>
+#include <utility>
+
+HashNode::HashNode() : arrayIndex(-1), hash(0), distance(-1) {}
 
 HashNode::HashNode(const std::string &user, const std::string &id, int idx)
-    : username(user), playerId(id), arrayIndex(idx), next(nullptr) {}
+    : username(user), playerId(id), arrayIndex(idx), hash(0), distance(-1) {}
 
-HashTable::HashTable() : count(0)
+HashTable::HashTable() : capacity(INITIAL_CAPACITY), count(0)
 {
-    for (int i = 0; i < TABLE_SIZE; i++)
-        table[i] = nullptr;
+    table = new HashNode[capacity];
 }
 
 HashTable::~HashTable()
 {
-    clear();
+    delete[] table;
 }
 
-// Polynomial rolling hash for good distribution
-int HashTable::hashFunction(const std::string &username) const
+// Polynomial rolling hash, finished with a multiplicative mix so the low bits used by the mask are spread
+unsigned int HashTable::hashFunction(const std::string &username) const
 {
     unsigned long hash = 0;
     const int prime = 31;
@@ -27,48 +29,84 @@ int HashTable::hashFunction(const std::string &username) const
     for (int i = 0; i < (int)username.length(); i++)
         hash = hash * prime + username[i];
 
-    return hash % TABLE_SIZE;
+    return (unsigned int)((hash * 0x9E3779B97F4A7C15ull) >> 32);
 }
 
-void HashTable::insert(const std::string &username, const std::string &playerId, int arrayIndex)
+// Slot holding username, or -1. Stops early once the probed entry is closer to home than we would be
+int HashTable::findSlot(const std::string &username, unsigned int hash) const
 {
-    int index = hashFunction(username);
+    int mask = capacity - 1;
+    int index = hash & mask;
 
-    // Update if username exists
-    HashNode *current = table[index];
-    while (current)
+    for (int distance = 0;; distance++)
     {
-        if (current->username == username)
-        {
-            current->playerId = playerId;
-            current->arrayIndex = arrayIndex;
-            return;
-        }
-        current = current->next;
+        const HashNode &slot = table[index];
+        if (slot.distance < distance)
+            return -1;
+        if (slot.hash == hash && slot.username == username)
+            return index;
+        index = (index + 1) & mask;
     }
+}
 
-    // Insert at front of chain
-    HashNode *newNode = new HashNode(username, playerId, arrayIndex);
-    newNode->next = table[index];
-    table[index] = newNode;
-    count++;
+// Robin Hood insert - a richer entry (shorter probe distance) gives its slot to a poorer one
+void HashTable::place(HashNode &entry)
+{
+    int mask = capacity - 1;
+    int index = entry.hash & mask;
+    entry.distance = 0;
+
+    while (table[index].distance >= 0)
+    {
+        if (table[index].distance < entry.distance)
+            std::swap(table[index], entry);
+        index = (index + 1) & mask;
+        entry.distance++;
+    }
+    table[index] = std::move(entry);
 }
 
-HashNode *HashTable::search(const std::string &username) const
+void HashTable::grow()
 {
-    int index = hashFunction(username);
+    HashNode *old = table;
+    int oldCapacity = capacity;
 
-    HashNode *current = table[index];
-    while (current)
+    capacity *= 2;
+    table = new HashNode[capacity];
+    for (int i = 0; i < oldCapacity; i++)
     {
-        if (current->username == username)
-        {
-            return current;
-        }
-        current = current->next;
+        if (old[i].distance >= 0)
+            place(old[i]);
     }
+    delete[] old;
+}
 
-    return nullptr;
+void HashTable::insert(const std::string &username, const std::string &playerId, int arrayIndex)
+{
+    unsigned int hash = hashFunction(username);
+
+    // Update if username exists
+    int index = findSlot(username, hash);
+    if (index >= 0)
+    {
+        table[index].playerId = playerId;
+        table[index].arrayIndex = arrayIndex;
+        return;
+    }
+
+    if ((count + 1) * 8 > capacity * 7)
+        grow();
+
+    HashNode entry(username, playerId, arrayIndex);
+    entry.hash = hash;
+    place(entry);
+    count++;
+}
+
+HashNode *HashTable::search(const std::string &username) const
+{
+    int index = findSlot(username, hashFunction(username));
+    return index >= 0 ? &table[index] : nullptr;
 }
 
 std::string HashTable::getPlayerId(const std::string &username) const
@@ -88,43 +126,32 @@ bool HashTable::exists(const std::string &username) const
     return search(username) != nullptr;
 }
 
+// Backward-shift delete - no tombstones, so lookups never slow down after removals
 bool HashTable::remove(const std::string &username)
 {
-    int index = hashFunction(username);
-    HashNode *current = table[index];
-    HashNode *prev = nullptr;
+    int index = findSlot(username, hashFunction(username));
+    if (index < 0)
+        return false;
 
-    while (current)
+    int mask = capacity - 1;
+    int next = (index + 1) & mask;
+    while (table[next].distance > 0)
     {
-        if (current->username == username)
-        {
-            if (prev)
-                prev->next = current->next;
-            else
-                table[index] = current->next;
-            delete current;
-            count--;
-            return true;
-        }
-        prev = current;
-        current = current->next;
+        table[index] = std::move(table[next]);
+        table[index].distance--;
+        index = next;
+        next = (next + 1) & mask;
     }
-    return false;
+    table[index] = HashNode();
+    count--;
+    return true;
 }
 
 void HashTable::clear()
 {
-    for (int i = 0; i < TABLE_SIZE; i++)
-    {
-        HashNode *current = table[i];
-        while (current)
-        {
-            HashNode *next = current->next;
-            delete current;
-            current = next;
-        }
-        table[i] = nullptr;
-    }
+    delete[] table;
+    capacity = INITIAL_CAPACITY;
+    table = new HashNode[capacity];
     count = 0;
 }
 
@@ -133,24 +160,22 @@ int HashTable::getCount() const
     return count;
 }
 
+int HashTable::getCapacity() const
+{
+    return capacity;
+}
+
 void HashTable::display() const
 {
     std::cout << "\n===== Hash Table Contents =====\n";
-    for (int i = 0; i < TABLE_SIZE; i++)
+    for (int i = 0; i < capacity; i++)
     {
-        if (table[i])
+        if (table[i].distance >= 0)
         {
-            std::cout << "Bucket " << i << ": ";
-            HashNode *current = table[i];
-            while (current)
-            {
-                std::cout << "[" << current->username << " -> ID:" << current->playerId
-                          << ", Idx:" << current->arrayIndex << "] ";
-                current = current->next;
-            }
-            std::cout << std::endl;
+            std::cout << "Slot " << i << ": [" << table[i].username << " -> ID:" << table[i].playerId
+                      << ", Idx:" << table[i].arrayIndex << ", Probe:" << table[i].distance << "]\n";
         }
     }
-    std::cout << "Total entries: " << count << std::endl;
+    std::cout << "Total entries: " << count << " / " << capacity << " slots" << std::endl;
     std::cout << "================================\n";
 }
@@ -2,8 +2,10 @@
 // Theme Inventory - AVL Tree for balanced O(log n) theme lookups
 
 #include "../header/Inventory.h"
+#include "../header/PlayerCache.h"
+#include "../header/PlayerStore.h"
+#include "../header/PlayerLog.h"
 #include <iostream>
-#include <fstream>
 
 using namespace std;
 using namespace sf;
@@ -198,6 +200,16 @@ string ThemeInventory::getThemeImagePath(int id)
     return "";
 }
 
+string ThemeInventory::getThemeMusicPath(int id)
+{
+    AVLNode *result = search(root, id);
+    if (result)
+    {
+        return "assets/Sounds/" + result->name + ".ogg";
+    }
+    return "";
+}
+
 void ThemeInventory::browseThemes()
 {
     cout << "Available Themes: " << endl;
@@ -250,163 +262,40 @@ Color ThemeInventory::getBackgroundColor(const string &color)
 
 bool ThemeInventory::savePlayerThemePreference(const string &playerID, int themeID)
 {
-    string filename = "data/" + playerID + ".txt";
-
-    // First, read all existing data from the file
-    ifstream inFile(filename);
-    if (!inFile.is_open())
-    {
-        return false;
-    }
-
-    // Read basic player information
-    string username, password, regTime;
-    int highScore, highScoreLevel, powerUps;
-
-    getline(inFile, username);
-    getline(inFile, password);
-    getline(inFile, regTime);
-    inFile >> highScore;
-    inFile >> highScoreLevel;
-    inFile >> powerUps;
-
-    // Read friends list
-    int noOfFriends;
-    inFile >> noOfFriends;
-    inFile.ignore();
-    string *friends = new string[noOfFriends > 0 ? noOfFriends : 1];
-    for (int i = 0; i < noOfFriends; i++)
+    // Theme is a fixed field in the player database - update it in place
+    PlayerStore &store = PlayerStore::instance();
+    if (store.isOpen())
     {
-        getline(inFile, friends[i]);
+        if (!store.setPreferredTheme(playerID, themeID))
+            return false;
+        PlayerCache::instance().invalidate(playerID);
+        return true;
     }
 
-    // Read match history
-    int noOfMatches;
-    inFile >> noOfMatches;
-    inFile.ignore();
-    string *matches = new string[noOfMatches > 0 ? noOfMatches : 1];
-    for (int i = 0; i < noOfMatches; i++)
-    {
-        getline(inFile, matches[i]);
-    }
-
-    // Read friend requests
-    int noOfRequests;
-    inFile >> noOfRequests;
-    inFile.ignore();
-    string *requests = new string[noOfRequests > 0 ? noOfRequests : 1];
-    for (int i = 0; i < noOfRequests; i++)
-    {
-        getline(inFile, requests[i]);
-    }
-
-    inFile.close();
-
-    // Now rewrite the file with the updated theme
-    ofstream outFile(filename);
-    if (!outFile.is_open())
-    {
-        delete[] friends;
-        delete[] matches;
-        delete[] requests;
+    // Legacy text profile - the change goes through the mutation log, no file rewrite
+    Player p;
+    p.ID = playerID;
+    if (!p.loadFromTextFile("data/" + playerID + ".txt"))
         return false;
-    }
-
-    outFile << username << endl;
-    outFile << password << endl;
-    outFile << regTime << endl;
-    outFile << highScore << endl;
-    outFile << highScoreLevel << endl;
-    outFile << powerUps << endl;
-
-    outFile << noOfFriends << endl;
-    for (int i = 0; i < noOfFriends; i++)
-    {
-        outFile << friends[i] << endl;
-    }
-
-    outFile << noOfMatches << endl;
-    for (int i = 0; i < noOfMatches; i++)
-    {
-        outFile << matches[i] << endl;
-    }
-
-    outFile << noOfRequests << endl;
-    for (int i = 0; i < noOfRequests; i++)
-    {
-        outFile << requests[i] << endl;
-    }
-
-    // Write the new theme preference
-    outFile << themeID << endl;
-
-    outFile.close();
-
-    delete[] friends;
-    delete[] matches;
-    delete[] requests;
-
+    PlayerLog::instance().apply(p);
+    p.setPreferredTheme(themeID);
     return true;
 }
 
 int ThemeInventory::loadPlayerThemePreference(const string &playerID)
 {
-    string filename = "data/" + playerID + ".txt";
-    ifstream file(filename);
-    if (!file.is_open())
-    {
-        return 1; // Default to Forest theme
-    }
-
-    // Read basic player information to skip to the theme
-    string temp;
-    int intTemp;
-
-    getline(file, temp); // username
-    getline(file, temp); // password
-    getline(file, temp); // regTime
-    file >> intTemp;     // highScore
-    file >> intTemp;     // highScoreLevel
-    file >> intTemp;     // powerUps
-
-    // Read friends list count and skip friends
-    int noOfFriends;
-    file >> noOfFriends;
-    file.ignore();
-    for (int i = 0; i < noOfFriends; i++)
-    {
-        getline(file, temp);
-    }
-
-    // Read match history count and skip matches
-    int noOfMatches;
-    file >> noOfMatches;
-    file.ignore();
-    for (int i = 0; i < noOfMatches; i++)
+    PlayerStore &store = PlayerStore::instance();
+    if (store.isOpen())
     {
-        getline(file, temp);
+        int themeID = store.getPreferredTheme(playerID);
+        return (themeID >= 1 && themeID <= size) ? themeID : 1;
     }
 
-    // Read friend requests count and skip requests
-    int noOfRequests;
-    file >> noOfRequests;
-    file.ignore();
-    for (int i = 0; i < noOfRequests; i++)
-    {
-        getline(file, temp);
-    }
-
-    // Read the theme preference
-    int themeID = 1; // Default value
-    if (file >> themeID)
-    {
-        if (themeID >= 1 && themeID <= size)
-        {
-            file.close();
-            return themeID;
-        }
-    }
+    Player p;
+    p.ID = playerID;
+    if (!p.loadFromTextFile("data/" + playerID + ".txt"))
+        return 1; // Default to Forest theme
+    PlayerLog::instance().apply(p);
 
-    file.close();
-    return 1; // Default to Forest theme
+    return (p.preferredTheme >= 1 && p.preferredTheme <= size) ? p.preferredTheme : 1;
 }
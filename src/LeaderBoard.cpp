@@ -91,18 +91,14 @@ void Leaderboard::rebuildHeap()
 
 int Leaderboard::getHighScore(const string &id)
 {
-    Player *p = system->returnPlayer(id);
-    int score = p ? p->highScore : 0;
-    delete p;
-    return score;
+    PlayerView p = system->viewPlayer(id, FIELD_PROFILE);
+    return p.isValid() ? p->highScore : 0;
 }
 
 int Leaderboard::getHighScoreLevel(const string &id)
 {
-    Player *p = system->returnPlayer(id);
-    int level = p ? p->highScoreLevel : 1;
-    delete p;
-    return level;
+    PlayerView p = system->viewPlayer(id, FIELD_PROFILE);
+    return p.isValid() ? p->highScoreLevel : 1;
 }
 
 string Leaderboard::getLevelName(int level)
@@ -148,16 +144,12 @@ void Leaderboard::makeLeaderboard()
 
     for (int i = 0; i < system->noOfPlayers; ++i)
     {
-        Player *p = system->returnPlayer(system->ArrayOfPlayers[i]);
-        if (!p || p->highScore == 0)
-        {
-            if (p) delete p;
+        PlayerView p = system->viewPlayer(system->ArrayOfPlayers[i], FIELD_PROFILE);
+        if (!p.isValid() || p->highScore == 0)
             continue;
-        }
 
         string id = p->ID;
         int playerScore = p->highScore;
-        delete p;
 
         // Skip duplicates
         if (findPlayerIndex(id) != -1)
@@ -218,13 +210,12 @@ void Leaderboard::displayLeaderboard()
 
     for (int i = 0; i < size; ++i)
     {
-        Player *p = system->returnPlayer(sorted[i]);
-        if (p)
+        PlayerView p = system->viewPlayer(sorted[i], FIELD_PROFILE);
+        if (p.isValid())
         {
             cout << (i + 1) << ".   | " << p->ID << "         | "
                  << p->username << " | " << p->highScore
                  << " | " << getLevelName(p->highScoreLevel) << endl;
-            delete p;
         }
     }
 
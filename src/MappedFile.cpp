@@ -0,0 +1,232 @@
+// Xonix Game
+// Memory-mapped file wrapper - one code path per platform
+
+#include "../header/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : data(nullptr), size(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {}
+
+bool MappedFile::open(const string &path, bool create)
+{
+    close();
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                             create ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(fileHandle, &fileSize);
+    size = (uint64_t)fileSize.QuadPart;
+    return size == 0 || map();
+}
+
+bool MappedFile::map()
+{
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE,
+                                       (DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFF), nullptr);
+    if (!mappingHandle)
+        return false;
+    data = (char *)MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T)size);
+    return data != nullptr;
+}
+
+void MappedFile::unmap()
+{
+    if (data)
+        UnmapViewOfFile(data);
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+    data = nullptr;
+    mappingHandle = nullptr;
+}
+
+bool MappedFile::resize(uint64_t newSize)
+{
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+    unmap();
+
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)newSize;
+    if (!SetFilePointerEx(fileHandle, pos, nullptr, FILE_BEGIN) || !SetEndOfFile(fileHandle))
+        return false;
+    size = newSize;
+    return size == 0 || map();
+}
+
+void MappedFile::flush()
+{
+    if (data)
+        FlushViewOfFile(data, (SIZE_T)size);
+}
+
+void MappedFile::sync()
+{
+    if (data)
+        FlushViewOfFile(data, (SIZE_T)size);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+        FlushFileBuffers(fileHandle);
+}
+
+void MappedFile::close()
+{
+    flush();
+    unmap();
+    if (fileHandle != INVALID_HANDLE_VALUE)
+        CloseHandle(fileHandle);
+    fileHandle = INVALID_HANDLE_VALUE;
+    size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return fileHandle != INVALID_HANDLE_VALUE;
+}
+
+bool MappedFile::syncPath(const string &path)
+{
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    bool ok = FlushFileBuffers(handle) != 0;
+    CloseHandle(handle);
+    return ok;
+}
+
+bool MappedFile::replaceFile(const string &tmpPath, const string &path)
+{
+    if (!syncPath(tmpPath))
+        return false;
+    return MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else
+
+MappedFile::MappedFile() : data(nullptr), size(0), fd(-1) {}
+
+bool MappedFile::open(const string &path, bool create)
+{
+    close();
+    fd = ::open(path.c_str(), O_RDWR | (create ? O_CREAT : 0), 0644);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close();
+        return false;
+    }
+    size = (uint64_t)st.st_size;
+    return size == 0 || map();
+}
+
+bool MappedFile::map()
+{
+    void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+    {
+        data = nullptr;
+        return false;
+    }
+    data = (char *)p;
+    return true;
+}
+
+void MappedFile::unmap()
+{
+    if (data)
+        munmap(data, size);
+    data = nullptr;
+}
+
+bool MappedFile::resize(uint64_t newSize)
+{
+    if (fd < 0)
+        return false;
+    unmap();
+    if (ftruncate(fd, (off_t)newSize) != 0)
+        return false;
+    size = newSize;
+    return size == 0 || map();
+}
+
+void MappedFile::flush()
+{
+    if (data)
+        msync(data, size, MS_ASYNC);
+}
+
+void MappedFile::sync()
+{
+    if (data)
+        msync(data, size, MS_SYNC);
+    if (fd >= 0)
+        fsync(fd);  // The size too, after a resize
+}
+
+void MappedFile::close()
+{
+    flush();
+    unmap();
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
+    size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+    return fd >= 0;
+}
+
+bool MappedFile::syncPath(const string &path)
+{
+    int handle = ::open(path.c_str(), O_RDONLY);
+    if (handle < 0)
+        return false;
+    bool ok = fsync(handle) == 0;
+    ::close(handle);
+    return ok;
+}
+
+// rename() swaps the files in one step - a crash leaves the old file or the new one, never
+// neither - and the directory is synced so the swap itself survives a power cut
+bool MappedFile::replaceFile(const string &tmpPath, const string &path)
+{
+    if (!syncPath(tmpPath) || rename(tmpPath.c_str(), path.c_str()) != 0)
+        return false;
+    size_t slash = path.find_last_of('/');
+    return syncPath(slash == string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash));
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+char *MappedFile::bytes() const
+{
+    return data;
+}
+
+uint64_t MappedFile::getSize() const
+{
+    return size;
+}
@@ -0,0 +1,500 @@
+// Xonix Game
+// Match history - [header + stats][MatchRecord...] oldest first, so appends never move data
+// Per-opponent and per-level queries follow back-links stored in the records themselves
+
+#include "../header/MatchHistory.h"
+#include "../header/UsernameIndex.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+
+using namespace std;
+
+static const char HISTORY_MAGIC[8] = {'X', 'N', 'X', 'M', 'T', 'C', 'H', '1'};
+static const uint32_t HISTORY_VERSION = 1;
+static const char OPPONENTS_MAGIC[8] = {'X', 'N', 'X', 'O', 'P', 'P', 'S', '1'};
+static const uint32_t OPPONENTS_MIN_CAPACITY = 16;
+
+struct HistoryHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    MatchStats stats;
+    int64_t lastTimestamp;
+    int32_t levelHead[MATCH_LEVELS];  // Newest record at each level, -1 = none
+};
+
+// data/<id>.opponents - [OpponentTable][OpponentSummary x capacity], open addressing on the
+// opponent id. A slot without games is empty; every stored opponent has played at least one
+struct OpponentTable
+{
+    char magic[8];
+    uint32_t capacity;  // Power of two
+    uint32_t count;
+};
+
+double MatchStats::winRate() const
+{
+    uint32_t played = wins + losses;
+    return played > 0 ? (double)wins / played : 0.0;
+}
+
+double MatchStats::averageScore() const
+{
+    return count > 0 ? (double)totalScore / count : 0.0;
+}
+
+static int levelSlot(int level)
+{
+    if (level < 0)
+        return 0;
+    return level < MATCH_LEVELS ? level : MATCH_LEVELS - 1;
+}
+
+static bool readHeader(const string &path, HistoryHeader &h)
+{
+    ifstream in(path, ios::binary);
+    return in.is_open() && in.read((char *)&h, sizeof(h)) &&
+           memcmp(h.magic, HISTORY_MAGIC, 8) == 0 && h.version == HISTORY_VERSION &&
+           h.recordSize == sizeof(MatchRecord);
+}
+
+static uint32_t opponentHash(int32_t opponentId)
+{
+    uint32_t hash = (uint32_t)opponentId * 2654435761u;
+    return hash ^ (hash >> 16);
+}
+
+static streamoff opponentSlotAt(uint32_t slot)
+{
+    return sizeof(OpponentTable) + (streamoff)slot * sizeof(OpponentSummary);
+}
+
+static bool readTable(istream &in, OpponentTable &t)
+{
+    in.seekg(0);
+    return in.read((char *)&t, sizeof(t)) && memcmp(t.magic, OPPONENTS_MAGIC, 8) == 0 &&
+           t.capacity >= OPPONENTS_MIN_CAPACITY && (t.capacity & (t.capacity - 1)) == 0;
+}
+
+// Slot holding the opponent, or the empty slot it would take (found is false then); -1 on error
+static int probeOpponent(istream &in, const OpponentTable &t, int32_t opponentId, OpponentSummary &out, bool &found)
+{
+    uint32_t mask = t.capacity - 1;
+    uint32_t slot = opponentHash(opponentId) & mask;
+    OpponentSummary s;
+    for (uint32_t probes = 0; probes < t.capacity; probes++, slot = (slot + 1) & mask)
+    {
+        in.seekg(opponentSlotAt(slot));
+        if (!in.read((char *)&s, sizeof(s)))
+            return -1;
+        if (s.games == 0 || s.opponentId == opponentId)
+        {
+            found = s.games > 0;
+            if (found)
+                out = s;
+            return (int)slot;
+        }
+    }
+    return -1;
+}
+
+// Write a table holding the given entries (or none), replacing any file at path
+static bool writeTable(const string &path, uint32_t capacity, const OpponentSummary *entries, uint32_t count)
+{
+    OpponentSummary *slots = new OpponentSummary[capacity];
+    memset(slots, 0, (size_t)capacity * sizeof(OpponentSummary));
+    uint32_t mask = capacity - 1;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t slot = opponentHash(entries[i].opponentId) & mask;
+        while (slots[slot].games > 0)
+            slot = (slot + 1) & mask;
+        slots[slot] = entries[i];
+    }
+
+    OpponentTable t;
+    memcpy(t.magic, OPPONENTS_MAGIC, 8);
+    t.capacity = capacity;
+    t.count = count;
+    ofstream out(path, ios::binary | ios::trunc);
+    out.write((const char *)&t, sizeof(t));
+    out.write((const char *)slots, (streamsize)capacity * sizeof(OpponentSummary));
+    delete[] slots;
+    return out.good();
+}
+
+// Double the slots once the table is 70% full. Built beside the old one and renamed over it,
+// so a crash leaves either table whole
+static bool growTable(const string &path, const OpponentTable &t)
+{
+    OpponentSummary *slots = new OpponentSummary[t.capacity];
+    ifstream in(path, ios::binary);
+    in.seekg(opponentSlotAt(0));
+    bool ok = (bool)in.read((char *)slots, (streamsize)t.capacity * sizeof(OpponentSummary));
+    in.close();
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; ok && i < t.capacity; i++)
+        if (slots[i].games > 0)
+            slots[count++] = slots[i];
+
+    string tmpPath = path + ".tmp";
+    ok = ok && writeTable(tmpPath, t.capacity * 2, slots, count);
+    delete[] slots;
+    if (!ok)
+        return false;
+    remove(path.c_str());
+    return rename(tmpPath.c_str(), path.c_str()) == 0;
+}
+
+// Open the player's opponent table for an update, creating or growing it as needed,
+// and find the slot for this opponent
+static int reserveOpponent(fstream &file, const string &path, int32_t opponentId, OpponentTable &t,
+                           OpponentSummary &out, bool &found)
+{
+    file.open(path, ios::binary | ios::in | ios::out);
+    if (!file.is_open() || !readTable(file, t))
+    {
+        file.close();
+        if (!writeTable(path, OPPONENTS_MIN_CAPACITY, nullptr, 0))
+            return -1;
+        file.open(path, ios::binary | ios::in | ios::out);
+        if (!readTable(file, t))
+            return -1;
+    }
+
+    if ((t.count + 1) * 10 > t.capacity * 7)
+    {
+        file.close();
+        if (!growTable(path, t))
+            return -1;
+        file.open(path, ios::binary | ios::in | ios::out);
+        if (!readTable(file, t))
+            return -1;
+    }
+    return probeOpponent(file, t, opponentId, out, found);
+}
+
+static bool appendTo(const string &path, const string &opponentsPath, MatchRecord record)
+{
+    HistoryHeader h;
+    if (!readHeader(path, h))
+    {
+        // First match - create the file with an empty header
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, HISTORY_MAGIC, 8);
+        h.version = HISTORY_VERSION;
+        h.recordSize = sizeof(MatchRecord);
+        for (int i = 0; i < MATCH_LEVELS; i++)
+            h.levelHead[i] = -1;
+
+        ofstream create(path, ios::binary | ios::trunc);
+        if (!create.is_open() || !writeTable(opponentsPath, OPPONENTS_MIN_CAPACITY, nullptr, 0))
+        {
+            cerr << "Error: couldn't create " << path << endl;
+            return false;
+        }
+        create.write((const char *)&h, sizeof(h));
+    }
+
+    int32_t index = (int32_t)h.stats.count;
+    record.padding = 0;  // Written as-is - no stack bytes in the file
+    record.reserved = 0;
+
+    // Keep timestamps sorted so range queries can binary search
+    if (record.timestamp < h.lastTimestamp)
+        record.timestamp = h.lastTimestamp;
+    h.lastTimestamp = record.timestamp;
+
+    int slot = levelSlot(record.level);
+    record.prevSameLevel = h.levelHead[slot];
+    h.levelHead[slot] = index;
+
+    OpponentSummary opponent = {record.opponentId, 0, 0, -1};
+    OpponentTable table;
+    fstream opponents;
+    bool known = false;
+    int slotOfOpponent = reserveOpponent(opponents, opponentsPath, record.opponentId, table, opponent, known);
+    if (slotOfOpponent < 0)
+    {
+        cerr << "Error: couldn't update " << opponentsPath << endl;
+        return false;
+    }
+    record.prevSameOpponent = opponent.lastRecord;
+    opponent.games++;
+    if (record.result == MATCH_WIN)
+        opponent.wins++;
+    opponent.lastRecord = index;
+
+    fstream file(path, ios::binary | ios::in | ios::out);
+    if (!file.is_open())
+        return false;
+
+    // Record goes at its slot (not EOF) so a torn previous append is overwritten
+    file.seekp(sizeof(HistoryHeader) + (streamoff)index * sizeof(MatchRecord));
+    file.write((const char *)&record, sizeof(record));
+
+    opponents.seekp(opponentSlotAt((uint32_t)slotOfOpponent));
+    opponents.write((const char *)&opponent, sizeof(opponent));
+    if (!known)
+    {
+        table.count++;
+        opponents.seekp(0);
+        opponents.write((const char *)&table, sizeof(table));
+    }
+
+    MatchStats &s = h.stats;
+    s.count++;
+    if (record.result == MATCH_WIN)
+        s.wins++;
+    else if (record.result == MATCH_LOSS)
+        s.losses++;
+    else
+        s.solo++;
+    s.totalScore += record.score;
+    if (record.score > s.bestScore)
+        s.bestScore = record.score;
+
+    // Header last - the count only covers the record once it is written
+    file.seekp(0);
+    file.write((const char *)&h, sizeof(h));
+    return file.good();
+}
+
+MatchHistory::MatchHistory() : dataDir("data/") {}
+
+MatchHistory &MatchHistory::instance()
+{
+    static MatchHistory history;
+    return history;
+}
+
+void MatchHistory::setDataDir(const string &dir)
+{
+    dataDir = dir;
+}
+
+string MatchHistory::pathOf(const string &id) const
+{
+    return dataDir + id + ".matches";
+}
+
+string MatchHistory::opponentsPathOf(const string &id) const
+{
+    return dataDir + id + ".opponents";
+}
+
+bool MatchHistory::loadHeader(const string &id, HistoryHeader &h) const
+{
+    return readHeader(pathOf(id), h);
+}
+
+bool MatchHistory::append(const string &id, const MatchRecord &record)
+{
+    return appendTo(pathOf(id), opponentsPathOf(id), record);
+}
+
+int MatchHistory::getCount(const string &id) const
+{
+    MatchStats s;
+    return getStats(id, s) ? (int)s.count : 0;
+}
+
+bool MatchHistory::getStats(const string &id, MatchStats &out) const
+{
+    HistoryHeader h;
+    if (!loadHeader(id, h))
+    {
+        memset(&out, 0, sizeof(out));
+        return false;
+    }
+    out = h.stats;
+    return true;
+}
+
+bool MatchHistory::readRecord(ifstream &in, int index, MatchRecord &out) const
+{
+    in.seekg(sizeof(HistoryHeader) + (streamoff)index * sizeof(MatchRecord));
+    return (bool)in.read((char *)&out, sizeof(out));
+}
+
+int MatchHistory::readPage(const string &id, int offset, int limit, MatchRecord *out) const
+{
+    MatchStats s;
+    if (offset < 0 || limit <= 0 || !getStats(id, s) || offset >= (int)s.count)
+        return 0;
+
+    // Newest-first page [offset, offset + limit) is one contiguous run on disk
+    int last = (int)s.count - 1 - offset;
+    int first = last - limit + 1;
+    if (first < 0)
+        first = 0;
+    int n = last - first + 1;
+
+    ifstream in(pathOf(id), ios::binary);
+    in.seekg(sizeof(HistoryHeader) + (streamoff)first * sizeof(MatchRecord));
+    if (!in.read((char *)out, (streamsize)n * sizeof(MatchRecord)))
+        return 0;
+
+    for (int i = 0, j = n - 1; i < j; i++, j--)
+    {
+        MatchRecord t = out[i];
+        out[i] = out[j];
+        out[j] = t;
+    }
+    return n;
+}
+
+int MatchHistory::lastMatches(const string &id, int n, MatchRecord *out) const
+{
+    return readPage(id, 0, n, out);
+}
+
+// Walk prevSameOpponent or prevSameLevel links from head, keeping records whose
+// level matches (any level if -1). Links always point backwards, anything else
+// is a torn write and ends the walk
+int MatchHistory::followChain(const string &id, int32_t head, bool byOpponent, int level, int limit, MatchRecord *out) const
+{
+    MatchStats s;
+    if (limit <= 0 || !getStats(id, s))
+        return 0;
+
+    ifstream in(pathOf(id), ios::binary);
+    MatchRecord r;
+    int n = 0;
+    int32_t previous = (int32_t)s.count;
+    for (int32_t index = head; index >= 0 && index < previous && n < limit;)
+    {
+        if (!readRecord(in, index, r))
+            break;
+        if (level < 0 || r.level == level)
+            out[n++] = r;
+        previous = index;
+        index = byOpponent ? r.prevSameOpponent : r.prevSameLevel;
+    }
+    return n;
+}
+
+int MatchHistory::byOpponent(const string &id, int32_t opponentId, int limit, MatchRecord *out) const
+{
+    OpponentSummary s;
+    if (!headToHead(id, opponentId, s))
+        return 0;
+    return followChain(id, s.lastRecord, true, -1, limit, out);
+}
+
+int MatchHistory::byLevel(const string &id, int level, int limit, MatchRecord *out) const
+{
+    HistoryHeader h;
+    if (!loadHeader(id, h))
+        return 0;
+    // Top levels share a chain, so the level is also checked per record
+    return followChain(id, h.levelHead[levelSlot(level)], false, level, limit, out);
+}
+
+int MatchHistory::inRange(const string &id, int64_t from, int64_t to, int limit, MatchRecord *out) const
+{
+    MatchStats s;
+    if (limit <= 0 || from > to || !getStats(id, s))
+        return 0;
+
+    // Timestamps never decrease - binary search for the first record after the range
+    ifstream in(pathOf(id), ios::binary);
+    MatchRecord r;
+    int lo = 0, hi = (int)s.count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (!readRecord(in, mid, r))
+            return 0;
+        if (r.timestamp <= to)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    int n = 0;
+    for (int index = lo - 1; index >= 0 && n < limit; index--)
+    {
+        if (!readRecord(in, index, r) || r.timestamp < from)
+            break;
+        out[n++] = r;
+    }
+    return n;
+}
+
+bool MatchHistory::headToHead(const string &id, int32_t opponentId, OpponentSummary &out) const
+{
+    HistoryHeader h;
+    ifstream in(opponentsPathOf(id), ios::binary);
+    OpponentTable t;
+    bool found = false;
+    if (loadHeader(id, h) && readTable(in, t) && probeOpponent(in, t, opponentId, out, found) >= 0 && found)
+        return true;
+    out = OpponentSummary{opponentId, 0, 0, -1};
+    return false;
+}
+
+// Pull the number following a marker such as "Score: ", or fallback if absent
+static int numberAfter(const string &line, const string &marker, int fallback)
+{
+    size_t pos = line.find(marker);
+    return pos == string::npos ? fallback : atoi(line.c_str() + pos + marker.length());
+}
+
+int MatchHistory::importLegacy(const string &id, const string *lines, int count)
+{
+    MatchStats existing;
+    if (count <= 0 || getStats(id, existing))
+        return 0;
+
+    // Opponent names are resolved to ids once, here
+    UsernameIndex &index = UsernameIndex::instance();
+    if (!index.isOpen())
+        index.open();
+
+    int imported = 0;
+    for (int i = count - 1; i >= 0; i--)
+    {
+        const string &line = lines[i];
+        MatchRecord r;
+        memset(&r, 0, sizeof(r));
+        r.score = numberAfter(line, "Score: ", 0);
+
+        if (line.compare(0, 3, "vs ") == 0)
+        {
+            size_t dash = line.find(" - ");
+            string name = line.substr(3, dash == string::npos ? string::npos : dash - 3);
+            string opponent = index.isOpen() ? index.getPlayerId(name) : "";
+            r.opponentId = opponent.empty() ? OPPONENT_UNKNOWN : atoi(opponent.c_str());
+            r.result = line.find(" - WIN") != string::npos ? MATCH_WIN : MATCH_LOSS;
+            r.level = 1;
+        }
+        else
+        {
+            r.opponentId = OPPONENT_NONE;
+            r.result = MATCH_SOLO;
+            r.level = (int16_t)numberAfter(line, "(Level ", 1);
+        }
+
+        if (append(id, r))
+            imported++;
+    }
+    return imported;
+}
+
+// Same wording as the old history strings, built in one buffer
+string MatchHistory::describe(const MatchRecord &record, const string &opponentName)
+{
+    char line[96];
+    if (record.result == MATCH_SOLO)
+        snprintf(line, sizeof(line), "Single Player - Score: %d (Level %d)", record.score, record.level);
+    else
+        snprintf(line, sizeof(line), "vs %.48s - %s (Score: %d)", opponentName.c_str(),
+                 record.result == MATCH_WIN ? "WIN" : "LOSE", record.score);
+    return line;
+}
@@ -238,13 +238,12 @@ bool GameRoom::addPlayerByID(const string &playerID)
     }
 
     // Get player data
-    Player *p = system->returnPlayer(playerID);
-    if (!p)
+    PlayerView p = system->viewPlayer(playerID, FIELD_PROFILE);
+    if (!p.isValid())
         return false;
 
     // Create queued player with score from player data
     QueuedPlayer qp(playerID, p->highScore, p->username);
-    delete p;
 
     return waitingQueue.insert(qp);
 }
@@ -259,13 +258,12 @@ bool GameRoom::addPlayerToQueue(const string &username, const string &password)
 
     // Get player data
     string playerID = system->returnId(username);
-    Player *p = system->returnPlayer(playerID);
-    if (!p)
+    PlayerView p = system->viewPlayer(playerID, FIELD_PROFILE);
+    if (!p.isValid())
         return false;
 
     // Create queued player with score from leaderboard
     QueuedPlayer qp(playerID, p->highScore, p->username);
-    delete p;
 
     return waitingQueue.insert(qp);
 }
@@ -6,13 +6,17 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <cstdio>
 #include "../header/System.h"
 #include "../header/FriendManagement.h"
 #include "../header/Game.h"
 #include "../header/Multiplayer.h"
 #include "../header/Inventory.h"
+#include "../header/MatchHistory.h"
 
 #include "../header/LeaderBoard.h"
+#include "../header/ScreenPacer.h"
+#include "../header/AssetCache.h"
 using namespace std;
 using namespace sf;
 
@@ -21,48 +25,51 @@ extern bool musicEnabled;
 extern void toggleBackgroundMusic();
 extern bool isMusicEnabled();
 extern void setMusicEnabled(bool enabled);
+extern void playThemeMusic(const string &path);
+extern void playMenuMusic();
 
 class MenuSystem
 {
 private:
     RenderWindow *window;
-    Font font;
-    Font msgfont;
+    AssetRef<Font> font;
+    AssetRef<Font> msgfont;
     Text options[9];
     Text welcomeMsg;
     int selectedIndex = 0;
     bool shouldLogout = false; // Flag to indicate logout (return to login screen)
     bool shouldExit = false;   // Flag to indicate exit (close application)
+    ScreenPacer menuPacer;     // Redraws the main menu only after a change
 
     string playerID;
     System system;
 
     ThemeInventory themeInventory;
-    Texture backgroundTexture;
+    AssetRef<Texture> backgroundTexture;
     Sprite backgroundSprite;
 
-    Texture inventorybackgroundTexture;
+    AssetRef<Texture> inventorybackgroundTexture;
     Sprite inventorybackgroundSprite;
 
-    Texture profilebackgroundTexture;
+    AssetRef<Texture> profilebackgroundTexture;
     Sprite profilebackgroundSprite;
 
-    Texture leaderboardTexture;
+    AssetRef<Texture> leaderboardTexture;
     Sprite leaderboardSprite;
 
-    Texture gameTypeTexture;
+    AssetRef<Texture> gameTypeTexture;
     Sprite gameTypeSprite;
 
-    Texture friendsTexture;
+    AssetRef<Texture> friendsTexture;
     Sprite friendsSprite;
 
-    Texture historyTexture;
+    AssetRef<Texture> historyTexture;
     Sprite historySprite;
 
-    Texture gameOverTexture;
+    AssetRef<Texture> gameOverTexture;
     Sprite gameOverSprite;
 
-    Texture settingsTexture;
+    AssetRef<Texture> settingsTexture;
     Sprite settingsSprite;
 
     const string labels[9] = {
@@ -77,67 +84,79 @@ private:
         "Exit"};
 
 public:
-    MenuSystem(RenderWindow *win, const string &id) : window(win), playerID(id)
+    MenuSystem(RenderWindow *win, const string &id) : window(win), menuPacer("Main menu"), playerID(id)
     {
-        if (!font.loadFromFile("assets/fonts/STENCIL.ttf"))
+        AssetCache &assets = AssetCache::instance();
+        font = assets.font("assets/fonts/STENCIL.ttf");
+        if (!font.isLoaded())
         {
             cout << "Failed to load font\n";
         }
-        if (!msgfont.loadFromFile("assets/fonts/MATURASC.ttf"))
+        msgfont = assets.font("assets/fonts/MATURASC.ttf");
+        if (!msgfont.isLoaded())
         {
             cout << "Failed to load font\n";
         }
-        if (!backgroundTexture.loadFromFile("assets/images/menuBackground.png"))
+        backgroundTexture = assets.texture("assets/images/menuBackground.png");
+        if (!backgroundTexture.isLoaded())
         {
             cout << "Failed to load image\n";
         }
-        backgroundSprite.setTexture(backgroundTexture);
-        if (!inventorybackgroundTexture.loadFromFile("assets/images/inventoryBackground.png"))
+        backgroundSprite.setTexture(*backgroundTexture);
+        inventorybackgroundTexture = assets.texture("assets/images/inventoryBackground.png");
+        if (!inventorybackgroundTexture.isLoaded())
         {
             cout << "Failed to load image\n";
         }
-        inventorybackgroundSprite.setTexture(inventorybackgroundTexture);
+        inventorybackgroundSprite.setTexture(*inventorybackgroundTexture);
 
-        if (!profilebackgroundTexture.loadFromFile("assets/images/background.jpg"))
+        profilebackgroundTexture = assets.texture("assets/images/background.jpg");
+        if (!profilebackgroundTexture.isLoaded())
         {
             cout << "Failed to load image\n";
         }
-        profilebackgroundSprite.setTexture(profilebackgroundTexture);
+        profilebackgroundSprite.setTexture(*profilebackgroundTexture);
 
-        if (!leaderboardTexture.loadFromFile("assets/images/leaderboardBackground.png"))
+        leaderboardTexture = assets.texture("assets/images/leaderboardBackground.png");
+        if (!leaderboardTexture.isLoaded())
         {
             cout << "Failed to load image\n";
         }
-        leaderboardSprite.setTexture(leaderboardTexture);
-        if (!gameTypeTexture.loadFromFile("assets/images/BgXonic.png"))
+        leaderboardSprite.setTexture(*leaderboardTexture);
+        gameTypeTexture = assets.texture("assets/images/BgXonic.png");
+        if (!gameTypeTexture.isLoaded())
         {
             cout << "Failed to load image\n";
         }
-        gameTypeSprite.setTexture(gameTypeTexture);
+        gameTypeSprite.setTexture(*gameTypeTexture);
 
-        if (!friendsTexture.loadFromFile("assets/images/FriendsBackground.png"))
+        friendsTexture = assets.texture("assets/images/FriendsBackground.png");
+        if (!friendsTexture.isLoaded())
         {
             cout << "Failed to load image\n";
         }
-        friendsSprite.setTexture(friendsTexture);
+        friendsSprite.setTexture(*friendsTexture);
 
-        if (!historyTexture.loadFromFile("assets/images/historyBackground.png"))
+        historyTexture = assets.texture("assets/images/historyBackground.png");
+        if (!historyTexture.isLoaded())
         {
             cout << "Failed to load image\n";
         }
-        historySprite.setTexture(historyTexture);
+        historySprite.setTexture(*historyTexture);
 
-        if (!gameOverTexture.loadFromFile("assets/images/gameOverBackground.png"))
+        gameOverTexture = assets.texture("assets/images/gameOverBackground.png");
+        if (!gameOverTexture.isLoaded())
         {
             cout << "Failed to load image\n";
         }
-        gameOverSprite.setTexture(gameOverTexture);
+        gameOverSprite.setTexture(*gameOverTexture);
 
-        if (!settingsTexture.loadFromFile("assets/images/setting-background.jpg"))
+        settingsTexture = assets.texture("assets/images/setting-background.jpg");
+        if (!settingsTexture.isLoaded())
         {
             cout << "Failed to load settings background image\n";
         }
-        settingsSprite.setTexture(settingsTexture);
+        settingsSprite.setTexture(*settingsTexture);
 
         setUI();
     }
@@ -147,7 +166,7 @@ public:
 
         for (int i = 0; i < 9; ++i)
         {
-            options[i].setFont(font);
+            options[i].setFont(*font);
             options[i].setString(labels[i]);
             options[i].setCharacterSize(28);
 
@@ -159,14 +178,12 @@ public:
 
             options[i].setFillColor(i == selectedIndex ? Color::Yellow : Color::White);
         }
-        welcomeMsg.setFont(msgfont);
+        welcomeMsg.setFont(*msgfont);
         welcomeMsg.setCharacterSize(70);
         welcomeMsg.setFillColor(Color::Blue);
-        Player *p = system.returnPlayer(playerID);
+        PlayerView p = system.viewPlayer(playerID, FIELD_PROFILE);
 
-        welcomeMsg.setString("Welcome " + p->username + "!");
-
-        delete p;
+        welcomeMsg.setString("Welcome " + (p.isValid() ? p->username : string("")) + "!");
         welcomeMsg.setPosition(80, 50);
     }
 
@@ -176,7 +193,8 @@ public:
         while (window->isOpen())
         {
             handleInput();
-            render();
+            if (menuPacer.redraw())
+                render();
 
             // Check if logout or exit was requested
             if (shouldLogout)
@@ -196,7 +214,7 @@ private:
     void handleInput()
     {
         Event event;
-        while (window->pollEvent(event))
+        while (menuPacer.nextEvent(*window, event))
         {
             if (event.type == Event::Closed)
                 window->close();
@@ -268,6 +286,11 @@ private:
         return "";
     }
 
+    string getThemeMusicPath(int themeID)
+    {
+        return themeInventory.getThemeMusicPath(themeID);
+    }
+
     int getPlayerTheme()
     {
         return themeInventory.loadPlayerThemePreference(playerID);
@@ -281,7 +304,7 @@ private:
         Text texts[2];
         for (int i = 0; i < 2; i++)
         {
-            texts[i].setFont(font);
+            texts[i].setFont(*font);
             texts[i].setString(labels[i]);
             texts[i].setCharacterSize(28);
             texts[i].setFillColor(Color::White);
@@ -294,11 +317,13 @@ private:
         int highlighted = 0;
         texts[highlighted].setFillColor(Color::Yellow);
 
+        ScreenPacer pacer("Play mode");
+
         // Loop until selection
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -343,6 +368,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             // Draw
             window->clear(Color(20, 20, 20));
             window->draw(gameTypeSprite);
@@ -362,7 +390,7 @@ private:
         Text texts[2];
         for (int i = 0; i < 2; i++)
         {
-            texts[i].setFont(font);
+            texts[i].setFont(*font);
             texts[i].setString(labels[i]);
             texts[i].setCharacterSize(28);
             texts[i].setFillColor(Color::White);
@@ -375,11 +403,13 @@ private:
         int highlighted = 0;
         texts[highlighted].setFillColor(Color::Yellow);
 
+        ScreenPacer pacer("New or saved game");
+
         // Loop until selection
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -424,6 +454,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             // Draw
             window->clear(Color(20, 20, 20));
             window->draw(gameTypeSprite);
@@ -449,7 +482,7 @@ private:
         selectedToPlay = 0;
         Text promptText, inputText, errorText, instructionText, helpText, pasteHintText;
 
-        promptText.setFont(font);
+        promptText.setFont(*font);
         promptText.setString("Enter Save ID:");
         promptText.setCharacterSize(28);
         promptText.setFillColor(Color::White);
@@ -457,7 +490,7 @@ private:
             (window->getSize().x - promptText.getLocalBounds().width) / 2.f,
             80.f);
 
-        instructionText.setFont(font);
+        instructionText.setFont(*font);
         instructionText.setString("(Save ID format: playerID_YYYYMMDD_HHMMSS)");
         instructionText.setCharacterSize(16);
         instructionText.setFillColor(Color::Cyan);
@@ -465,7 +498,7 @@ private:
             (window->getSize().x - instructionText.getLocalBounds().width) / 2.f,
             120.f);
 
-        pasteHintText.setFont(font);
+        pasteHintText.setFont(*font);
         pasteHintText.setString("Tip: Press Ctrl+V to paste from clipboard (copy from Settings)");
         pasteHintText.setCharacterSize(14);
         pasteHintText.setFillColor(Color::Green);
@@ -473,21 +506,21 @@ private:
             (window->getSize().x - pasteHintText.getLocalBounds().width) / 2.f,
             150.f);
 
-        inputText.setFont(font);
+        inputText.setFont(*font);
         inputText.setCharacterSize(24);
         inputText.setFillColor(Color::Yellow);
         inputText.setPosition(
             (window->getSize().x - 400.f) / 2.f,
             200.f);
 
-        errorText.setFont(font);
+        errorText.setFont(*font);
         errorText.setCharacterSize(20);
         errorText.setFillColor(Color::Red);
         errorText.setPosition(
             (window->getSize().x - 400.f) / 2.f,
             260.f);
 
-        helpText.setFont(font);
+        helpText.setFont(*font);
         helpText.setString("Enter: Load | Ctrl+V: Paste | Escape: Cancel");
         helpText.setCharacterSize(18);
         helpText.setFillColor(Color::White);
@@ -498,10 +531,11 @@ private:
         string input;
         string errorMsg = "";
 
+        ScreenPacer pacer("Save ID");
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                     window->close();
@@ -615,6 +649,9 @@ private:
             inputText.setString(input + "_");
             errorText.setString(errorMsg);
 
+            if (!pacer.redraw())
+                continue;
+
             window->clear(Color(20, 20, 20));
             window->draw(gameTypeSprite);
             window->draw(promptText);
@@ -637,14 +674,14 @@ private:
         selectedToPlay = 0;
 
         // Load current player to check friend list
-        Player *currentPlayer = system.returnPlayer(playerID);
+        Player *currentPlayer = system.returnPlayer(playerID, FIELD_PROFILE | FIELD_FRIENDS);
         if (!currentPlayer)
         {
             return "";
         }
 
         Text promptText, inputText, errorText, instructionText;
-        promptText.setFont(font);
+        promptText.setFont(*font);
         promptText.setString("Enter Friend's Player ID:");
         promptText.setCharacterSize(24);
         promptText.setFillColor(Color::White);
@@ -653,7 +690,7 @@ private:
             (window->getSize().x - promptText.getLocalBounds().width) / 2.f,
             100.f);
 
-        instructionText.setFont(font);
+        instructionText.setFont(*font);
         instructionText.setString("(You can only play multiplayer with your friends)");
         instructionText.setCharacterSize(16);
         instructionText.setFillColor(Color::Cyan);
@@ -661,7 +698,7 @@ private:
             (window->getSize().x - instructionText.getLocalBounds().width) / 2.f,
             140.f);
 
-        inputText.setFont(font);
+        inputText.setFont(*font);
         inputText.setCharacterSize(24);
         inputText.setFillColor(Color::Yellow);
         // below prompt
@@ -669,7 +706,7 @@ private:
             (window->getSize().x - 400.f) / 2.f, // 400px wide input box
             200.f);
 
-        errorText.setFont(font);
+        errorText.setFont(*font);
         errorText.setCharacterSize(20);
         errorText.setFillColor(Color::Red);
         errorText.setPosition(
@@ -677,7 +714,7 @@ private:
             250.f);
 
         Text helpText;
-        helpText.setFont(font);
+        helpText.setFont(*font);
         helpText.setString("Press Enter to confirm | Escape to cancel");
         helpText.setCharacterSize(18);
         helpText.setFillColor(Color::White);
@@ -688,10 +725,11 @@ private:
         string input; // the accumulating user string
         string errorMsg = "";
 
+        ScreenPacer pacer("Opponent ID");
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                     window->close();
@@ -756,6 +794,9 @@ private:
             inputText.setString(input + "_"); // trailing underscore cursor
             errorText.setString(errorMsg);
 
+            if (!pacer.redraw())
+                continue;
+
             // Render
             window->clear(Color(20, 20, 20));
             window->draw(gameTypeSprite);
@@ -784,19 +825,19 @@ private:
      */
     void displayPlayerProfile()
     {
-        Player *player = system.returnPlayer(playerID);
+        Player *player = system.returnPlayer(playerID, FIELD_PROFILE);
         if (!player)
             return;
 
-        Font profileFont;
-        if (!profileFont.loadFromFile("assets/fonts/HARLOWSI.ttf"))
+        AssetRef<Font> profileFont = AssetCache::instance().font("assets/fonts/HARLOWSI.ttf");
+        if (!profileFont.isLoaded())
         {
             cout << "Failed to load profile font\n";
         }
 
         // Header
         Text header;
-        header.setFont(font);
+        header.setFont(*font);
         header.setCharacterSize(50);
         Color lightCyan(200, 255, 255);
         header.setFillColor(lightCyan);
@@ -808,7 +849,7 @@ private:
         const float startY = 120.f, lineSpacing = 55.f;
         for (int i = 0; i < 5; ++i)
         {
-            lines[i].setFont(profileFont);
+            lines[i].setFont(*profileFont);
             lines[i].setCharacterSize(40);
             lines[i].setFillColor(Color::White);
             lines[i].setPosition(100.f, startY + i * lineSpacing);
@@ -830,16 +871,17 @@ private:
         // Prompt text
         Color lightGold(255, 215, 100);
         Text prompt;
-        prompt.setFont(profileFont);
+        prompt.setFont(*profileFont);
         prompt.setCharacterSize(32);
         prompt.setFillColor(lightGold);
         prompt.setPosition(40.f, startY + 6 * lineSpacing);
         prompt.setString("Press Esc to return");
 
+        ScreenPacer pacer("Profile");
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -856,6 +898,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             window->clear(Color(30, 30, 30));
             window->draw(profilebackgroundSprite);
             window->draw(header);
@@ -886,7 +931,7 @@ private:
     {
         // Header
         Text header;
-        header.setFont(msgfont);
+        header.setFont(*msgfont);
         header.setCharacterSize(50);
         header.setFillColor(Color::Yellow);
         header.setPosition(180.f, 10.f);
@@ -894,7 +939,7 @@ private:
 
         // Subheader
         Text subHeader;
-        subHeader.setFont(font);
+        subHeader.setFont(*font);
         subHeader.setCharacterSize(18);
         subHeader.setFillColor(Color::Cyan);
         subHeader.setPosition(50.f, 70.f);
@@ -923,7 +968,7 @@ private:
         Text themeTexts[MAX_THEMES];
         for (int i = 0; i < themeCount; i++)
         {
-            themeTexts[i].setFont(font);
+            themeTexts[i].setFont(*font);
             themeTexts[i].setCharacterSize(20);
             themeTexts[i].setPosition(50.f, 110.f + i * 45.f);
 
@@ -944,21 +989,21 @@ private:
 
         // Current theme indicator
         Text currentThemeText;
-        currentThemeText.setFont(font);
+        currentThemeText.setFont(*font);
         currentThemeText.setCharacterSize(18);
         currentThemeText.setFillColor(Color::Green);
         currentThemeText.setPosition(50.f, 360.f);
 
         // Preview label
         Text previewLabel;
-        previewLabel.setFont(font);
+        previewLabel.setFont(*font);
         previewLabel.setCharacterSize(18);
         previewLabel.setFillColor(Color::White);
         previewLabel.setPosition(450.f, 110.f);
         previewLabel.setString("Preview:");
 
         // Preview sprite for background images
-        Texture previewTexture;
+        AssetRef<Texture> previewTexture;  // Held while shown
         Sprite previewSprite;
         RectangleShape previewBorder(Vector2f(310.f, 180.f));
         previewBorder.setPosition(445.f, 135.f);
@@ -969,20 +1014,21 @@ private:
         // Load initial preview
         if (themeCount > 0 && !themes[selectedIndex]->backgroundImagePath.empty())
         {
-            if (previewTexture.loadFromFile(themes[selectedIndex]->backgroundImagePath))
+            AssetRef<Texture> preview = AssetCache::instance().texture(themes[selectedIndex]->backgroundImagePath, true);
+            if (preview.isLoaded())
             {
-                previewTexture.setSmooth(true);
-                previewSprite.setTexture(previewTexture, true);
+                previewTexture = preview;
+                previewSprite.setTexture(*previewTexture, true);
                 previewSprite.setPosition(450.f, 140.f);
-                float scaleX = 300.f / (float)previewTexture.getSize().x;
-                float scaleY = 170.f / (float)previewTexture.getSize().y;
+                float scaleX = 300.f / (float)previewTexture->getSize().x;
+                float scaleY = 170.f / (float)previewTexture->getSize().y;
                 previewSprite.setScale(scaleX, scaleY);
             }
         }
 
         // Instructions
         Text instructions;
-        instructions.setFont(font);
+        instructions.setFont(*font);
         instructions.setCharacterSize(16);
         instructions.setFillColor(Color::Cyan);
         instructions.setPosition(50.f, 400.f);
@@ -990,7 +1036,7 @@ private:
 
         // Search prompt
         Text searchPrompt;
-        searchPrompt.setFont(font);
+        searchPrompt.setFont(*font);
         searchPrompt.setCharacterSize(16);
         searchPrompt.setFillColor(Color::White);
         searchPrompt.setPosition(450.f, 330.f);
@@ -998,7 +1044,7 @@ private:
 
         // Status message
         Text statusMsg;
-        statusMsg.setFont(font);
+        statusMsg.setFont(*font);
         statusMsg.setCharacterSize(20);
         statusMsg.setFillColor(Color::Green);
         statusMsg.setPosition(50.f, 450.f);
@@ -1006,6 +1052,7 @@ private:
         bool showStatus = false;
         Clock statusClock;
 
+        ScreenPacer pacer("Inventory");
         while (window->isOpen())
         {
             // Update current theme text
@@ -1019,10 +1066,13 @@ private:
             if (showStatus && statusClock.getElapsedTime().asSeconds() > 2.0f)
             {
                 showStatus = false;
+                pacer.invalidate();
             }
 
+            // While the message is up, wake in time to take it down
+            Time statusLeft = showStatus ? seconds(2.05f) - statusClock.getElapsedTime() : Time::Zero;
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt, statusLeft))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -1046,13 +1096,14 @@ private:
                         // Update preview
                         if (!themes[selectedIndex]->backgroundImagePath.empty())
                         {
-                            if (previewTexture.loadFromFile(themes[selectedIndex]->backgroundImagePath))
+                            AssetRef<Texture> preview = AssetCache::instance().texture(themes[selectedIndex]->backgroundImagePath, true);
+                            if (preview.isLoaded())
                             {
-                                previewTexture.setSmooth(true);
-                                previewSprite.setTexture(previewTexture, true);
+                                previewTexture = preview;
+                                previewSprite.setTexture(*previewTexture, true);
                                 previewSprite.setPosition(450.f, 140.f);
-                                float scaleX = 300.f / (float)previewTexture.getSize().x;
-                                float scaleY = 170.f / (float)previewTexture.getSize().y;
+                                float scaleX = 300.f / (float)previewTexture->getSize().x;
+                                float scaleY = 170.f / (float)previewTexture->getSize().y;
                                 previewSprite.setScale(scaleX, scaleY);
                             }
                         }
@@ -1067,13 +1118,14 @@ private:
                         // Update preview
                         if (!themes[selectedIndex]->backgroundImagePath.empty())
                         {
-                            if (previewTexture.loadFromFile(themes[selectedIndex]->backgroundImagePath))
+                            AssetRef<Texture> preview = AssetCache::instance().texture(themes[selectedIndex]->backgroundImagePath, true);
+                            if (preview.isLoaded())
                             {
-                                previewTexture.setSmooth(true);
-                                previewSprite.setTexture(previewTexture, true);
+                                previewTexture = preview;
+                                previewSprite.setTexture(*previewTexture, true);
                                 previewSprite.setPosition(450.f, 140.f);
-                                float scaleX = 300.f / (float)previewTexture.getSize().x;
-                                float scaleY = 170.f / (float)previewTexture.getSize().y;
+                                float scaleX = 300.f / (float)previewTexture->getSize().x;
+                                float scaleY = 170.f / (float)previewTexture->getSize().y;
                                 previewSprite.setScale(scaleX, scaleY);
                             }
                         }
@@ -1106,13 +1158,14 @@ private:
                                     // Update preview
                                     if (!themes[selectedIndex]->backgroundImagePath.empty())
                                     {
-                                        if (previewTexture.loadFromFile(themes[selectedIndex]->backgroundImagePath))
+                                        AssetRef<Texture> preview = AssetCache::instance().texture(themes[selectedIndex]->backgroundImagePath, true);
+                                        if (preview.isLoaded())
                                         {
-                                            previewTexture.setSmooth(true);
-                                            previewSprite.setTexture(previewTexture, true);
+                                            previewTexture = preview;
+                                            previewSprite.setTexture(*previewTexture, true);
                                             previewSprite.setPosition(450.f, 140.f);
-                                            float scaleX = 300.f / (float)previewTexture.getSize().x;
-                                            float scaleY = 170.f / (float)previewTexture.getSize().y;
+                                            float scaleX = 300.f / (float)previewTexture->getSize().x;
+                                            float scaleY = 170.f / (float)previewTexture->getSize().y;
                                             previewSprite.setScale(scaleX, scaleY);
                                         }
                                     }
@@ -1149,13 +1202,14 @@ private:
                                         // Update preview
                                         if (!themes[selectedIndex]->backgroundImagePath.empty())
                                         {
-                                            if (previewTexture.loadFromFile(themes[selectedIndex]->backgroundImagePath))
+                                            AssetRef<Texture> preview = AssetCache::instance().texture(themes[selectedIndex]->backgroundImagePath, true);
+                                            if (preview.isLoaded())
                                             {
-                                                previewTexture.setSmooth(true);
-                                                previewSprite.setTexture(previewTexture, true);
+                                                previewTexture = preview;
+                                                previewSprite.setTexture(*previewTexture, true);
                                                 previewSprite.setPosition(450.f, 140.f);
-                                                float scaleX = 300.f / (float)previewTexture.getSize().x;
-                                                float scaleY = 170.f / (float)previewTexture.getSize().y;
+                                                float scaleX = 300.f / (float)previewTexture->getSize().x;
+                                                float scaleY = 170.f / (float)previewTexture->getSize().y;
                                                 previewSprite.setScale(scaleX, scaleY);
                                             }
                                         }
@@ -1180,6 +1234,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             // Draw
             window->clear(Color(30, 30, 30));
             window->draw(inventorybackgroundSprite);
@@ -1218,19 +1275,19 @@ private:
     {
         Text promptText, inputText;
 
-        promptText.setFont(font);
+        promptText.setFont(*font);
         promptText.setString("Enter Theme ID (1-5):");
         promptText.setCharacterSize(24);
         promptText.setFillColor(Color::White);
         promptText.setPosition(250.f, 200.f);
 
-        inputText.setFont(font);
+        inputText.setFont(*font);
         inputText.setCharacterSize(28);
         inputText.setFillColor(Color::Yellow);
         inputText.setPosition(300.f, 260.f);
 
         Text helpText;
-        helpText.setFont(font);
+        helpText.setFont(*font);
         helpText.setString("Enter: Search | Esc: Cancel");
         helpText.setCharacterSize(16);
         helpText.setFillColor(Color::Cyan);
@@ -1238,10 +1295,11 @@ private:
 
         string input = "";
 
+        ScreenPacer pacer("Theme search");
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -1283,6 +1341,9 @@ private:
 
             inputText.setString(input + "_");
 
+            if (!pacer.redraw())
+                continue;
+
             window->clear(Color(40, 40, 40));
             window->draw(promptText);
             window->draw(inputText);
@@ -1297,7 +1358,7 @@ private:
     {
         // Prepare texts
         Text title, scoreText, prompt;
-        title.setFont(font);
+        title.setFont(*font);
         title.setString("Game Over");
         title.setCharacterSize(48);
         title.setFillColor(Color::Red);
@@ -1308,7 +1369,7 @@ private:
             title.setPosition(window->getSize().x / 2.f, 150.f);
         }
 
-        scoreText.setFont(font);
+        scoreText.setFont(*font);
         scoreText.setString("Your Score: " + to_string(score));
         scoreText.setCharacterSize(32);
         scoreText.setFillColor(Color::White);
@@ -1318,7 +1379,7 @@ private:
             scoreText.setPosition(window->getSize().x / 2.f, 250.f);
         }
 
-        prompt.setFont(font);
+        prompt.setFont(*font);
         prompt.setString("Press Esc to return to Main Menu");
         prompt.setCharacterSize(24);
         prompt.setFillColor(Color::Yellow);
@@ -1328,11 +1389,13 @@ private:
             prompt.setPosition(window->getSize().x / 2.f, 350.f);
         }
 
+        ScreenPacer pacer("Game over");
+
         // Loop until Esc or window close
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -1345,6 +1408,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             window->clear(Color(20, 20, 20));
             window->draw(gameOverSprite);
             window->draw(title);
@@ -1365,7 +1431,7 @@ private:
     {
         Text title, saveIDText, instructionText, prompt;
 
-        title.setFont(font);
+        title.setFont(*font);
         title.setString("Game Saved!");
         title.setCharacterSize(48);
         title.setFillColor(Color::Green);
@@ -1375,7 +1441,7 @@ private:
             title.setPosition(window->getSize().x / 2.f, 120.f);
         }
 
-        saveIDText.setFont(font);
+        saveIDText.setFont(*font);
         saveIDText.setString("Save ID: " + saveID);
         saveIDText.setCharacterSize(24);
         saveIDText.setFillColor(Color::Yellow);
@@ -1385,7 +1451,7 @@ private:
             saveIDText.setPosition(window->getSize().x / 2.f, 220.f);
         }
 
-        instructionText.setFont(font);
+        instructionText.setFont(*font);
         instructionText.setString("Write down this Save ID to resume your game later!");
         instructionText.setCharacterSize(20);
         instructionText.setFillColor(Color::White);
@@ -1395,7 +1461,7 @@ private:
             instructionText.setPosition(window->getSize().x / 2.f, 300.f);
         }
 
-        prompt.setFont(font);
+        prompt.setFont(*font);
         prompt.setString("Press Esc to return to Main Menu");
         prompt.setCharacterSize(20);
         prompt.setFillColor(Color::Cyan);
@@ -1405,10 +1471,11 @@ private:
             prompt.setPosition(window->getSize().x / 2.f, 400.f);
         }
 
+        ScreenPacer pacer("Save confirmation");
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -1421,6 +1488,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             window->clear(Color(20, 20, 20));
             window->draw(gameOverSprite);
             window->draw(title);
@@ -1431,55 +1501,63 @@ private:
         }
     }
 
-    void displayMatchHistory()
+    // Opponent username for a history line - ids resolve through the player cache
+    string opponentName(const MatchRecord &record)
     {
-        Player *player = system.returnPlayer(playerID);
-        if (!player)
-            return;
+        if (record.opponentId < 0)
+            return "Unknown";
+        PlayerView opponent = system.viewPlayer(to_string(record.opponentId), FIELD_PROFILE);
+        return opponent.isValid() ? opponent->username : "Player " + to_string(record.opponentId);
+    }
 
-        int total = player->noOfMatches;
+    void displayMatchHistory()
+    {
+        MatchHistory &history = MatchHistory::instance();
+        MatchStats stats;
+        history.getStats(playerID, stats);
+        int total = (int)stats.count;
 
         // Handle empty history
         if (total == 0)
         {
             Text noMatchText;
-            noMatchText.setFont(font);
+            noMatchText.setFont(*font);
             noMatchText.setCharacterSize(24);
             noMatchText.setFillColor(Color::White);
             noMatchText.setString("No matches played yet!");
             noMatchText.setPosition(200.f, 300.f);
 
             Text title;
-            title.setFont(msgfont);
+            title.setFont(*msgfont);
             title.setCharacterSize(70);
             title.setFillColor(Color::Green);
             title.setString("Match History");
             title.setPosition(20.f, 20.f);
 
             Text prompt;
-            prompt.setFont(font);
+            prompt.setFont(*font);
             prompt.setCharacterSize(18);
             prompt.setFillColor(Color::Cyan);
             prompt.setString("Press Esc to return");
             prompt.setPosition(300.f, 500.f);
 
+            ScreenPacer pacer("Match history (empty)");
             while (window->isOpen())
             {
                 Event evt;
-                while (window->pollEvent(evt))
+                while (pacer.nextEvent(*window, evt))
                 {
                     if (evt.type == Event::Closed)
                     {
                         window->close();
-                        delete player;
                         return;
                     }
                     if (evt.type == Event::KeyPressed && evt.key.code == Keyboard::Escape)
-                    {
-                        delete player;
                         return;
-                    }
                 }
+                if (!pacer.redraw())
+                    continue;
+
                 window->clear(Color(30, 30, 30));
                 window->draw(historySprite);
                 window->draw(title);
@@ -1487,56 +1565,27 @@ private:
                 window->draw(prompt);
                 window->display();
             }
-            delete player;
             return;
         }
 
-        Text *entries = new Text[total];
-        string *raw = new string[total];
-
-        // Get match history from stack (most recent first)
-        node *curr = player->matchHistory.head;
-        int i = 0;
-        while (curr && i < total)
-        {
-            raw[i++] = curr->data;
-            curr = curr->next;
-        }
-
-        // Format entries with match number (most recent = #1)
-        for (int i = 0; i < total; ++i)
-        {
-            entries[i].setFont(font);
-            entries[i].setCharacterSize(18);
-
-            // Color code: Green for wins, Red for losses, White for single player
-            if (raw[i].find("WIN") != string::npos)
-            {
-                entries[i].setFillColor(Color::Green);
-            }
-            else if (raw[i].find("LOSE") != string::npos)
-            {
-                entries[i].setFillColor(Color::Red);
-            }
-            else
-            {
-                entries[i].setFillColor(Color::White);
-            }
-
-            // Add match number
-            entries[i].setString("#" + to_string(i + 1) + "  " + raw[i]);
-        }
+        // Only the visible page is read from disk, so long histories cost nothing extra
+        const int visible = 9;
+        MatchRecord page[visible];
+        Text entries[visible];
+        int shown = 0;
+        int offset = 0; // scroll state
+        int loadedOffset = -1;
 
-        delete[] raw;
+        char summary[128];
+        snprintf(summary, sizeof(summary), "Total Matches: %d   Win Rate: %.0f%%   Avg Score: %.0f   Best: %d",
+                 total, stats.winRate() * 100.0, stats.averageScore(), stats.bestScore);
 
-        int offset = 0; // scroll state
-        const int visible = 9;
         bool running = true;
-
+        ScreenPacer pacer("Match history");
         while (running && window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -1546,12 +1595,7 @@ private:
                 else if (evt.type == Event::KeyPressed)
                 {
                     if (evt.key.code == Keyboard::Escape)
-                    {
-                        running = false;
-                        delete[] entries;
-                        delete player;
                         return;
-                    }
                     else if (evt.key.code == Keyboard::Down)
                     {
                         if (offset + visible < total)
@@ -1562,40 +1606,76 @@ private:
                         if (offset > 0)
                             offset--;
                     }
+                    else if (evt.key.code == Keyboard::PageDown)
+                    {
+                        offset += visible;
+                        if (offset + visible > total)
+                            offset = total > visible ? total - visible : 0;
+                    }
+                    else if (evt.key.code == Keyboard::PageUp)
+                    {
+                        offset = offset > visible ? offset - visible : 0;
+                    }
+                }
+            }
+
+            if (offset != loadedOffset)
+            {
+                shown = history.readPage(playerID, offset, visible, page);
+                for (int i = 0; i < shown; ++i)
+                {
+                    entries[i].setFont(*font);
+                    entries[i].setCharacterSize(18);
+
+                    // Color code: Green for wins, Red for losses, White for single player
+                    if (page[i].result == MATCH_WIN)
+                        entries[i].setFillColor(Color::Green);
+                    else if (page[i].result == MATCH_LOSS)
+                        entries[i].setFillColor(Color::Red);
+                    else
+                        entries[i].setFillColor(Color::White);
+
+                    // Match number, most recent = #1
+                    string line = MatchHistory::describe(page[i], page[i].result == MATCH_SOLO ? "" : opponentName(page[i]));
+                    entries[i].setString("#" + to_string(offset + i + 1) + "  " + line);
                 }
+                loadedOffset = offset;
             }
 
+            if (!pacer.redraw())
+                continue;
+
             window->clear(Color(30, 30, 30));
             window->draw(historySprite);
 
             Text title;
-            title.setFont(msgfont);
+            title.setFont(*msgfont);
             title.setCharacterSize(60);
             title.setFillColor(Color::Green);
             title.setString("Match History");
             title.setPosition(20.f, 20.f);
             window->draw(title);
 
-            // Show total matches count
+            // Totals come from the running stats in the history header
             Text countText;
-            countText.setFont(font);
+            countText.setFont(*font);
             countText.setCharacterSize(18);
             countText.setFillColor(Color::Yellow);
-            countText.setString("Total Matches: " + to_string(total));
+            countText.setString(summary);
             countText.setPosition(20.f, 100.f);
             window->draw(countText);
 
             // Instructions
             Text instrText;
-            instrText.setFont(font);
+            instrText.setFont(*font);
             instrText.setCharacterSize(14);
             instrText.setFillColor(Color::Cyan);
-            instrText.setString("Use UP/DOWN to scroll | Esc to return");
+            instrText.setString("Use UP/DOWN to scroll | PgUp/PgDn to page | Esc to return");
             instrText.setPosition(20.f, 560.f);
             window->draw(instrText);
 
             float y = 140.f;
-            for (int i = offset; i < total && i < offset + visible; ++i)
+            for (int i = 0; i < shown; ++i)
             {
                 entries[i].setPosition(40.f, y);
                 window->draw(entries[i]);
@@ -1604,9 +1684,6 @@ private:
 
             window->display();
         }
-
-        delete[] entries;
-        delete player;
     }
 
     /*
@@ -1778,8 +1855,8 @@ private:
      */
     void displaySettingsScreen()
     {
-        Font settingsFont;
-        if (!settingsFont.loadFromFile("assets/fonts/arial.ttf"))
+        AssetRef<Font> settingsFont = AssetCache::instance().font("assets/fonts/arial.ttf");
+        if (!settingsFont.isLoaded())
         {
             cout << "Failed to load settings font\n";
             return;
@@ -1787,7 +1864,7 @@ private:
 
         // Title
         Text title;
-        title.setFont(font);
+        title.setFont(*font);
         title.setCharacterSize(50);
         title.setFillColor(Color::Yellow);
         title.setString("Settings");
@@ -1795,20 +1872,20 @@ private:
 
         // Music toggle section
         Text musicLabel;
-        musicLabel.setFont(settingsFont);
+        musicLabel.setFont(*settingsFont);
         musicLabel.setCharacterSize(24);
         musicLabel.setFillColor(Color::White);
         musicLabel.setString("Background Music:");
         musicLabel.setPosition(50.f, 100.f);
 
         Text musicStatus;
-        musicStatus.setFont(settingsFont);
+        musicStatus.setFont(*settingsFont);
         musicStatus.setCharacterSize(24);
         musicStatus.setPosition(280.f, 100.f);
 
         // Saved games section
         Text savedGamesLabel;
-        savedGamesLabel.setFont(settingsFont);
+        savedGamesLabel.setFont(*settingsFont);
         savedGamesLabel.setCharacterSize(22);
         savedGamesLabel.setFillColor(Color::Cyan);
         savedGamesLabel.setString("Your Saved Games (Press Enter to copy selected):");
@@ -1823,7 +1900,7 @@ private:
         Text *saveTexts = new Text[MAX_SAVES];
         for (int i = 0; i < saveCount; i++)
         {
-            saveTexts[i].setFont(settingsFont);
+            saveTexts[i].setFont(*settingsFont);
             saveTexts[i].setCharacterSize(18);
             saveTexts[i].setFillColor(Color::White);
             saveTexts[i].setString(to_string(i + 1) + ") " + saveIDs[i]);
@@ -1832,7 +1909,7 @@ private:
 
         // No saves message
         Text noSavesText;
-        noSavesText.setFont(settingsFont);
+        noSavesText.setFont(*settingsFont);
         noSavesText.setCharacterSize(20);
         noSavesText.setFillColor(Color(150, 150, 150));
         noSavesText.setString("No saved games found.");
@@ -1840,14 +1917,14 @@ private:
 
         // Copy confirmation text
         Text copyConfirm;
-        copyConfirm.setFont(settingsFont);
+        copyConfirm.setFont(*settingsFont);
         copyConfirm.setCharacterSize(18);
         copyConfirm.setFillColor(Color::Green);
         copyConfirm.setPosition(50.f, 520.f);
 
         // Instructions
         Text instructions;
-        instructions.setFont(settingsFont);
+        instructions.setFont(*settingsFont);
         instructions.setCharacterSize(16);
         instructions.setFillColor(Color::White);
         instructions.setString("M: Toggle Music | UP/DOWN: Select Save | ENTER: Copy Save ID | ESC: Return");
@@ -1863,6 +1940,7 @@ private:
             saveTexts[0].setFillColor(Color::Yellow);
         }
 
+        ScreenPacer pacer("Settings");
         while (window->isOpen())
         {
             // Update music status text
@@ -1881,10 +1959,13 @@ private:
             if (showCopyConfirm && copyConfirmClock.getElapsedTime().asSeconds() > 2.0f)
             {
                 showCopyConfirm = false;
+                pacer.invalidate();
             }
 
+            // While the confirmation is up, wake in time to take it down
+            Time confirmLeft = showCopyConfirm ? seconds(2.05f) - copyConfirmClock.getElapsedTime() : Time::Zero;
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt, confirmLeft))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -1928,6 +2009,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             // Draw
             window->clear(Color(30, 30, 30));
             window->draw(settingsSprite);
@@ -1968,7 +2052,7 @@ private:
         Text texts[5];
         for (int i = 0; i < 5; i++)
         {
-            texts[i].setFont(font);
+            texts[i].setFont(*font);
             texts[i].setString(labels[i]);
             texts[i].setCharacterSize(28);
             texts[i].setFillColor(Color::White);
@@ -1981,11 +2065,13 @@ private:
         int highlighted = 0;
         texts[highlighted].setFillColor(Color::Yellow);
 
+        ScreenPacer pacer("Level");
+
         // Loop until selection
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -2019,6 +2105,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             // Draw
             window->clear(Color(20, 20, 20));
             window->draw(gameTypeSprite);
@@ -2037,8 +2126,8 @@ private:
         const string *ids = lb.getSortedHeap(); // Returns internal array, no need to delete
         int count = lb.getSize();
 
-        Font lfont;
-        if (!lfont.loadFromFile("assets/fonts/arial.ttf"))
+        AssetRef<Font> lfont = AssetCache::instance().font("assets/fonts/arial.ttf");
+        if (!lfont.isLoaded())
         {
             cout << "Error loading font\n";
             return;
@@ -2050,11 +2139,11 @@ private:
 
         for (int i = 0; i < count && i < maxDisplay; ++i)
         {
-            Player *p = system.returnPlayer(ids[i]);
-            if (!p)
+            PlayerView p = system.viewPlayer(ids[i], FIELD_PROFILE);
+            if (!p.isValid())
                 continue;
 
-            entries[i].setFont(lfont);
+            entries[i].setFont(*lfont);
             entries[i].setCharacterSize(22);
 
             // Color coding: Gold for #1, Silver for #2, Bronze for #3
@@ -2083,7 +2172,6 @@ private:
                 to_string(i + 1) + ". " +
                 p->username + " (ID: " + p->ID + ") - Score: " +
                 to_string(p->highScore) + " [" + levelName + "]");
-            delete p;
         }
 
         const float startY = 160.f;
@@ -2095,7 +2183,7 @@ private:
 
         // Title
         Text title;
-        title.setFont(font);
+        title.setFont(*font);
         title.setCharacterSize(60);
         title.setFillColor(Color::Yellow);
         title.setString("Leaderboard");
@@ -2103,7 +2191,7 @@ private:
 
         // Subtitle showing top 10
         Text subtitle;
-        subtitle.setFont(font);
+        subtitle.setFont(*font);
         subtitle.setCharacterSize(22);
         subtitle.setFillColor(Color::Cyan);
         subtitle.setString("Top 10 Players (by High Score)");
@@ -2111,7 +2199,7 @@ private:
 
         // No players message
         Text noPlayersText;
-        noPlayersText.setFont(lfont);
+        noPlayersText.setFont(*lfont);
         noPlayersText.setCharacterSize(24);
         noPlayersText.setFillColor(Color::White);
         noPlayersText.setString("No players on leaderboard yet!");
@@ -2119,16 +2207,17 @@ private:
 
         // Instructions
         Text instrText;
-        instrText.setFont(lfont);
+        instrText.setFont(*lfont);
         instrText.setCharacterSize(16);
         instrText.setFillColor(Color::White);
         instrText.setString("Press Esc to return");
         instrText.setPosition(300.f, 560.f);
 
+        ScreenPacer pacer("Leaderboard");
         while (window->isOpen())
         {
             Event evt;
-            while (window->pollEvent(evt))
+            while (pacer.nextEvent(*window, evt))
             {
                 if (evt.type == Event::Closed)
                 {
@@ -2142,6 +2231,9 @@ private:
                 }
             }
 
+            if (!pacer.redraw())
+                continue;
+
             window->clear(Color(20, 20, 20));
             window->draw(leaderboardSprite);
             window->draw(title);
@@ -2220,7 +2312,9 @@ private:
                         }
 
                         // Pass background image path to game
+                        playThemeMusic(getThemeMusicPath(themeID));
                         score = p.run(theme, playerID, madeSave, 0, levelSelected, *window, "", savedGameID, bgImagePath);
+                        playMenuMusic();
                         window->setSize(Vector2u(800, 600));
                         View view(FloatRect(0, 0, 800, 600));
                         window->setView(view);
@@ -2238,7 +2332,9 @@ private:
                         themeID = getPlayerTheme();
                         bgImagePath = getThemeImagePath(themeID);
 
+                        playThemeMusic(getThemeMusicPath(themeID));
                         score = p.run(Color::Green, playerID, madeSave, 1, 1, *window, saveIDToLoad, savedGameID, bgImagePath);
+                        playMenuMusic();
                         window->setSize(Vector2u(800, 600));
                         View view(FloatRect(0, 0, 800, 600));
                         window->setView(view);
@@ -2265,7 +2361,9 @@ private:
                         return; // User cancelled or no valid opponent
                     }
                     // Pass background image path to multiplayer
+                    playThemeMusic(getThemeMusicPath(themeID));
                     winner = mp.run(theme, playerID, opponent, *window, bgImagePath);
+                    playMenuMusic();
                     window->setSize(Vector2u(800, 600));
                     View view(FloatRect(0, 0, 800, 600));
                     window->setView(view);
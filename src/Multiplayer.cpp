@@ -6,140 +6,28 @@
 #include "../header/Multiplayer.h"
 #include <iostream>
 #include <cstdlib>
-#include <ctime>
 
 using namespace std;
 using namespace sf;
 
 const int ts = 18;
 
-Multiplayer::Enemy::Enemy(int startX, int startY)
-{
-    x = startX;
-    y = startY;
-    dx = 4 - rand() % 8;
-    dy = 4 - rand() % 8;
-    frozen = false;
-}
-
-void Multiplayer::Enemy::move(int grid[M][N])
-{
-    if (frozen)
-        return;
-
-    x += dx;
-    if (grid[y / ts][x / ts] == 1)
-    {
-        dx = -dx;
-        x += dx;
-    }
-
-    y += dy;
-    if (grid[y / ts][x / ts] == 1)
-    {
-        dy = -dy;
-        y += dy;
-    }
-}
-
 // Constructor
 Multiplayer::Multiplayer()
 {
-    score = 0;
-    bonusCount = 0;
-    powerUps = 0;
-    nextPowerUpScore = 50;
-    powerUpUsed = false;
-    powerUpActive = false;
-    powerUpRemainingTime = 0;
-    player2Frozen = false;
-
-    score2 = 0;
-    bonusCount2 = 0;
-    powerUps2 = 0;
-    nextPowerUpScore2 = 50;
-    powerUpUsed2 = false;
-    powerUpActive2 = false;
-    powerUpRemainingTime2 = 0;
-    player1Frozen = false;
-
     useBackgroundImage = false;
-
-    resetGame();
-}
-
-void Multiplayer::resetGame()
-{
-    for (int i = 0; i < M; i++)
-        for (int j = 0; j < N; j++)
-            grid[i][j] = 0;
-
-    // Set borders
-    for (int i = 0; i < M; i++)
-        for (int j = 0; j < N; j++)
-            if (i == 0 || j == 0 || i == M - 1 || j == N - 1)
-                grid[i][j] = 1;
-
-    score = 0;
-    bonusCount = 0;
-    powerUpActive = false;
-    nextPowerUpScore = 50;
-
-    score2 = 0;
-    bonusCount2 = 0;
-    powerUpActive2 = false;
-    nextPowerUpScore2 = 50;
-}
-
-// Flood fill to mark enemy-reachable areas
-void Multiplayer::drop(int y, int x)
-{
-    if (y < 0 || y >= M || x < 0 || x >= N)
-        return;
-    if (grid[y][x] != 0)
-        return;
-
-    grid[y][x] = -1;
-    
-    drop(y - 1, x);
-    drop(y + 1, x);
-    drop(y, x - 1);
-    drop(y, x + 1);
-}
-
-/*
- * Method: countCapturedTiles
- * Description: Counts all tiles marked as -1 (enemy-reachable areas).
- * Returns: Number of captured tiles
- */
-int Multiplayer::countCapturedTiles()
-{
-    int count = 0;
-    for (int i = 0; i < M; i++)
-    {
-        for (int j = 0; j < N; j++)
-        {
-            if (grid[i][j] == -1)
-            {
-                count++;
-            }
-        }
-    }
-    return count;
 }
 
 // Main game loop - returns winner's username or "Tie"
 string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &window, const string &bgImagePath)
 {
-    srand(time(0));
-    Player *p1 = system.returnPlayer(id1);
-    Player *p2 = system.returnPlayer(id2);
+    Player *p1 = system.returnPlayer(id1, FIELD_PROFILE);
+    Player *p2 = system.returnPlayer(id2, FIELD_PROFILE);
 
     string player1Name = p1 ? p1->username : "Player 1";
     string player2Name = p2 ? p2->username : "Player 2";
 
-    powerUps = p1->powerUps;
-    powerUps2 = p2->powerUps;
+    engine.newDuel(p1->powerUps, p2->powerUps, GameRng::freshSeed());
     backgroundImagePath = bgImagePath;
 
     // Create the game window
@@ -152,18 +40,18 @@ string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &win
     useBackgroundImage = false;
     if (!bgImagePath.empty())
     {
-        if (backgroundTexture.loadFromFile(bgImagePath))
+        // Smooth scaling
+        backgroundTexture = AssetCache::instance().texture(bgImagePath, true);
+        if (backgroundTexture.isLoaded())
         {
-            // Set texture with smooth scaling
-            backgroundTexture.setSmooth(true);
-            backgroundSprite.setTexture(backgroundTexture, true); // resetRect = true
+            backgroundSprite.setTexture(*backgroundTexture, true); // resetRect = true
             backgroundSprite.setPosition(0, 0);
 
             // Calculate scale to fill entire game window
             float windowWidth = (float)(N * ts);
             float windowHeight = (float)(M * ts);
-            float textureWidth = (float)backgroundTexture.getSize().x;
-            float textureHeight = (float)backgroundTexture.getSize().y;
+            float textureWidth = (float)backgroundTexture->getSize().x;
+            float textureHeight = (float)backgroundTexture->getSize().y;
 
             float scaleX = windowWidth / textureWidth;
             float scaleY = windowHeight / textureHeight;
@@ -178,14 +66,11 @@ string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &win
         }
     }
 
-    // Load textures
-    Texture t1, t2, t3;
-    t1.loadFromFile("assets/images/tiles.png");
-    t2.loadFromFile("assets/images/gameover.png");
-    t3.loadFromFile("assets/images/enemy.png");
+    // Tiles, enemy and game over all come from one atlas texture
+    const TextureAtlas &atlas = TextureAtlas::sprites();
 
-    Font font;
-    if (!font.loadFromFile("assets/fonts/arial.ttf"))
+    AssetRef<Font> font = AssetCache::instance().font("assets/fonts/arial.ttf");
+    if (!font.isLoaded())
     {
         cout << "Error loading font. Using default font.\n";
     }
@@ -193,7 +78,7 @@ string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &win
     // Create text objects for score and power-ups
     // Player 1 score - LEFT side of screen
     Text scoreText;
-    scoreText.setFont(font);
+    scoreText.setFont(*font);
     scoreText.setCharacterSize(16);
     scoreText.setFillColor(Color::White);
     scoreText.setPosition(10, 5);
@@ -201,7 +86,7 @@ string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &win
 
     // Player 2 score - RIGHT side of screen
     Text scoreText2;
-    scoreText2.setFont(font);
+    scoreText2.setFont(*font);
     scoreText2.setCharacterSize(16);
     scoreText2.setFillColor(Color::White);
     scoreText2.setPosition(N * ts - 280, 5); // Right side
@@ -209,86 +94,46 @@ string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &win
 
     // Shared game timer - CENTER of screen
     Text timerText;
-    timerText.setFont(font);
+    timerText.setFont(*font);
     timerText.setCharacterSize(18);
     timerText.setFillColor(Color::Yellow);
     timerText.setPosition((N * ts) / 2 - 40, 5);
     timerText.setStyle(Text::Bold);
 
     Text instructionsText;
-    instructionsText.setFont(font);
+    instructionsText.setFont(*font);
     instructionsText.setCharacterSize(12);
     instructionsText.setFillColor(Color::White);
     instructionsText.setPosition(10, M * ts - 25);
     instructionsText.setString("P1: Arrows, SPACE=PowerUp | P2: WASD, F=PowerUp | P/Esc: Pause");
 
-    Sprite sTile(t1), sGameover(t2), sEnemy(t3);
+    Sprite sTile(atlas.getTexture()), sGameover(atlas.getTexture(), atlas.rect("gameover"));
+    Sprite sEnemy(atlas.getTexture(), atlas.rect("enemy"));
     sGameover.setPosition(100, 100);
     sEnemy.setOrigin(20, 20);
+    IntRect player1Tile = atlas.rect("tiles", IntRect(36, 0, ts, ts));
+    IntRect player2Tile = atlas.rect("tiles", IntRect(72, 0, ts, ts));
 
-    // Game variables
-    int enemyCount = 4;
-    Enemy a[4] = {
-        Enemy(2 * ts, 2 * ts),
-        Enemy(2 * ts, (M - 3) * ts),
-        Enemy((N - 3) * ts, 2 * ts),
-        Enemy((N - 3) * ts, (M - 3) * ts)};
+    board.create(atlas.getTexture(), M, N, ts);
+    board.setTile(1, atlas.rect("tiles", IntRect(0, 0, ts, ts)));
+    board.setTile(2, atlas.rect("tiles", IntRect(54, 0, ts, ts)));
+    board.setTile(3, atlas.rect("tiles", IntRect(36, 0, ts, ts)));
+    stats.setFont(*font);
 
     bool Game = true;
-    int x = 0, y = 0, dx = 0, dy = 0;
-    int x2 = N - 1, y2 = M - 1, dx2 = 0, dy2 = 0;
-    float timer2 = 0, delay2 = 0.07f;
-    bool isPlayer1Alive = true;
-    bool isPlayer2Alive = true;
-    float timer = 0, delay = 0.07f;
     Clock clock;
-    Clock gameTimer; // Shared game timer
-    float gameTime = 0;
 
-    // Track if players are currently constructing (on trail, not on wall)
-    bool p1Constructing = false;
-    bool p2Constructing = false;
+    // Frame time is banked and spent in fixed SIM_STEP ticks (see SinglePlayer::run)
+    float accumulator = 0;
 
-    resetGame();
+    // Input gathered this frame, handed to every tick the frame runs
+    EngineInput pending[2];
 
     while (window.isOpen())
     {
         float time = clock.getElapsedTime().asSeconds();
         clock.restart();
-        timer += time;
-        timer2 += time;
-
-        if (powerUpActive)
-        {
-            powerUpRemainingTime = 3.0f - powerUpClock.getElapsedTime().asSeconds();
-            player2Frozen = true; // Freeze Player 2
-            if (powerUpRemainingTime <= 0)
-            {
-                powerUpActive = false;
-                powerUpRemainingTime = 0;
-                player2Frozen = false; // Unfreeze Player 2
-            }
-        }
-        else
-        {
-            player2Frozen = false;
-        }
-
-        if (powerUpActive2)
-        {
-            powerUpRemainingTime2 = 3.0f - powerUpClock2.getElapsedTime().asSeconds();
-            player1Frozen = true; // Freeze Player 1
-            if (powerUpRemainingTime2 <= 0)
-            {
-                powerUpActive2 = false;
-                powerUpRemainingTime2 = 0;
-                player1Frozen = false; // Unfreeze Player 1
-            }
-        }
-        else
-        {
-            player1Frozen = false;
-        }
+        accumulator += time < MAX_FRAME_TIME ? time : MAX_FRAME_TIME;
 
         Event e;
         while (window.pollEvent(e))
@@ -299,81 +144,61 @@ string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &win
             if (e.type == Event::KeyPressed)
             {
                 /*
-                 * Power-Up Activation Rules:
+                 * Power-Up Activation Rules (checked by the engine on the next tick):
                  * - Player must be ALIVE to use power-up
                  * - Player must have power-ups in inventory (powerUps > 0)
                  * - No freeze can be currently active (prevents abuse)
-                 * - Player 1: Space key | Player 2: F key
+                 * - Player 1: F key | Player 2: Space key
                  */
 
                 // Player 1 Power-Up: F key (left side player uses left side key)
-                if (e.key.code == Keyboard::F &&
-                    isPlayer1Alive && // Must be alive
-                    powerUps > 0 &&   // Must have power-ups
-                    !powerUpActive && // P1's freeze not active
-                    !powerUpActive2)
-                { // P2's freeze not active (prevent overlap)
-                    powerUps--;
-                    powerUpUsed = true;
-                    powerUpClock.restart();
-                    powerUpActive = true;
-                    powerUpRemainingTime = 3.0f;
-                }
+                if (e.key.code == Keyboard::F && Game)
+                    pending[0].usePowerUp = true;
 
                 // Player 2 Power-Up: SPACE key (right side player uses right side key)
-                if (e.key.code == Keyboard::Space &&
-                    isPlayer2Alive &&  // Must be alive
-                    powerUps2 > 0 &&   // Must have power-ups
-                    !powerUpActive2 && // P2's freeze not active
-                    !powerUpActive)
-                { // P1's freeze not active (prevent overlap)
-                    powerUps2--;
-                    powerUpUsed2 = true;
-                    powerUpClock2.restart();
-                    powerUpActive2 = true;
-                    powerUpRemainingTime2 = 3.0f;
-                }
+                if (e.key.code == Keyboard::Space && Game)
+                    pending[1].usePowerUp = true;
+
+                if (e.key.code == Keyboard::F3)
+                    stats.toggle();
 
                 if (e.key.code == Keyboard::P || e.key.code == Keyboard::Escape)
                 {
                     bool shouldReset = false;
                     showPauseMenu(window, Game, shouldReset);
+                    clock.restart(); // Time spent paused is not played
 
-                    // Handle reset if selected from pause menu
+                    // Handle reset if selected from pause menu - fresh board and enemies,
+                    // both players keep the power-ups they hold
                     if (shouldReset)
                     {
-                        resetGame();
-                        x = 0;
-                        y = 0;
-                        x2 = N - 1;
-                        y2 = M - 1;
-                        dx = 0;
-                        dy = 0;
-                        dx2 = 0;
-                        dy2 = 0;
-                        isPlayer1Alive = true;
-                        isPlayer2Alive = true;
+                        const EngineState &state = engine.state();
+                        engine.newDuel(state.players[0].powerUps, state.players[1].powerUps, GameRng::freshSeed());
+                        pending[0] = pending[1] = EngineInput();
                         Game = true;
                     }
                     // Handle End Game from pause menu - exit immediately
                     else if (!Game)
                     {
+                        const EnginePlayer &one = engine.state().players[0];
+                        const EnginePlayer &two = engine.state().players[1];
+
                         // Update match history and exit
-                        bool p1Wins = (score > score2);
-                        bool p2Wins = (score2 > score);
-                        p1->addMatchUpdate(p2->username, p1Wins, score, powerUps);
-                        p2->addMatchUpdate(p1->username, p2Wins, score2, powerUps2);
+                        bool p1Wins = (one.score > two.score);
+                        bool p2Wins = (two.score > one.score);
+                        p1->addMatchUpdate(atoi(p2->ID.c_str()), p1Wins, one.score, one.powerUps);
+                        p2->addMatchUpdate(atoi(p1->ID.c_str()), p2Wins, two.score, two.powerUps);
 
                         string u1 = p1->username, u2 = p2->username;
                         delete p1;
                         delete p2;
 
                         // Show game over screen
-                        displayGameOverScreen2(&window, score, score2, u1, u2);
+                        displayGameOverScreen2(&window, one.score, two.score, u1, u2);
 
-                        if (score > score2)
+                        if (one.score > two.score)
                             return u1;
-                        else if (score2 > score)
+                        else if (two.score > one.score)
                             return u2;
                         else
                             return "Tie";
@@ -385,486 +210,170 @@ string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &win
         // Player 1 controls - WASD (left side player uses left side keys)
         if (Keyboard::isKeyPressed(Keyboard::A))
         {
-            dx = -1;
-            dy = 0;
+            pending[0].dx = -1;
+            pending[0].dy = 0;
         } // Left
         if (Keyboard::isKeyPressed(Keyboard::D))
         {
-            dx = 1;
-            dy = 0;
+            pending[0].dx = 1;
+            pending[0].dy = 0;
         } // Right
         if (Keyboard::isKeyPressed(Keyboard::W))
         {
-            dx = 0;
-            dy = -1;
+            pending[0].dx = 0;
+            pending[0].dy = -1;
         } // Up
         if (Keyboard::isKeyPressed(Keyboard::S))
         {
-            dx = 0;
-            dy = 1;
+            pending[0].dx = 0;
+            pending[0].dy = 1;
         } // Down
 
         // Player 2 controls - Arrow keys (right side player uses right side keys)
         if (Keyboard::isKeyPressed(Keyboard::Left))
         {
-            dx2 = -1;
-            dy2 = 0;
+            pending[1].dx = -1;
+            pending[1].dy = 0;
         } // Left
         if (Keyboard::isKeyPressed(Keyboard::Right))
         {
-            dx2 = 1;
-            dy2 = 0;
+            pending[1].dx = 1;
+            pending[1].dy = 0;
         } // Right
         if (Keyboard::isKeyPressed(Keyboard::Up))
         {
-            dx2 = 0;
-            dy2 = -1;
+            pending[1].dx = 0;
+            pending[1].dy = -1;
         } // Up
         if (Keyboard::isKeyPressed(Keyboard::Down))
         {
-            dx2 = 0;
-            dy2 = 1;
+            pending[1].dx = 0;
+            pending[1].dy = 1;
         } // Down
 
         if (!Game)
             continue;
 
-        // Update shared game timer
-        gameTime += time;
-
-        // Player 1 movement
-        if (timer > delay && isPlayer1Alive && !player1Frozen)
-        {
-            x += dx;
-            y += dy;
-
-            if (x < 0)
-                x = 0;
-            if (x > N - 1)
-                x = N - 1;
-            if (y < 0)
-                y = 0;
-            if (y > M - 1)
-                y = M - 1;
-
-            // Player 1 hits their own trail
-            if (grid[y][x] == 2)
-                isPlayer1Alive = false;
-            // Player 1 hits Player 2's constructing trail - Player 1 dies
-            if (grid[y][x] == 3)
-                isPlayer1Alive = false;
-
-            // Check if Player 1 is on wall (safe) or constructing
-            p1Constructing = (grid[y][x] != 1);
-
-            // Mark new trail if on empty space
-            if (grid[y][x] == 0)
-                grid[y][x] = 2;
-            timer = 0;
-        }
-        else if (timer > delay && isPlayer1Alive && player1Frozen)
-        {
-            timer = 0; // Consume timer even when frozen
-        }
-
-        // Player 2 movement
-        if (timer2 > delay2 && isPlayer2Alive && !player2Frozen)
+        int steps = 0;
+        while (accumulator >= SIM_STEP && engine.state().anyAlive())
         {
-            x2 += dx2;
-            y2 += dy2;
-
-            if (x2 < 0)
-                x2 = 0;
-            if (x2 > N - 1)
-                x2 = N - 1;
-            if (y2 < 0)
-                y2 = 0;
-            if (y2 > M - 1)
-                y2 = M - 1;
-
-            // Player 2 hits their own trail
-            if (grid[y2][x2] == 3)
-                isPlayer2Alive = false;
-            // Player 2 hits Player 1's constructing trail - Player 2 dies
-            if (grid[y2][x2] == 2)
-                isPlayer2Alive = false;
-
-            // Check if Player 2 is on wall (safe) or constructing
-            p2Constructing = (grid[y2][x2] != 1);
-
-            // Mark new trail if on empty space
-            if (grid[y2][x2] == 0)
-                grid[y2][x2] = 3;
-            timer2 = 0;
-        }
-        else if (timer2 > delay2 && isPlayer2Alive && player2Frozen)
-        {
-            timer2 = 0; // Consume timer even when frozen
-        }
-
-        /*
-         * Player-to-Player Collision Rules:
-         * 1. If both players collide while BOTH are constructing (moving) -> BOTH die
-         * 2. If P1 touches P2's constructing trail -> P1 dies (handled above)
-         * 3. If P2 touches P1's constructing trail -> P2 dies (handled above)
-         * 4. If P1 is constructing and collides with P2 (who is not constructing) -> P1 dies
-         * 5. If P2 is constructing and collides with P1 (who is not constructing) -> P2 dies
-         */
-        if (isPlayer1Alive && isPlayer2Alive && x == x2 && y == y2)
-        {
-            // Players are on the same tile - collision!
-            if (p1Constructing && p2Constructing)
+            // Too far behind (slow machine) - drop the backlog rather than spiral
+            if (steps++ == MAX_SIM_STEPS)
             {
-                // Both constructing - both die
-                isPlayer1Alive = false;
-                isPlayer2Alive = false;
+                accumulator = 0;
+                break;
             }
-            else if (p1Constructing && !p2Constructing)
-            {
-                // P1 constructing, P2 safe - P1 dies
-                isPlayer1Alive = false;
-            }
-            else if (!p1Constructing && p2Constructing)
-            {
-                // P2 constructing, P1 safe - P2 dies
-                isPlayer2Alive = false;
-            }
-            // If neither is constructing (both on wall), no collision death
-        }
+            accumulator -= SIM_STEP;
 
-        // Enemy movement (same as single-player)
-        for (int i = 0; i < enemyCount; i++)
-        {
-            if (!powerUpActive && !powerUpActive2)
-            {
-                a[i].frozen = false;
-                a[i].move(grid);
-            }
-            else
-            {
-                a[i].frozen = true;
-            }
+            // Movement, trails, collisions, enemies, captures and scoring for both players
+            engine.step(pending);
+            pending[0].usePowerUp = pending[1].usePowerUp = false;  // One press, one freeze
+            sEnemy.rotate(10);
         }
-
-        // Check if both players are dead (before area-filling)
-        if (!isPlayer1Alive && !isPlayer2Alive)
+        // Held keys are sampled again next frame; a frame that ran no tick keeps its input
+        if (steps > 0)
         {
-            Game = false;
+            pending[0].dx = pending[0].dy = 0;
+            pending[1].dx = pending[1].dy = 0;
         }
 
-        // Player 1 reaches safe wall - fill area (same as single-player)
-        if (grid[y][x] == 1 && isPlayer1Alive)
-        {
-            dx = dy = 0;
-
-            // Flood fill algorithm to determine enclosed areas
-            // Step 1: Mark all areas reachable by enemies with -1
-            for (int i = 0; i < enemyCount; i++)
-                drop(a[i].y / ts, a[i].x / ts);
-
-            int captured = 0;
-
-            // Step 2: Convert ONLY Player 1's trail to walls and fill enclosed areas
-            //         DO NOT touch Player 2's trail (value 3)
-            for (int i = 0; i < M; i++)
-            {
-                for (int j = 0; j < N; j++)
-                {
-                    if (grid[i][j] == -1)
-                    {
-                        // Enemy-reachable area - reset to empty
-                        grid[i][j] = 0;
-                    }
-                    else if (grid[i][j] == 2)
-                    {
-                        // Player 1 trail becomes wall - COUNT THIS
-                        grid[i][j] = 1;
-                        captured++;
-                    }
-                    else if (grid[i][j] == 0)
-                    {
-                        // Enclosed empty area - fill with walls but DON'T count
-                        grid[i][j] = 1;
-                    }
-                    // Leave Player 2's trail (value 3) untouched!
-                }
-            }
-
-            /*
-             * Points System for Player 1:
-             * - Each tile captured = 1 point
-             * - Capturing >10 tiles in single move = x2 points
-             * - After 3 bonus occurrences: threshold reduces to 5 tiles
-             * - After 5 bonus occurrences: capturing >5 tiles = x4 points
-             */
-            int bonusThreshold = (bonusCount >= 3) ? 5 : 10;
-            int multiplier = 1;
-
-            if (captured > bonusThreshold)
-            {
-                if (bonusCount >= 5)
-                {
-                    multiplier = 4; // x4 after 5 bonus occurrences
-                }
-                else
-                {
-                    multiplier = 2; // x2 for bonus capture
-                }
-                bonusCount++; // Increment AFTER determining multiplier
-            }
-
-            score += captured * multiplier;
-
-            /*
-             * Power-up thresholds: 50, 70, 100, 130, 160, 190...
-             */
-            while (score >= nextPowerUpScore)
-            {
-                powerUps++;
-                if (nextPowerUpScore == 50)
-                {
-                    nextPowerUpScore = 70;
-                }
-                else if (nextPowerUpScore == 70)
-                {
-                    nextPowerUpScore = 100;
-                }
-                else
-                {
-                    nextPowerUpScore += 30;
-                }
-            }
-        }
-
-        if (grid[y2][x2] == 1 && isPlayer2Alive)
-        {
-            dx2 = dy2 = 0;
-
-            // Flood fill algorithm to determine enclosed areas
-            // Step 1: Mark all areas reachable by enemies with -1
-            for (int i = 0; i < enemyCount; i++)
-                drop(a[i].y / ts, a[i].x / ts);
-
-            int captured2 = 0;
-
-            // Step 2: Convert ONLY Player 2's trail to walls and fill enclosed areas
-            //         DO NOT touch Player 1's trail (value 2)
-            for (int i = 0; i < M; i++)
-            {
-                for (int j = 0; j < N; j++)
-                {
-                    if (grid[i][j] == -1)
-                    {
-                        // Enemy-reachable area - reset to empty
-                        grid[i][j] = 0;
-                    }
-                    else if (grid[i][j] == 3)
-                    {
-                        // Player 2 trail becomes wall - COUNT THIS
-                        grid[i][j] = 1;
-                        captured2++;
-                    }
-                    else if (grid[i][j] == 0)
-                    {
-                        // Enclosed empty area - fill with walls but DON'T count
-                        grid[i][j] = 1;
-                    }
-                    // Leave Player 1's trail (value 2) untouched!
-                }
-            }
-
-            /*
-             * Points System for Player 2:
-             * - Each tile captured = 1 point
-             * - Capturing >10 tiles in single move = x2 points
-             * - After 3 bonus occurrences: threshold reduces to 5 tiles
-             * - After 5 bonus occurrences: capturing >5 tiles = x4 points
-             */
-            int bonusThreshold2 = (bonusCount2 >= 3) ? 5 : 10;
-            int multiplier = 1;
-
-            if (captured2 > bonusThreshold2)
-            {
-                if (bonusCount2 >= 5)
-                {
-                    multiplier = 4; // x4 after 5 bonus occurrences
-                }
-                else
-                {
-                    multiplier = 2; // x2 for bonus capture
-                }
-                bonusCount2++; // Increment AFTER determining multiplier
-            }
-
-            score2 += captured2 * multiplier;
-
-            /*
-             * Power-up thresholds: 50, 70, 100, 130, 160, 190...
-             */
-            while (score2 >= nextPowerUpScore2)
-            {
-                powerUps2++;
-                if (nextPowerUpScore2 == 50)
-                {
-                    nextPowerUpScore2 = 70;
-                }
-                else if (nextPowerUpScore2 == 70)
-                {
-                    nextPowerUpScore2 = 100;
-                }
-                else
-                {
-                    nextPowerUpScore2 += 30;
-                }
-            }
-        }
-
-        // Enemy collision check (identical to single-player: line 367-369)
-        // Check AFTER area-filling to match single-player structure
-        for (int i = 0; i < enemyCount; i++)
-        {
-            int enemyGridY = a[i].y / ts;
-            int enemyGridX = a[i].x / ts;
-
-            // Bounds check to prevent crashes
-            if (enemyGridY >= 0 && enemyGridY < M && enemyGridX >= 0 && enemyGridX < N)
-            {
-                // Enemy on Player 1's trail (value 2) - Player 1 dies
-                if (grid[enemyGridY][enemyGridX] == 2)
-                {
-                    isPlayer1Alive = false;
-                }
-                // Enemy on Player 2's trail (value 3) - Player 2 dies
-                if (grid[enemyGridY][enemyGridX] == 3)
-                {
-                    isPlayer2Alive = false;
-                }
-            }
-        }
+        // How far the next tick has come, for drawing enemies between ticks
+        float alpha = accumulator / SIM_STEP;
+        const EngineState &state = engine.state();
+        const EnginePlayer &one = state.players[0];
+        const EnginePlayer &two = state.players[1];
+        bool frozen = state.enemiesFrozen();
 
         /////////draw//////////
+        stats.beginFrame();
+
         // Use background image if available, otherwise solid color
         if (useBackgroundImage)
         {
             window.clear();
-            window.draw(backgroundSprite);
+            stats.draw(window, backgroundSprite);
         }
         else
         {
             window.clear(bgcolor);
         }
 
-        for (int i = 0; i < M; i++)
-        {
-            for (int j = 0; j < N; j++)
-            {
-                if (grid[i][j] == 0)
-                    continue;
-
-                if (grid[i][j] == 1)
-                    sTile.setTextureRect(IntRect(0, 0, ts, ts));
-                if (grid[i][j] == 2)
-                    sTile.setTextureRect(IntRect(54, 0, ts, ts));
-                if (grid[i][j] == 3)
-                    sTile.setTextureRect(IntRect(36, 0, ts, ts));
-
-                // Blue tint for tiles when any freeze power-up is active
-                if (powerUpActive || powerUpActive2)
-                {
-                    sTile.setColor(Color(150, 150, 255, 255)); // Blue tint for frozen effect
-                }
-                else
-                {
-                    sTile.setColor(Color::White); // Normal color
-                }
-
-                sTile.setPosition(j * ts, i * ts);
-                window.draw(sTile);
-            }
-        }
+        // The whole board in one call; blue tint for tiles when any freeze power-up is active
+        Color tint = frozen ? Color(150, 150, 255, 255) : Color::White;
+        stats.countRebuilt(board.update(&state.grid[0][0], tint));
+        stats.draw(window, board);
 
-        if (isPlayer1Alive)
+        // Both players' tiles and the enemies in one call from the atlas, tinted while frozen
+        spriteBatch.clear();
+        if (one.alive)
         {
-            sTile.setTextureRect(IntRect(36, 0, ts, ts));
-            sTile.setPosition(x * ts, y * ts);
-            // Tint player sprite if frozen
-            if (player1Frozen)
-            {
-                sTile.setColor(Color(100, 100, 255, 200)); // Blue tint for frozen
-            }
-            else
-            {
-                sTile.setColor(Color::White); // Normal color
-            }
-            window.draw(sTile);
+            sTile.setTextureRect(player1Tile);
+            sTile.setPosition(one.x * ts, one.y * ts);
+            sTile.setColor(one.frozen ? Color(100, 100, 255, 200) : Color::White);
+            spriteBatch.add(sTile);
         }
 
-        if (isPlayer2Alive)
+        if (two.alive)
         {
-            sTile.setTextureRect(IntRect(72, 0, ts, ts));
-            sTile.setPosition(x2 * ts, y2 * ts);
-            // Tint player sprite if frozen
-            if (player2Frozen)
-            {
-                sTile.setColor(Color(100, 100, 255, 200)); // Blue tint for frozen
-            }
-            else
-            {
-                sTile.setColor(Color::White); // Normal color
-            }
-            window.draw(sTile);
+            sTile.setTextureRect(player2Tile);
+            sTile.setPosition(two.x * ts, two.y * ts);
+            sTile.setColor(two.frozen ? Color(100, 100, 255, 200) : Color::White);
+            spriteBatch.add(sTile);
         }
 
-        sEnemy.rotate(10);
-        for (int i = 0; i < enemyCount; i++)
+        for (int i = 0; i < state.enemyCount; i++)
         {
-            if (a[i].frozen)
+            const EngineEnemy &enemy = state.enemies[i];
+            if (enemy.frozen)
             {
                 sEnemy.setColor(Color(100, 100, 255, 200)); // Blue tint for frozen enemies
             }
             else
             {
                 sEnemy.setColor(Color(255, 255, 255, 255)); // Normal color
-                sEnemy.rotate(10);
             }
-            sEnemy.setPosition(a[i].x, a[i].y);
-            window.draw(sEnemy);
+            sEnemy.setPosition(enemy.prevX + (enemy.x - enemy.prevX) * alpha,
+                               enemy.prevY + (enemy.y - enemy.prevY) * alpha);
+            spriteBatch.add(sEnemy);
         }
+        stats.draw(window, spriteBatch);
 
         // Blue overlay effect when either player's power-up (freeze) is active
-        if (powerUpActive || powerUpActive2)
+        if (frozen)
         {
             RectangleShape blueEffect(Vector2f(N * ts, M * ts));
             blueEffect.setFillColor(Color(0, 100, 255, 50)); // Semi-transparent blue overlay
-            window.draw(blueEffect);
+            stats.draw(window, blueEffect);
         }
 
-        string player1Status = !isPlayer1Alive ? " [DEAD]" : (player1Frozen ? " [FROZEN]" : "");
-        string player2Status = !isPlayer2Alive ? " [DEAD]" : (player2Frozen ? " [FROZEN]" : "");
+        string player1Status = !one.alive ? " [DEAD]" : (one.frozen ? " [FROZEN]" : "");
+        string player2Status = !two.alive ? " [DEAD]" : (two.frozen ? " [FROZEN]" : "");
 
         // Player 1 UI - LEFT side
-        scoreText.setString(player1Name + ": " + to_string(score) + " | PU:" + to_string(powerUps) +
-                            (powerUpActive ? " [!]" : "") + player1Status);
+        scoreText.setString(player1Name + ": " + to_string(one.score) + " | PU:" + to_string(one.powerUps) +
+                            (one.powerUpActive ? " [!]" : "") + player1Status);
 
         // Player 2 UI - RIGHT side
-        scoreText2.setString(player2Name + ": " + to_string(score2) + " | PU:" + to_string(powerUps2) +
-                             (powerUpActive2 ? " [!]" : "") + player2Status);
+        scoreText2.setString(player2Name + ": " + to_string(two.score) + " | PU:" + to_string(two.powerUps) +
+                             (two.powerUpActive ? " [!]" : "") + player2Status);
 
-        // Shared game timer - CENTER
-        int minutes = (int)gameTime / 60;
-        int seconds = (int)gameTime % 60;
+        // Shared game timer - CENTER, in simulation time
+        int gameTime = (int)(state.ticks * SIM_STEP);
+        int minutes = gameTime / 60;
+        int seconds = gameTime % 60;
         string timerStr = "Time: " + to_string(minutes) + ":" + (seconds < 10 ? "0" : "") + to_string(seconds);
         timerText.setString(timerStr);
 
-        window.draw(scoreText);
-        window.draw(scoreText2);
-        window.draw(timerText);
-        window.draw(instructionsText);
+        stats.draw(window, scoreText);
+        stats.draw(window, scoreText2);
+        stats.draw(window, timerText);
+        stats.draw(window, instructionsText);
+        stats.endFrame(window);
 
         window.display();
 
         // Check if game has ended (either both players dead, or ended via pause menu)
-        if (!Game || (!isPlayer1Alive && !isPlayer2Alive))
+        if (!Game || !state.anyAlive())
         {
             /*
              * Save match history for BOTH players:
@@ -874,29 +383,29 @@ string Multiplayer::run(Color bgcolor, string id1, string id2, RenderWindow &win
              */
 
             // Determine winner based on score
-            bool p1Wins = (score > score2);
-            bool p2Wins = (score2 > score);
+            bool p1Wins = (one.score > two.score);
+            bool p2Wins = (two.score > one.score);
             // If scores are equal, it's a tie (both get "LOSE" or we could add TIE)
 
             // Update Player 1's match history
-            p1->addMatchUpdate(p2->username, p1Wins, score, powerUps);
+            p1->addMatchUpdate(atoi(p2->ID.c_str()), p1Wins, one.score, one.powerUps);
 
             // Update Player 2's match history
-            p2->addMatchUpdate(p1->username, p2Wins, score2, powerUps2);
+            p2->addMatchUpdate(atoi(p1->ID.c_str()), p2Wins, two.score, two.powerUps);
 
             string u1 = p1->username, u2 = p2->username;
             delete p1;
             delete p2;
 
             // Show game over screen with both scores
-            displayGameOverScreen2(&window, score, score2, u1, u2);
+            displayGameOverScreen2(&window, one.score, two.score, u1, u2);
 
             // Return winner's name
-            if (score > score2)
+            if (one.score > two.score)
             {
                 return u1;
             }
-            else if (score2 > score)
+            else if (two.score > one.score)
             {
                 return u2;
             }
@@ -926,12 +435,11 @@ void Multiplayer::showPauseMenu(RenderWindow &window, bool &Game, bool &shouldRe
         " Resume Game",
         " Reset Game",
         " End Game"};
-    Font font;
-    font.loadFromFile("assets/fonts/arial.ttf");
+    AssetRef<Font> font = AssetCache::instance().font("assets/fonts/arial.ttf");
 
     // Title text
     Text titleText;
-    titleText.setFont(font);
+    titleText.setFont(*font);
     titleText.setString("PAUSED");
     titleText.setCharacterSize(40);
     titleText.setFillColor(Color::Cyan);
@@ -940,7 +448,7 @@ void Multiplayer::showPauseMenu(RenderWindow &window, bool &Game, bool &shouldRe
     Text texts[optionCount];
     for (int i = 0; i < optionCount; ++i)
     {
-        texts[i].setFont(font);
+        texts[i].setFont(*font);
         texts[i].setString(labels[i]);
         texts[i].setCharacterSize(30);
         texts[i].setFillColor(i == 0 ? Color::Yellow : Color::White);
@@ -1027,10 +535,9 @@ void Multiplayer::showPauseMenu(RenderWindow &window, bool &Game, bool &shouldRe
 void Multiplayer::displayGameOverScreen2(RenderWindow *window, int score, int score2, string u1, string u2)
 {
     // Prepare texts
-    Font font;
-    font.loadFromFile("assets/fonts/arial.ttf");
+    AssetRef<Font> font = AssetCache::instance().font("assets/fonts/arial.ttf");
     Text title, scoreText, prompt;
-    title.setFont(font);
+    title.setFont(*font);
     if (score == score2)
     {
         title.setString("Game Tie");
@@ -1052,7 +559,7 @@ void Multiplayer::displayGameOverScreen2(RenderWindow *window, int score, int sc
         title.setPosition(window->getSize().x / 2.f, 150.f);
     }
 
-    scoreText.setFont(font);
+    scoreText.setFont(*font);
     scoreText.setString(u1 + ": " + to_string(score) + "   |   " + u2 + ": " + to_string(score2));
     scoreText.setCharacterSize(32);
     scoreText.setFillColor(Color::White);
@@ -1062,7 +569,7 @@ void Multiplayer::displayGameOverScreen2(RenderWindow *window, int score, int sc
         scoreText.setPosition(window->getSize().x / 2.f, 250.f);
     }
 
-    prompt.setFont(font);
+    prompt.setFont(*font);
     prompt.setString("Press Esc to return to Main Menu");
     prompt.setCharacterSize(24);
     prompt.setFillColor(Color::Yellow);
@@ -0,0 +1,129 @@
+// Xonix Game
+// Streamed background music
+
+#include "../header/MusicPlayer.h"
+#include <iostream>
+
+using namespace std;
+
+MusicPlayer::MusicPlayer()
+    : tracks(nullptr), trackCount(0), current(0), ring(nullptr), chunkSamples(0), nextChunk(0), channels(0),
+      sampleRate(0)
+{
+}
+
+MusicPlayer::~MusicPlayer()
+{
+    stop();  // Joins the streaming thread before the ring goes
+    delete[] tracks;
+    delete[] ring;
+}
+
+bool MusicPlayer::openTrack(int index)
+{
+    if (!file.openFromFile(tracks[index]))
+        return false;
+    current = index;
+    return true;
+}
+
+bool MusicPlayer::setPlaylist(const string *paths, int count)
+{
+    stop();
+    delete[] tracks;
+    tracks = new string[count > 0 ? count : 1];
+    trackCount = 0;
+    channels = 0;
+    sampleRate = 0;
+
+    // Keep what opens and matches the format of the first track - the stream cannot change format
+    for (int i = 0; i < count; i++)
+    {
+        InputSoundFile probe;
+        if (!probe.openFromFile(paths[i]))
+            continue;
+        if (trackCount == 0)
+        {
+            channels = probe.getChannelCount();
+            sampleRate = probe.getSampleRate();
+        }
+        else if (probe.getChannelCount() != channels || probe.getSampleRate() != sampleRate)
+        {
+            cout << "Skipping " << paths[i] << ": format differs from " << tracks[0] << endl;
+            continue;
+        }
+        tracks[trackCount++] = paths[i];
+    }
+    if (trackCount == 0 || !openTrack(0))
+    {
+        trackCount = 0;
+        return false;
+    }
+
+    // A quarter second per chunk, whole frames only
+    int samples = (int)(sampleRate / 4 * channels);
+    if (samples != chunkSamples)
+    {
+        delete[] ring;
+        chunkSamples = samples;
+        ring = new Int16[RING_CHUNKS * chunkSamples];
+    }
+    nextChunk = 0;
+    initialize(channels, sampleRate);
+    return true;
+}
+
+// Streaming thread. Chunks rotate, so the one OpenAL was last given is never the one being decoded
+bool MusicPlayer::onGetData(Chunk &data)
+{
+    if (trackCount == 0)
+        return false;
+
+    Int16 *chunk = ring + nextChunk * chunkSamples;
+    nextChunk = (nextChunk + 1) % RING_CHUNKS;
+
+    Uint64 filled = file.read(chunk, chunkSamples);
+
+    // End of the track: carry on with the next one in the same chunk, wrapping to the first.
+    // A track that no longer opens is stepped over, not retried
+    int next = current;
+    int tries = 0;
+    while (filled < (Uint64)chunkSamples && tries < trackCount)
+    {
+        tries++;
+        next = (next + 1) % trackCount;
+        if (!openTrack(next))
+            continue;
+        filled += file.read(chunk + filled, chunkSamples - filled);
+    }
+
+    data.samples = chunk;
+    data.sampleCount = (size_t)filled;
+    return filled > 0;
+}
+
+void MusicPlayer::onSeek(Time offset)
+{
+    if (trackCount > 0)
+        file.seek(offset);
+}
+
+bool MusicPlayer::isOnlyTrack(const string &path) const
+{
+    return trackCount == 1 && tracks[0] == path;
+}
+
+int MusicPlayer::getTrack() const
+{
+    return current;
+}
+
+int MusicPlayer::getTrackCount() const
+{
+    return trackCount;
+}
+
+long long MusicPlayer::getBufferBytes() const
+{
+    return (long long)RING_CHUNKS * chunkSamples * sizeof(Int16);
+}
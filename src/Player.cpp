@@ -1,42 +1,125 @@
 // Xonix Game
-// Player class - uses LinkedList for friends, Stack for match history and requests
+// Player class - uses LinkedList for friends, Stack for requests, MatchHistory for games played
 
 #include "../header/Player.h"
+#include "../header/PlayerCache.h"
+#include "../header/PlayerStore.h"
+#include "../header/PlayerLog.h"
+#include "../header/MatchHistory.h"
 #include <iostream>
 #include <fstream>
+#include <ctime>
+#include <cstdio>
 
 using namespace std;
 
 Player::Player()
     : ID(""), username(""), password(""), regTime(""),
       highScore(0), highScoreLevel(1), powerUps(0),
-      noOfFriends(0), noOfMatches(0), noOfRequests(0),
-      preferredTheme(1)
+      noOfFriends(0), noOfRequests(0),
+      preferredTheme(1), logSequence(0), loadedFields(FIELD_ALL)
 {
 }
 
+Player::Player(const Player &other)
+    : highScore(0), highScoreLevel(1), powerUps(0),
+      noOfFriends(0), noOfRequests(0),
+      preferredTheme(1), logSequence(0), loadedFields(FIELD_ALL)
+{
+    copyFrom(other);
+}
+
+Player::Player(const Player &other, int fields)
+    : highScore(0), highScoreLevel(1), powerUps(0),
+      noOfFriends(0), noOfRequests(0),
+      preferredTheme(1), logSequence(0), loadedFields(FIELD_ALL)
+{
+    copyFrom(other, fields);
+}
+
+Player &Player::operator=(const Player &other)
+{
+    if (this != &other)
+    {
+        clearLists();
+        copyFrom(other);
+    }
+    return *this;
+}
+
 Player::~Player()
 {
+    clearLists();
 }
 
-void Player::addMatchUpdate(string opponent, bool win, int score, int powerUpsNow, int difficultyLevel)
+void Player::copyFrom(const Player &other, int fields)
 {
-    string match = "";
-    noOfMatches++;
+    ID = other.ID;
+    username = other.username;
+    password = other.password;
+    regTime = other.regTime;
+    highScore = other.highScore;
+    highScoreLevel = other.highScoreLevel;
+    powerUps = other.powerUps;
+    noOfFriends = other.noOfFriends;
+    noOfRequests = other.noOfRequests;
+    preferredTheme = other.preferredTheme;
+    logSequence = other.logSequence;
+    loadedFields = (other.loadedFields & fields) | FIELD_PROFILE;
 
-    if (opponent == "PC")
+    // Friends: append with a tail pointer so the copy stays O(n)
+    NodeList *tail = nullptr;
+    for (NodeList *curr = hasFields(FIELD_FRIENDS) ? other.friendList.head : nullptr; curr; curr = curr->next)
     {
-        match = "Single Player - Score: " + to_string(score) + " (Level " + to_string(difficultyLevel) + ")";
+        NodeList *n = new NodeList;
+        n->data = curr->data;
+        if (tail)
+            tail->next = n;
+        else
+            friendList.head = n;
+        tail = n;
     }
-    else
+
+    // Stack: rebuild top-to-bottom so the copy keeps the same order
+    node *rTail = nullptr;
+    for (node *curr = hasFields(FIELD_REQUESTS) ? other.friendRequest.head : nullptr; curr; curr = curr->next)
     {
-        if (win)
-            match = "vs " + opponent + " - WIN (Score: " + to_string(score) + ")";
+        node *n = new node;
+        n->data = curr->data;
+        if (rTail)
+            rTail->next = n;
         else
-            match = "vs " + opponent + " - LOSE (Score: " + to_string(score) + ")";
+            friendRequest.head = n;
+        rTail = n;
     }
+}
 
-    matchHistory.push(match);
+void Player::clearLists()
+{
+    while (friendList.head)
+    {
+        NodeList *temp = friendList.head;
+        friendList.head = temp->next;
+        delete temp;
+    }
+    while (friendRequest.head)
+    {
+        node *temp = friendRequest.head;
+        friendRequest.head = temp->next;
+        delete temp;
+    }
+}
+
+void Player::addMatchUpdate(int opponentId, bool win, int score, int powerUpsNow, int difficultyLevel)
+{
+    // History goes straight to its own file - the profile only keeps the hot stats
+    MatchRecord record = {};
+    record.timestamp = (int64_t)time(nullptr);
+    record.opponentId = opponentId;
+    record.score = score;
+    record.level = (int16_t)difficultyLevel;
+    record.result = opponentId == OPPONENT_NONE ? MATCH_SOLO : (win ? MATCH_WIN : MATCH_LOSS);
+    MatchHistory::instance().append(ID, record);
 
     if (score > highScore)
     {
@@ -45,13 +128,196 @@ void Player::addMatchUpdate(string opponent, bool win, int score, int powerUpsNo
     }
 
     powerUps = powerUpsNow;
-    saveToFile();
+    logMutation(LOG_ADD_MATCH, "", highScore, highScoreLevel, powerUps);
+}
+
+// Append one change to the mutation log instead of rewriting the profile
+void Player::logMutation(int op, const string &text, int a, int b, int c)
+{
+    PlayerLog &log = PlayerLog::instance();
+    unsigned int seq = log.append(ID, op, text, a, b, c);
+    if (seq == 0)
+    {
+        saveToFile();  // No log - fall back to a full write
+        return;
+    }
+
+    logSequence = seq;
+    LogEntry entry = {seq, op, text, a, b, c, nullptr};
+    PlayerCache::instance().applyLogged(*this, entry);
+
+    if (log.needsCompaction())
+        log.compact();
+}
+
+Player *Player::load(const string &id, int fields)
+{
+    PlayerStore &store = PlayerStore::instance();
+    Player *p = nullptr;
+    if (store.isOpen())
+        p = store.load(id, fields);
+    else
+    {
+        string s = "data/" + id + ".txt";
+        p = new Player;
+        p->ID = id;
+        if (!p->loadFromTextFile(s, fields))
+        {
+            cerr << "Error: File " << s << " not found!" << endl;
+            delete p;
+            return nullptr;
+        }
+    }
+
+    // Base profile plus changes not yet compacted into it
+    if (p)
+        PlayerLog::instance().apply(*p);
+    return p;
+}
+
+bool Player::hasFields(int fields) const
+{
+    return (loadedFields & fields) == fields;
+}
+
+// Pull in sections that were skipped at load time. Every change is logged as it
+// happens, so a fresh load agrees with this object on everything already present
+void Player::ensureLoaded(int fields)
+{
+    if (hasFields(fields))
+        return;
+
+    int missing = fields & ~loadedFields;
+    Player *fresh = load(ID, missing | FIELD_PROFILE);
+    if (!fresh)
+        return;
+
+    if (missing & FIELD_FRIENDS)
+    {
+        friendList.head = fresh->friendList.head;
+        fresh->friendList.head = nullptr;
+        noOfFriends = fresh->noOfFriends;
+    }
+    if (missing & FIELD_REQUESTS)
+    {
+        friendRequest.head = fresh->friendRequest.head;
+        fresh->friendRequest.head = nullptr;
+        noOfRequests = fresh->noOfRequests;
+    }
+    loadedFields |= missing;
+    delete fresh;
+}
+
+bool Player::saveToFile()
+{
+    // A full write needs every section
+    ensureLoaded(FIELD_ALL);
+
+    PlayerStore &store = PlayerStore::instance();
+    bool saved;
+    if (store.isOpen())
+        saved = store.save(*this);
+    else
+        saved = saveToTextFile("data/" + ID + ".txt");
+
+    // Write-through so cached views see the new profile
+    PlayerCache::instance().update(*this);
+    return saved;
 }
 
-void Player::saveToFile()
+// Legacy text format - also used by the database migrator/exporter
+// Unrequested sections are skipped line by line, never materialized
+bool Player::loadFromTextFile(const string &filename, int fields)
 {
-    string filename = "data/" + ID + ".txt";
-    ofstream outFile(filename);
+    ifstream p1(filename);
+    if (!p1.is_open())
+        return false;
+
+    string s;
+    getline(p1, username);
+    getline(p1, password);
+    getline(p1, regTime);
+    p1 >> highScore;
+    p1 >> highScoreLevel;
+    p1 >> powerUps;
+
+    // Load friends into linked list
+    loadedFields = fields | FIELD_PROFILE;
+    p1 >> noOfFriends;
+    p1.ignore();
+    NodeList *tail = nullptr;
+    for (int i = 0; i < noOfFriends; i++)
+    {
+        getline(p1, s);
+        if (!(fields & FIELD_FRIENDS))
+            continue;
+        NodeList *n = new NodeList;
+        n->data = s;
+        if (tail)
+            tail->next = n;
+        else
+            friendList.head = n;
+        tail = n;
+    }
+
+    // Match lines only appear in files written before MatchHistory - moved over once
+    int noOfLegacyMatches = 0;
+    p1 >> noOfLegacyMatches;
+    p1.ignore();
+    if (noOfLegacyMatches > 0)
+    {
+        string *legacy = new string[noOfLegacyMatches];
+        for (int i = 0; i < noOfLegacyMatches; i++)
+            getline(p1, legacy[i]);
+        if (!ID.empty())
+            MatchHistory::instance().importLegacy(ID, legacy, noOfLegacyMatches);
+        delete[] legacy;
+    }
+
+    // Load friend requests into stack
+    p1 >> noOfRequests;
+    p1.ignore();
+    if (!(fields & FIELD_REQUESTS))
+    {
+        for (int i = 0; i < noOfRequests; i++)
+            getline(p1, s);
+    }
+    else if (noOfRequests > 0)
+    {
+        string *tempRequests = new string[noOfRequests];
+        for (int i = 0; i < noOfRequests; i++)
+            getline(p1, tempRequests[i]);
+        for (int i = noOfRequests - 1; i >= 0; i--)
+            friendRequest.push(tempRequests[i]);
+        delete[] tempRequests;
+    }
+
+    if (p1 >> preferredTheme)
+    {
+        if (preferredTheme < 1 || preferredTheme > 5)
+            preferredTheme = 1;
+    }
+    else
+    {
+        preferredTheme = 1; // Default to Forest theme
+    }
+
+    // Optional trailing field, absent in files written before the mutation log
+    if (!(p1 >> logSequence))
+        logSequence = 0;
+
+    p1.close();
+    return true;
+}
+
+// Written beside the profile and renamed over it once on the disk - a crash mid-write
+// leaves the old profile, never half of the new one
+bool Player::saveToTextFile(const string &filename) const
+{
+    string tmpPath = filename + ".tmp";
+    ofstream outFile(tmpPath);
+    if (!outFile.is_open())
+        return false;
 
     outFile << username << endl;
     outFile << password << endl;
@@ -69,14 +335,8 @@ void Player::saveToFile()
         curr = curr->next;
     }
 
-    // Write match history (stack traversal)
-    outFile << noOfMatches << endl;
-    node *matchCurr = matchHistory.head;
-    while (matchCurr)
-    {
-        outFile << matchCurr->data << endl;
-        matchCurr = matchCurr->next;
-    }
+    // Match section kept empty for older readers - history lives in data/<id>.matches
+    outFile << 0 << endl;
 
     // Write friend requests (stack traversal)
     outFile << noOfRequests << endl;
@@ -88,22 +348,32 @@ void Player::saveToFile()
     }
 
     outFile << preferredTheme << endl;
+    outFile << logSequence << endl;
     outFile.close();
+    if (outFile.fail() || !MappedFile::replaceFile(tmpPath, filename))
+    {
+        cerr << "Error: couldn't write " << filename << endl;
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
 }
 
 void Player::addRequest(string request_id)
 {
+    ensureLoaded(FIELD_FRIENDS | FIELD_REQUESTS);
     if (friendRequest.search(request_id) || friendList.search(request_id))
         return;
     
     friendRequest.push(request_id);
     noOfRequests++;
-    saveToFile();
+    logMutation(LOG_ADD_REQUEST, request_id);
     cout << "Request Added successfully\n";
 }
 
 void Player::display()
 {
+    ensureLoaded(FIELD_ALL);
     cout << "Player ID: " << ID << endl;
     cout << "Username: " << username << endl;
     cout << "Password: " << password << endl;
@@ -114,22 +384,14 @@ void Player::display()
     cout << "\nFriends (" << noOfFriends << "): ";
     friendList.display();
 
-    cout << "\nMatch History (" << noOfMatches << "): ";
-    if (matchHistory.isEmpty())
-    {
+    MatchStats stats;
+    MatchHistory::instance().getStats(ID, stats);
+    cout << "\nMatch History (" << stats.count << "): ";
+    if (stats.count == 0)
         cout << "No matches played.\n";
-    }
     else
-    {
-        Stack temp = matchHistory;
-        while (!temp.isEmpty())
-        {
-            cout << temp.pop();
-            if (!temp.isEmpty())
-                cout << " <- ";
-        }
-        cout << endl;
-    }
+        cout << stats.wins << " won, " << stats.losses << " lost, " << stats.solo
+             << " single player, best " << stats.bestScore << endl;
 
     cout << "\nFriend Requests (" << noOfRequests << "): ";
     if (friendRequest.isEmpty())
@@ -151,36 +413,61 @@ void Player::display()
 
 void Player::rejectRequest(string id)
 {
+    ensureLoaded(FIELD_REQUESTS);
     if (friendRequest.search(id))
     {
         friendRequest.remove(id);
         noOfRequests--;
+        logMutation(LOG_REMOVE_REQUEST, id);
     }
-    saveToFile();
 }
 
 void Player::acceptRequest(string id)
 {
+    ensureLoaded(FIELD_FRIENDS | FIELD_REQUESTS);
     // Remove from requests
     if (friendRequest.search(id))
     {
         friendRequest.remove(id);
         cout << "Removed by " << ID << endl;
         noOfRequests--;
+        logMutation(LOG_REMOVE_REQUEST, id);
     }
     // Add to friends list if not already present
+    addFriend(id);
+}
+
+void Player::addFriend(string id)
+{
+    ensureLoaded(FIELD_FRIENDS);
+    if (friendList.search(id))
+        return;
+
+    friendList.insert(id);
+    noOfFriends++;
+    logMutation(LOG_ADD_FRIEND, id);
+}
+
+void Player::removeFriend(string id)
+{
+    ensureLoaded(FIELD_FRIENDS);
     if (!friendList.search(id))
-    {
-        friendList.insert(id);
-        noOfFriends++;
-        cout << "Added by " << ID << endl;
-    }
-    saveToFile();
+        return;
+
+    friendList.deleteNode(id);
+    noOfFriends--;
+    logMutation(LOG_REMOVE_FRIEND, id);
+}
+
+void Player::setPreferredTheme(int theme)
+{
+    preferredTheme = theme;
+    logMutation(LOG_SET_THEME, "", theme);
 }
 
 bool Player::changePassword(string newPassword)
 {
     password = newPassword;
-    saveToFile();
+    logMutation(LOG_SET_PASSWORD, newPassword);
     return true;
 }
@@ -0,0 +1,300 @@
+// Xonix Game
+// Player cache - LRU list + chained id index, snapshots are reference counted
+
+#include "../header/PlayerCache.h"
+#include "../header/PlayerLog.h"
+#include <iostream>
+
+using namespace std;
+
+PlayerSnapshot::PlayerSnapshot(const Player &p) : player(p), refs(1) {}
+
+PlayerView::PlayerView() : snapshot(nullptr) {}
+
+PlayerView::PlayerView(PlayerSnapshot *snap) : snapshot(snap)
+{
+    if (snapshot)
+        snapshot->refs++;
+}
+
+PlayerView::PlayerView(const PlayerView &other) : snapshot(other.snapshot)
+{
+    if (snapshot)
+        snapshot->refs++;
+}
+
+PlayerView &PlayerView::operator=(const PlayerView &other)
+{
+    if (snapshot != other.snapshot)
+    {
+        release();
+        snapshot = other.snapshot;
+        if (snapshot)
+            snapshot->refs++;
+    }
+    return *this;
+}
+
+PlayerView::~PlayerView()
+{
+    release();
+}
+
+void PlayerView::release()
+{
+    if (snapshot && --snapshot->refs == 0)
+        delete snapshot;
+    snapshot = nullptr;
+}
+
+PlayerView PlayerView::detached(const Player &p)
+{
+    PlayerSnapshot *snap = new PlayerSnapshot(p);
+    PlayerView view(snap);
+    snap->refs--;  // Only the view holds it
+    return view;
+}
+
+bool PlayerView::isValid() const
+{
+    return snapshot != nullptr;
+}
+
+const Player *PlayerView::operator->() const
+{
+    return &snapshot->player;
+}
+
+const Player &PlayerView::operator*() const
+{
+    return snapshot->player;
+}
+
+CacheEntry::CacheEntry(const string &playerId, PlayerSnapshot *snap)
+    : id(playerId), snapshot(snap), prev(nullptr), next(nullptr), chain(nullptr) {}
+
+PlayerCache::PlayerCache()
+    : head(nullptr), tail(nullptr), count(0), capacity(DEFAULT_CAPACITY),
+      hits(0), misses(0), evictions(0)
+{
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        buckets[i] = nullptr;
+}
+
+PlayerCache::~PlayerCache()
+{
+    clear();
+}
+
+PlayerCache &PlayerCache::instance()
+{
+    static PlayerCache cache;
+    return cache;
+}
+
+// Same polynomial hash as HashTable
+int PlayerCache::bucketOf(const string &id) const
+{
+    unsigned long hash = 0;
+    for (int i = 0; i < (int)id.length(); i++)
+        hash = hash * 31 + id[i];
+    return hash % BUCKET_COUNT;
+}
+
+CacheEntry *PlayerCache::find(const string &id) const
+{
+    CacheEntry *curr = buckets[bucketOf(id)];
+    while (curr && curr->id != id)
+        curr = curr->chain;
+    return curr;
+}
+
+void PlayerCache::unlink(CacheEntry *e)
+{
+    if (e->prev)
+        e->prev->next = e->next;
+    else
+        head = e->next;
+    if (e->next)
+        e->next->prev = e->prev;
+    else
+        tail = e->prev;
+    e->prev = e->next = nullptr;
+}
+
+void PlayerCache::pushFront(CacheEntry *e)
+{
+    e->prev = nullptr;
+    e->next = head;
+    if (head)
+        head->prev = e;
+    head = e;
+    if (!tail)
+        tail = e;
+}
+
+// Unlink from LRU list and bucket chain, drop the cache's reference
+void PlayerCache::removeEntry(CacheEntry *e)
+{
+    unlink(e);
+
+    int b = bucketOf(e->id);
+    CacheEntry *curr = buckets[b], *prev = nullptr;
+    while (curr && curr != e)
+    {
+        prev = curr;
+        curr = curr->chain;
+    }
+    if (curr)
+    {
+        if (prev)
+            prev->chain = curr->chain;
+        else
+            buckets[b] = curr->chain;
+    }
+
+    if (--e->snapshot->refs == 0)
+        delete e->snapshot;
+    delete e;
+    count--;
+}
+
+void PlayerCache::evictIfNeeded()
+{
+    while (count > capacity && tail)
+    {
+        removeEntry(tail);
+        evictions++;
+    }
+}
+
+PlayerView PlayerCache::lookup(const string &id)
+{
+    CacheEntry *e = find(id);
+    if (!e)
+    {
+        misses++;
+        return PlayerView();
+    }
+
+    hits++;
+    unlink(e);
+    pushFront(e);
+    return PlayerView(e->snapshot);
+}
+
+PlayerView PlayerCache::insert(const Player &p)
+{
+    CacheEntry *e = find(p.ID);
+    if (e)
+    {
+        // Swap in a new snapshot, old views keep the previous one alive
+        if (--e->snapshot->refs == 0)
+            delete e->snapshot;
+        e->snapshot = new PlayerSnapshot(p);
+        unlink(e);
+        pushFront(e);
+        return PlayerView(e->snapshot);
+    }
+
+    e = new CacheEntry(p.ID, new PlayerSnapshot(p));
+    int b = bucketOf(p.ID);
+    e->chain = buckets[b];
+    buckets[b] = e;
+    pushFront(e);
+    count++;
+
+    PlayerView view(e->snapshot);
+    evictIfNeeded();
+    return view;
+}
+
+// Only refreshes players that are already resident - saves don't pull new entries in
+void PlayerCache::update(const Player &p)
+{
+    CacheEntry *e = find(p.ID);
+    if (!e)
+        return;
+
+    // Cache only holds complete players - a projection cannot replace one
+    if (!p.hasFields(FIELD_ALL))
+    {
+        removeEntry(e);
+        return;
+    }
+
+    if (--e->snapshot->refs == 0)
+        delete e->snapshot;
+    e->snapshot = new PlayerSnapshot(p);
+}
+
+// Replay a logged mutation onto the cached copy instead of copying the whole profile
+void PlayerCache::applyLogged(const Player &p, const LogEntry &entry)
+{
+    CacheEntry *e = find(p.ID);
+    if (!e)
+        return;
+
+    // A live view must keep seeing its snapshot unchanged
+    if (e->snapshot->refs > 1)
+    {
+        update(p);
+        return;
+    }
+    PlayerLog::applyEntry(e->snapshot->player, entry);
+}
+
+void PlayerCache::invalidate(const string &id)
+{
+    CacheEntry *e = find(id);
+    if (e)
+        removeEntry(e);
+}
+
+void PlayerCache::clear()
+{
+    while (head)
+        removeEntry(head);
+}
+
+void PlayerCache::setCapacity(int cap)
+{
+    capacity = cap > 0 ? cap : 1;
+    evictIfNeeded();
+}
+
+int PlayerCache::getCapacity() const
+{
+    return capacity;
+}
+
+int PlayerCache::getSize() const
+{
+    return count;
+}
+
+long long PlayerCache::getHits() const
+{
+    return hits;
+}
+
+long long PlayerCache::getMisses() const
+{
+    return misses;
+}
+
+long long PlayerCache::getEvictions() const
+{
+    return evictions;
+}
+
+void PlayerCache::displayStats() const
+{
+    long long lookups = hits + misses;
+    cout << "\n===== Player Cache =====\n";
+    cout << "Entries: " << count << " / " << capacity << endl;
+    cout << "Hits: " << hits << "  Misses: " << misses << "  Evictions: " << evictions << endl;
+    if (lookups > 0)
+        cout << "Hit rate: " << (hits * 100 / lookups) << "%" << endl;
+    cout << "========================\n";
+}
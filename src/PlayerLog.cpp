@@ -0,0 +1,448 @@
+// Xonix Game
+// Write-ahead log - length + checksum framed records, replayed by sequence number
+
+#include "../header/PlayerLog.h"
+#include "../header/PlayerStore.h"
+#include "../header/MappedFile.h"
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+
+using namespace std;
+
+const char *PlayerLog::DEFAULT_PATH = "data/players.wal";
+
+static const char LOG_MAGIC[8] = {'X', 'N', 'X', 'W', 'A', 'L', '0', '1'};
+static const int LOG_HEADER_SIZE = 12;  // magic + first sequence number
+
+static uint32_t checksum(const char *data, uint32_t len)
+{
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void putU32(string &out, uint32_t v)
+{
+    out.append((const char *)&v, 4);
+}
+
+static uint32_t getU32(const char *p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// Whole-file rewrites go through a synced temp file, so a crash leaves the old log or
+// the new one - never a truncated header
+static bool replaceContents(const string &file, const char *bytes, size_t len)
+{
+    string tmpPath = file + ".tmp";
+    ofstream tmp(tmpPath, ios::binary | ios::trunc);
+    if (!tmp.is_open())
+        return false;
+    tmp.write(bytes, len);
+    tmp.close();
+    if (tmp.fail() || !MappedFile::replaceFile(tmpPath, file))
+    {
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Highest sequence folded into a text profile - those keep logSequence too, and a fresh
+// log must start past it or apply() would skip every new entry
+static uint32_t maxTextLogSequence(const string &dataDir)
+{
+    ifstream allPlayers(dataDir + "AllPlayers.txt");
+    if (!allPlayers.is_open())
+        return 0;
+
+    int count;
+    allPlayers >> count;
+    allPlayers.ignore();
+
+    uint32_t most = 0;
+    string id;
+    while (getline(allPlayers, id))
+    {
+        Player p;  // No ID - loading only reads, legacy matches are not imported
+        if (!id.empty() && p.loadFromTextFile(dataDir + id + ".txt", FIELD_PROFILE) && p.logSequence > most)
+            most = p.logSequence;
+    }
+    return most;
+}
+
+// Base profile without the log applied - the store when open, otherwise the text file
+static Player *loadBase(const string &id)
+{
+    PlayerStore &store = PlayerStore::instance();
+    if (store.isOpen())
+        return store.load(id);
+
+    Player *p = new Player;
+    p->ID = id;
+    if (!p->loadFromTextFile("data/" + id + ".txt"))
+    {
+        delete p;
+        return nullptr;
+    }
+    return p;
+}
+
+PlayerLog::PlayerLog() : nextSeq(1), bytes(0), pendingEntries(0)
+{
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        buckets[i] = nullptr;
+}
+
+PlayerLog::~PlayerLog()
+{
+    close();
+}
+
+PlayerLog &PlayerLog::instance()
+{
+    static PlayerLog log;
+    return log;
+}
+
+int PlayerLog::bucketOf(const string &id) const
+{
+    unsigned long hash = 0;
+    for (int i = 0; i < (int)id.length(); i++)
+        hash = hash * 31 + id[i];
+    return hash % BUCKET_COUNT;
+}
+
+PendingPlayer *PlayerLog::find(const string &id) const
+{
+    for (PendingPlayer *p = buckets[bucketOf(id)]; p; p = p->next)
+    {
+        if (p->id == id)
+            return p;
+    }
+    return nullptr;
+}
+
+void PlayerLog::remember(const string &id, LogEntry *entry)
+{
+    PendingPlayer *p = find(id);
+    if (!p)
+    {
+        int b = bucketOf(id);
+        p = new PendingPlayer{id, nullptr, nullptr, buckets[b]};
+        buckets[b] = p;
+    }
+
+    entry->next = nullptr;
+    if (p->tail)
+        p->tail->next = entry;
+    else
+        p->head = entry;
+    p->tail = entry;
+    pendingEntries++;
+}
+
+void PlayerLog::clearPending()
+{
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        while (buckets[i])
+        {
+            PendingPlayer *p = buckets[i];
+            buckets[i] = p->next;
+            while (p->head)
+            {
+                LogEntry *e = p->head;
+                p->head = e->next;
+                delete e;
+            }
+            delete p;
+        }
+    }
+    pendingEntries = 0;
+}
+
+bool PlayerLog::writeHeader(const string &file, uint32_t firstSeq)
+{
+    string header(LOG_MAGIC, 8);
+    putU32(header, firstSeq);
+    return replaceContents(file, header.data(), header.size());
+}
+
+bool PlayerLog::open(const string &logPath)
+{
+    close();
+    path = logPath;
+
+    ifstream in(path, ios::binary);
+    string data;
+    if (in.is_open())
+    {
+        in.seekg(0, ios::end);
+        data.resize((size_t)in.tellg());
+        in.seekg(0);
+        in.read(&data[0], data.size());
+        in.close();
+    }
+
+    if (data.size() < (size_t)LOG_HEADER_SIZE || memcmp(data.data(), LOG_MAGIC, 8) != 0)
+    {
+        // Fresh log - continue after the highest sequence already folded into a profile
+        PlayerStore &store = PlayerStore::instance();
+        size_t slash = path.find_last_of('/');
+        string dataDir = slash == string::npos ? "" : path.substr(0, slash + 1);
+        nextSeq = (store.isOpen() ? store.getMaxLogSequence() : maxTextLogSequence(dataDir)) + 1;
+        if (!writeHeader(path, nextSeq))
+        {
+            cerr << "Error: couldn't create " << path << endl;
+            return false;
+        }
+        data.clear();
+        bytes = LOG_HEADER_SIZE;
+    }
+    else
+    {
+        nextSeq = getU32(data.data() + 8);
+        size_t pos = LOG_HEADER_SIZE;
+
+        // Each record: [len][checksum] then [seq][op][a][b][c][idLen][id][text], text runs to the end
+        while (pos + 8 <= data.size())
+        {
+            uint32_t len = getU32(data.data() + pos);
+            uint32_t sum = getU32(data.data() + pos + 4);
+            const char *rec = data.data() + pos + 8;
+            if (len < 24 || pos + 8 + len > data.size() || checksum(rec, len) != sum ||
+                getU32(rec + 20) > len - 24)
+                break;
+
+            LogEntry *e = new LogEntry;
+            e->seq = getU32(rec);
+            e->op = (int)getU32(rec + 4);
+            e->a = (int)getU32(rec + 8);
+            e->b = (int)getU32(rec + 12);
+            e->c = (int)getU32(rec + 16);
+            uint32_t idLen = getU32(rec + 20);
+            string id(rec + 24, idLen);
+            e->text.assign(rec + 24 + idLen, len - 24 - idLen);
+
+            remember(id, e);
+            if (e->seq >= nextSeq)
+                nextSeq = e->seq + 1;
+            pos += 8 + len;
+        }
+
+        // Torn write from a crash - keep everything before it
+        if (pos != data.size())
+        {
+            cerr << "Warning: " << path << " has a damaged tail, dropping " << (data.size() - pos) << " bytes\n";
+            if (!replaceContents(path, data.data(), pos))
+            {
+                // Appending after the damage would hide every later record
+                cerr << "Error: couldn't rewrite " << path << endl;
+                close();
+                return false;
+            }
+        }
+        bytes = pos;
+    }
+
+    out.open(path, ios::binary | ios::app);
+    return out.is_open();
+}
+
+void PlayerLog::close()
+{
+    if (out.is_open())
+        out.close();
+    clearPending();
+    bytes = 0;
+}
+
+bool PlayerLog::isOpen() const
+{
+    return out.is_open();
+}
+
+uint32_t PlayerLog::append(const string &id, int op, const string &text, int a, int b, int c)
+{
+    if (!isOpen())
+        return 0;
+
+    string payload;
+    putU32(payload, nextSeq);
+    putU32(payload, (uint32_t)op);
+    putU32(payload, (uint32_t)a);
+    putU32(payload, (uint32_t)b);
+    putU32(payload, (uint32_t)c);
+    putU32(payload, (uint32_t)id.length());
+    payload += id;
+    payload += text;
+
+    string framed;
+    putU32(framed, (uint32_t)payload.size());
+    putU32(framed, checksum(payload.data(), (uint32_t)payload.size()));
+    framed += payload;
+
+    out.write(framed.data(), framed.size());
+    out.flush();
+    if (!out.good())
+    {
+        cerr << "Error: couldn't append to " << path << endl;
+        return 0;
+    }
+    // flush() only hands bytes to the OS; wait until they are on the disk, so a record the
+    // game was told is written survives a power cut. It is in the file either way - it will
+    // be replayed, so it still counts
+    if (!MappedFile::syncPath(path))
+        cerr << "Warning: couldn't sync " << path << " to disk" << endl;
+    bytes += framed.size();
+
+    LogEntry *e = new LogEntry{nextSeq, op, text, a, b, c, nullptr};
+    remember(id, e);
+    return nextSeq++;
+}
+
+void PlayerLog::applyEntry(Player &p, const LogEntry &entry)
+{
+    switch (entry.op)
+    {
+    case LOG_ADD_MATCH:
+        // The record itself is already in MatchHistory
+        p.highScore = entry.a;
+        p.highScoreLevel = entry.b;
+        p.powerUps = entry.c;
+        break;
+    // Entries are only logged when they change the list, so an unloaded
+    // section just moves its count
+    case LOG_ADD_FRIEND:
+        if (!p.hasFields(FIELD_FRIENDS))
+            p.noOfFriends++;
+        else if (!p.friendList.search(entry.text))
+        {
+            p.friendList.insert(entry.text);
+            p.noOfFriends++;
+        }
+        break;
+    case LOG_REMOVE_FRIEND:
+        if (!p.hasFields(FIELD_FRIENDS))
+            p.noOfFriends--;
+        else if (p.friendList.search(entry.text))
+        {
+            p.friendList.deleteNode(entry.text);
+            p.noOfFriends--;
+        }
+        break;
+    case LOG_ADD_REQUEST:
+        if (!p.hasFields(FIELD_REQUESTS))
+            p.noOfRequests++;
+        else if (!p.friendRequest.search(entry.text))
+        {
+            p.friendRequest.push(entry.text);
+            p.noOfRequests++;
+        }
+        break;
+    case LOG_REMOVE_REQUEST:
+        if (!p.hasFields(FIELD_REQUESTS))
+            p.noOfRequests--;
+        else if (p.friendRequest.search(entry.text))
+        {
+            p.friendRequest.remove(entry.text);
+            p.noOfRequests--;
+        }
+        break;
+    case LOG_SET_THEME:
+        p.preferredTheme = entry.a;
+        break;
+    case LOG_SET_HIGH_SCORE:
+        p.highScore = entry.a;
+        p.highScoreLevel = entry.b;
+        break;
+    case LOG_SET_PASSWORD:
+        p.password = entry.text;
+        break;
+    }
+    p.logSequence = entry.seq;
+}
+
+void PlayerLog::apply(Player &p) const
+{
+    PendingPlayer *pending = find(p.ID);
+    if (!pending)
+        return;
+
+    // Sequence check makes replay idempotent - entries already in the base are skipped
+    for (LogEntry *e = pending->head; e; e = e->next)
+    {
+        if (e->seq > p.logSequence)
+            applyEntry(p, *e);
+    }
+}
+
+// Fold pending entries into base profiles, then start an empty log after the last sequence
+int PlayerLog::compact()
+{
+    if (!isOpen())
+        return 0;
+
+    int folded = 0;
+    bool allSaved = true;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        for (PendingPlayer *pending = buckets[i]; pending; pending = pending->next)
+        {
+            Player *p = loadBase(pending->id);
+            if (!p)
+            {
+                cerr << "Warning: dropping log entries for missing player " << pending->id << endl;
+                continue;
+            }
+            apply(*p);
+            if (p->saveToFile())
+                folded++;
+            else
+                allSaved = false;
+            delete p;
+        }
+    }
+
+    // Profiles now carry every sequence number, so the old entries can go - once the
+    // profiles are on the disk, or a power cut here would lose both copies. Text profiles
+    // are synced as they are written; a profile that could not be written keeps the log
+    if (!allSaved)
+    {
+        cerr << "Warning: some profiles could not be saved, keeping " << path << endl;
+        return folded;
+    }
+    if (PlayerStore::instance().isOpen())
+        PlayerStore::instance().sync();
+    out.close();
+    clearPending();
+    if (!writeHeader(path, nextSeq))
+        cerr << "Error: couldn't truncate " << path << endl;
+    bytes = LOG_HEADER_SIZE;
+    out.open(path, ios::binary | ios::app);
+    return folded;
+}
+
+bool PlayerLog::needsCompaction() const
+{
+    return bytes > COMPACT_BYTES;
+}
+
+int PlayerLog::getPendingCount() const
+{
+    return pendingEntries;
+}
+
+uint64_t PlayerLog::getSize() const
+{
+    return bytes;
+}
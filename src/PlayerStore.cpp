@@ -0,0 +1,565 @@
+// Xonix Game
+// Binary player database - fixed records + append-only section heap in one mapped file
+
+#include "../header/PlayerStore.h"
+#include "../header/MatchHistory.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+using namespace std;
+
+const char *PlayerStore::DEFAULT_PATH = "data/players.db";
+
+static const char STORE_MAGIC[8] = {'X', 'N', 'X', 'P', 'L', 'D', 'B', '1'};
+static const uint32_t STORE_VERSION = 1;
+
+// Copy a string into a fixed field, always NUL terminated - oversizedField() has been checked
+static void copyField(char *dst, const string &src, int len)
+{
+    int n = (int)src.length() < len - 1 ? (int)src.length() : len - 1;
+    memcpy(dst, src.c_str(), n);
+    memset(dst + n, 0, len - n);
+}
+
+// Name of the first fixed-width field the player does not fit, nullptr if all fit.
+// Cutting a username short would lock the player out, so such players are refused
+static const char *oversizedField(const Player &p)
+{
+    if ((int)p.username.length() >= STORE_USERNAME_LEN)
+        return "username";
+    if ((int)p.password.length() >= STORE_PASSWORD_LEN)
+        return "password";
+    if ((int)p.regTime.length() >= STORE_REGTIME_LEN)
+        return "registration time";
+    return nullptr;
+}
+
+PlayerStore::PlayerStore() {}
+
+PlayerStore &PlayerStore::instance()
+{
+    static PlayerStore store;
+    return store;
+}
+
+StoreHeader *PlayerStore::header() const
+{
+    return (StoreHeader *)file.bytes();
+}
+
+PlayerRecord *PlayerStore::record(int slot) const
+{
+    return (PlayerRecord *)(file.bytes() + sizeof(StoreHeader)) + slot;
+}
+
+// Player IDs are allocated as consecutive integers, so the ID is the slot
+int PlayerStore::slotOf(const string &id) const
+{
+    if (id.empty() || id.length() > 9)
+        return -1;
+    int slot = 0;
+    for (int i = 0; i < (int)id.length(); i++)
+    {
+        if (id[i] < '0' || id[i] > '9')
+            return -1;
+        slot = slot * 10 + (id[i] - '0');
+    }
+    return slot;
+}
+
+bool PlayerStore::open(const string &dbPath)
+{
+    close();
+    path = dbPath;
+    if (!file.open(path, false))
+        return false;
+
+    StoreHeader *h = header();
+    if (file.getSize() < sizeof(StoreHeader) || memcmp(h->magic, STORE_MAGIC, 8) != 0 ||
+        h->version != STORE_VERSION || h->recordSize != sizeof(PlayerRecord) ||
+        h->heapEnd > file.getSize())
+    {
+        cerr << "Error: " << path << " is not a valid player database\n";
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool PlayerStore::create(const string &dbPath, int capacity)
+{
+    close();
+    path = dbPath;
+    remove(path.c_str());
+    if (!file.open(path, true))
+    {
+        cerr << "Error: couldn't create " << path << endl;
+        return false;
+    }
+    return initialize(capacity);
+}
+
+bool PlayerStore::initialize(int capacity)
+{
+    uint64_t heapStart = sizeof(StoreHeader) + (uint64_t)capacity * sizeof(PlayerRecord);
+    if (!file.resize(heapStart + 4096))
+        return false;
+
+    StoreHeader *h = header();
+    memcpy(h->magic, STORE_MAGIC, 8);
+    h->version = STORE_VERSION;
+    h->recordSize = sizeof(PlayerRecord);
+    h->capacity = capacity;
+    h->count = 0;
+    h->heapStart = heapStart;
+    h->heapEnd = heapStart;
+    h->wasted = 0;
+
+    for (int i = 0; i < capacity; i++)
+    {
+        memset(record(i), 0, sizeof(PlayerRecord));
+        record(i)->id = -1;
+    }
+    return true;
+}
+
+void PlayerStore::close()
+{
+    file.close();
+}
+
+bool PlayerStore::isOpen() const
+{
+    return file.isOpen() && file.bytes() != nullptr;
+}
+
+void PlayerStore::sync()
+{
+    file.sync();
+}
+
+// Grow the mapping geometrically so appends stay amortized O(1)
+bool PlayerStore::ensureHeap(uint64_t extra)
+{
+    uint64_t needed = header()->heapEnd + extra;
+    if (needed <= file.getSize())
+        return true;
+
+    uint64_t newSize = file.getSize() * 2;
+    if (newSize < needed)
+        newSize = needed;
+    return file.resize(newSize);
+}
+
+bool PlayerStore::ensureSlot(int slot)
+{
+    if (slot < (int)header()->capacity)
+        return true;
+
+    int newCapacity = header()->capacity * 2;
+    while (newCapacity <= slot)
+        newCapacity *= 2;
+    return rebuild(newCapacity);
+}
+
+// Copy live records and their current sections into a fresh file
+bool PlayerStore::rebuild(int newCapacity)
+{
+    string tmpPath = path + ".tmp";
+    PlayerStore fresh;
+    if (!fresh.create(tmpPath, newCapacity))
+        return false;
+
+    int capacity = header()->capacity;
+    string sections[3];
+    for (int i = 0; i < capacity; i++)
+    {
+        PlayerRecord *src = record(i);
+        if (src->id < 0)
+            continue;
+
+        PlayerRecord copy = *src;
+        int counts[3];
+        for (int s = 0; s < 3; s++)
+        {
+            SectionRef &ref = section(i, s);
+            sections[s].assign(ref.offset ? file.bytes() + ref.offset : "", ref.bytes);
+            counts[s] = ref.count;
+        }
+        copy.friends = copy.matches = copy.requests = SectionRef{0, 0, 0};
+        *fresh.record(i) = copy;
+        fresh.header()->count++;
+
+        for (int s = 0; s < 3; s++)
+        {
+            if (!fresh.writeSection(i, s, sections[s], counts[s]))
+                return false;
+        }
+    }
+    fresh.close();
+    close();
+
+    remove(path.c_str());
+    if (rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        cerr << "Error: couldn't replace " << path << endl;
+        return false;
+    }
+    return open(path);
+}
+
+void PlayerStore::compact()
+{
+    if (isOpen())
+        rebuild(header()->capacity);
+}
+
+// Section encoding: [uint32 length][bytes] per entry
+void PlayerStore::encodeList(const NodeList *head, int count, string &out) const
+{
+    out.clear();
+    for (int i = 0; head && i < count; i++, head = head->next)
+    {
+        uint32_t len = (uint32_t)head->data.length();
+        out.append((const char *)&len, sizeof(len));
+        out.append(head->data);
+    }
+}
+
+void PlayerStore::encodeStack(const node *head, int count, string &out) const
+{
+    out.clear();
+    for (int i = 0; head && i < count; i++, head = head->next)
+    {
+        uint32_t len = (uint32_t)head->data.length();
+        out.append((const char *)&len, sizeof(len));
+        out.append(head->data);
+    }
+}
+
+SectionRef &PlayerStore::section(int slot, int which) const
+{
+    PlayerRecord *r = record(slot);
+    if (which == 0)
+        return r->friends;
+    if (which == 1)
+        return r->matches;
+    return r->requests;
+}
+
+// Append the blob unless it matches what is already stored
+bool PlayerStore::writeSection(int slot, int which, const string &blob, int count)
+{
+    SectionRef &current = section(slot, which);
+    if (current.bytes == blob.length() && current.count == (uint32_t)count &&
+        (blob.empty() || memcmp(file.bytes() + current.offset, blob.data(), blob.length()) == 0))
+        return true;
+
+    // Growing the heap remaps the file, so look the ref up again afterwards
+    if (!ensureHeap(blob.length()))
+        return false;
+
+    SectionRef &ref = section(slot, which);
+    StoreHeader *h = header();
+    h->wasted += ref.bytes;
+
+    if (blob.empty())
+    {
+        ref.offset = 0;
+    }
+    else
+    {
+        memcpy(file.bytes() + h->heapEnd, blob.data(), blob.length());
+        ref.offset = h->heapEnd;
+        h->heapEnd += blob.length();
+    }
+    ref.bytes = (uint32_t)blob.length();
+    ref.count = (uint32_t)count;
+    return true;
+}
+
+void PlayerStore::readSection(const SectionRef &ref, string *out) const
+{
+    const char *p = file.bytes() + ref.offset;
+    const char *end = p + ref.bytes;
+    for (uint32_t i = 0; i < ref.count && p + sizeof(uint32_t) <= end; i++)
+    {
+        uint32_t len;
+        memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+        out[i].assign(p, len);
+        p += len;
+    }
+}
+
+// Records written before MatchHistory carry their games as strings - hand them
+// over once and drop the section, so later loads never touch them
+void PlayerStore::moveLegacyMatches(int slot, const string &id)
+{
+    int count = record(slot)->matches.count;
+    if (count == 0)
+        return;
+
+    string *lines = new string[count];
+    readSection(record(slot)->matches, lines);
+    MatchHistory::instance().importLegacy(id, lines, count);
+    delete[] lines;
+    writeSection(slot, 1, "", 0);
+}
+
+bool PlayerStore::exists(const string &id) const
+{
+    int slot = slotOf(id);
+    return isOpen() && slot >= 0 && slot < (int)header()->capacity && record(slot)->id == slot;
+}
+
+Player *PlayerStore::load(const string &id, int fields)
+{
+    if (!exists(id))
+        return nullptr;
+
+    int slot = slotOf(id);
+    moveLegacyMatches(slot, id);
+
+    const PlayerRecord *r = record(slot);
+    Player *p = new Player;
+    p->ID = id;
+    p->username = r->username;
+    p->password = r->password;
+    p->regTime = r->regTime;
+    p->highScore = r->highScore;
+    p->highScoreLevel = r->highScoreLevel;
+    p->powerUps = r->powerUps;
+    p->preferredTheme = r->preferredTheme;
+    p->logSequence = r->logSequence;
+    p->loadedFields = fields | FIELD_PROFILE;
+
+    p->noOfFriends = r->friends.count;
+    p->noOfRequests = r->requests.count;
+
+    int most = 0;
+    if ((fields & FIELD_FRIENDS) && p->noOfFriends > most)
+        most = p->noOfFriends;
+    if ((fields & FIELD_REQUESTS) && p->noOfRequests > most)
+        most = p->noOfRequests;
+    string *items = new string[most > 0 ? most : 1];
+
+    if (fields & FIELD_FRIENDS)
+    {
+        readSection(r->friends, items);
+        NodeList *tail = nullptr;
+        for (int i = 0; i < p->noOfFriends; i++)
+        {
+            NodeList *n = new NodeList;
+            n->data = items[i];
+            if (tail)
+                tail->next = n;
+            else
+                p->friendList.head = n;
+            tail = n;
+        }
+    }
+
+    // Section is stored top-first, push in reverse to rebuild the stack
+    if (fields & FIELD_REQUESTS)
+    {
+        readSection(r->requests, items);
+        for (int i = p->noOfRequests - 1; i >= 0; i--)
+            p->friendRequest.push(items[i]);
+    }
+
+    delete[] items;
+    return p;
+}
+
+bool PlayerStore::save(const Player &p)
+{
+    int slot = slotOf(p.ID);
+    if (!isOpen() || slot < 0)
+    {
+        cerr << "Error: cannot store player '" << p.ID << "'\n";
+        return false;
+    }
+    const char *tooLong = oversizedField(p);
+    if (tooLong)
+    {
+        cerr << "Error: player '" << p.ID << "' " << tooLong << " is too long for the database\n";
+        return false;
+    }
+    if (!ensureSlot(slot))
+        return false;
+
+    string blobs[3];
+    encodeList(p.friendList.head, p.noOfFriends, blobs[0]);
+    encodeStack(p.friendRequest.head, p.noOfRequests, blobs[2]);
+
+    PlayerRecord *r = record(slot);
+    if (r->id < 0)
+    {
+        header()->count++;
+        r->id = slot;
+    }
+    r->highScore = p.highScore;
+    r->highScoreLevel = p.highScoreLevel;
+    r->powerUps = p.powerUps;
+    r->preferredTheme = p.preferredTheme;
+    r->logSequence = p.logSequence;
+    copyField(r->username, p.username, STORE_USERNAME_LEN);
+    copyField(r->password, p.password, STORE_PASSWORD_LEN);
+    copyField(r->regTime, p.regTime, STORE_REGTIME_LEN);
+
+    if (!writeSection(slot, 0, blobs[0], p.noOfFriends) ||
+        !writeSection(slot, 1, blobs[1], 0) ||
+        !writeSection(slot, 2, blobs[2], p.noOfRequests))
+        return false;
+
+    // Reclaim space once more than half the heap is dead
+    StoreHeader *h = header();
+    if (h->wasted > 65536 && h->wasted * 2 > h->heapEnd - h->heapStart)
+        compact();
+    return true;
+}
+
+bool PlayerStore::setPreferredTheme(const string &id, int theme)
+{
+    if (!exists(id))
+        return false;
+    record(slotOf(id))->preferredTheme = theme;
+    return true;
+}
+
+int PlayerStore::getPreferredTheme(const string &id) const
+{
+    return exists(id) ? record(slotOf(id))->preferredTheme : 1;
+}
+
+bool PlayerStore::readUsername(const string &id, string &out) const
+{
+    if (!exists(id))
+        return false;
+    out = record(slotOf(id))->username;
+    return true;
+}
+
+// Highest log sequence folded into any record - seeds a fresh PlayerLog
+uint32_t PlayerStore::getMaxLogSequence() const
+{
+    uint32_t most = 0;
+    if (!isOpen())
+        return 0;
+    for (uint32_t i = 0; i < header()->capacity; i++)
+    {
+        if (record(i)->id >= 0 && record(i)->logSequence > most)
+            most = record(i)->logSequence;
+    }
+    return most;
+}
+
+int PlayerStore::getCount() const
+{
+    return isOpen() ? (int)header()->count : 0;
+}
+
+uint64_t PlayerStore::getWastedBytes() const
+{
+    return isOpen() ? header()->wasted : 0;
+}
+
+// Build a fresh database from the text files listed in AllPlayers.txt
+int PlayerStore::migrateFromText(const string &dataDir)
+{
+    ifstream allPlayers(dataDir + "AllPlayers.txt");
+    if (!allPlayers.is_open())
+    {
+        cerr << "Error opening " << dataDir << "AllPlayers.txt" << endl;
+        return -1;
+    }
+
+    int total = 0;
+    allPlayers >> total;
+    allPlayers.ignore();
+
+    // Check every profile before writing anything - a row that does not fit stops the
+    // migration, and the text files stay in use until it is fixed
+    streampos firstId = allPlayers.tellg();
+    int oversized = 0;
+    string id;
+    while (getline(allPlayers, id))
+    {
+        Player p;
+        if (id.empty() || !p.loadFromTextFile(dataDir + id + ".txt"))
+            continue;
+        const char *tooLong = oversizedField(p);
+        if (tooLong)
+        {
+            cerr << "Error: player " << id << " (" << p.username << "): " << tooLong
+                 << " is too long for the database\n";
+            oversized++;
+        }
+    }
+    if (oversized > 0)
+    {
+        cerr << "Migration stopped: " << oversized << " player(s) listed above must be shortened first\n";
+        return -1;
+    }
+    allPlayers.clear();
+    allPlayers.seekg(firstId);
+
+    if (!create(dataDir + "players.db", total > 64 ? total : 64))
+        return -1;
+
+    int migrated = 0;
+    int listed = 0;
+    // Count line covers the compacted part; newer registrations are appended below it
+    while (getline(allPlayers, id))
+    {
+        if (id.empty())
+            continue;
+        listed++;
+        Player p;
+        p.ID = id;
+        if (!p.loadFromTextFile(dataDir + id + ".txt"))
+        {
+            cerr << "Warning: skipping player " << id << " (file missing)\n";
+            continue;
+        }
+        if (save(p))
+            migrated++;
+    }
+    file.flush();
+
+    cout << "Migrated " << migrated << " of " << listed << " players to " << path << endl;
+    return migrated;
+}
+
+// Write every live record back out in the legacy text format
+int PlayerStore::exportToText(const string &dataDir)
+{
+    if (!isOpen())
+        return -1;
+
+    int capacity = header()->capacity;
+    int exported = 0;
+    ofstream allPlayers(dataDir + "AllPlayers.txt");
+    allPlayers << header()->count << endl;
+
+    for (int i = 0; i < capacity; i++)
+    {
+        if (record(i)->id < 0)
+            continue;
+
+        string id = to_string(i);
+        Player *p = load(id);
+        if (p && p->saveToTextFile(dataDir + id + ".txt"))
+        {
+            allPlayers << id << endl;
+            exported++;
+        }
+        delete p;
+    }
+
+    cout << "Exported " << exported << " players to " << dataDir << endl;
+    return exported;
+}
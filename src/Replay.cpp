@@ -0,0 +1,279 @@
+// Xonix Game
+// Input replays - recording, the file format and playback
+
+#include "../header/Replay.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+static const char REPLAY_MAGIC[4] = {'X', 'R', 'P', 'L'};
+static const int MAX_REPLAY_BYTES = 64 * 1024 * 1024;
+
+// Input codes: 0 no direction, 1-4 right, down, left, up; bit 3 is the power-up key
+static const int CODE_DX[5] = {0, 1, 0, -1, 0};
+static const int CODE_DY[5] = {0, 0, 1, 0, -1};
+static const int CODE_POWER_UP = 8;
+
+static int encodeInput(const EngineInput &input)
+{
+    int code = 0;
+    for (int d = 1; d < 5; d++)
+        if (input.dx == CODE_DX[d] && input.dy == CODE_DY[d])
+            code = d;
+    return code | (input.usePowerUp ? CODE_POWER_UP : 0);
+}
+
+static EngineInput decodeInput(int code)
+{
+    int d = code & 7;
+    if (d > 4)
+        d = 0;
+    return EngineInput(CODE_DX[d], CODE_DY[d], (code & CODE_POWER_UP) != 0);
+}
+
+// LEB128 - seven bits per byte, high bit set on all but the last
+static int putVarint(unsigned char *out, uint64_t value)
+{
+    int n = 0;
+    while (value >= 0x80)
+    {
+        out[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (unsigned char)value;
+    return n;
+}
+
+static bool getVarint(const unsigned char *in, int size, int &pos, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < size; shift += 7)
+    {
+        unsigned char byte = in[pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+Replay::Replay()
+    : seed(0), level(1), powerUps(0), ticks(0), score(0), eventCount(0),
+      events(nullptr), size(0), capacity(0), lastTick(0)
+{
+}
+
+Replay::~Replay()
+{
+    delete[] events;
+}
+
+void Replay::put(uint64_t value)
+{
+    if (size + 10 > capacity)
+    {
+        int grown = capacity ? capacity * 2 : 256;
+        unsigned char *bigger = new unsigned char[grown];
+        if (size)
+            memcpy(bigger, events, size);
+        delete[] events;
+        events = bigger;
+        capacity = grown;
+    }
+    size += putVarint(events + size, value);
+}
+
+void Replay::begin(uint64_t newSeed, int newLevel, int newPowerUps)
+{
+    seed = newSeed;
+    level = newLevel;
+    powerUps = newPowerUps;
+    ticks = 0;
+    score = 0;
+    eventCount = 0;
+    size = 0;
+    lastTick = 0;
+}
+
+void Replay::record(const EngineState &state, const EngineInput &input)
+{
+    const EnginePlayer &player = state.players[0];
+    bool turn = (input.dx != 0 || input.dy != 0) && (input.dx != player.dx || input.dy != player.dy);
+    if (!turn && !input.usePowerUp)
+        return;
+
+    int code = encodeInput(turn ? input : EngineInput(0, 0, true));
+    put((uint64_t)(state.ticks - lastTick) << 4 | code);
+    lastTick = state.ticks;
+    eventCount++;
+}
+
+void Replay::finish(long long endTicks, int endScore)
+{
+    ticks = endTicks;
+    score = endScore;
+}
+
+bool Replay::save(const string &path) const
+{
+    ofstream file(path, ios::binary);
+    if (!file.is_open())
+    {
+        cerr << "Error: Could not create replay file: " << path << endl;
+        return false;
+    }
+
+    unsigned char header[4 + 7 * 10];
+    int n = 0;
+    memcpy(header, REPLAY_MAGIC, 4);
+    n += 4;
+    n += putVarint(header + n, REPLAY_VERSION);
+    n += putVarint(header + n, seed);
+    n += putVarint(header + n, (uint64_t)level);
+    n += putVarint(header + n, (uint64_t)powerUps);
+    n += putVarint(header + n, (uint64_t)ticks);
+    n += putVarint(header + n, (uint64_t)score);
+    n += putVarint(header + n, (uint64_t)eventCount);
+
+    file.write((const char *)header, n);
+    if (size)
+        file.write((const char *)events, size);
+    return (bool)file;
+}
+
+bool Replay::load(const string &path)
+{
+    ifstream file(path, ios::binary | ios::ate);
+    if (!file.is_open())
+    {
+        cerr << "Error: Could not open replay file: " << path << endl;
+        return false;
+    }
+
+    long long length = file.tellg();
+    if (length < 4 || length > MAX_REPLAY_BYTES)
+    {
+        cerr << "Error: Invalid replay file: " << path << endl;
+        return false;
+    }
+    unsigned char *bytes = new unsigned char[length];
+    file.seekg(0);
+    file.read((char *)bytes, length);
+
+    int pos = 4;
+    uint64_t version = 0, values[6];
+    bool ok = file && memcmp(bytes, REPLAY_MAGIC, 4) == 0 && getVarint(bytes, length, pos, version) &&
+              version == REPLAY_VERSION;
+    for (int i = 0; ok && i < 6; i++)
+        ok = getVarint(bytes, length, pos, values[i]) && (i == 0 || values[i] <= 0x7FFFFFFF);
+    ok = ok && values[1] >= 1;
+    if (!ok)
+    {
+        cerr << "Error: Invalid replay file: " << path << endl;
+        delete[] bytes;
+        return false;
+    }
+
+    seed = values[0];
+    level = (int)values[1];
+    powerUps = (int)values[2];
+    ticks = (long long)values[3];
+    score = (int)values[4];
+    eventCount = (int)values[5];
+
+    delete[] events;
+    size = capacity = (int)(length - pos);
+    events = new unsigned char[capacity > 0 ? capacity : 1];
+    memcpy(events, bytes + pos, size);
+    lastTick = 0;
+    delete[] bytes;
+    return true;
+}
+
+uint64_t Replay::getSeed() const
+{
+    return seed;
+}
+
+int Replay::getLevel() const
+{
+    return level;
+}
+
+int Replay::getPowerUps() const
+{
+    return powerUps;
+}
+
+long long Replay::getTicks() const
+{
+    return ticks;
+}
+
+int Replay::getScore() const
+{
+    return score;
+}
+
+int Replay::getEventCount() const
+{
+    return eventCount;
+}
+
+int Replay::getEventBytes() const
+{
+    return size;
+}
+
+ReplayPlayer::ReplayPlayer(const Replay &replay)
+    : replay(replay), pos(0), eventsLeft(0), nextTick(-1)
+{
+}
+
+// A truncated or damaged event list simply ends early
+void ReplayPlayer::readEvent()
+{
+    uint64_t value;
+    if (eventsLeft <= 0 || !getVarint(replay.events, replay.size, pos, value))
+    {
+        nextTick = -1;
+        return;
+    }
+    eventsLeft--;
+    nextTick += (long long)(value >> 4);
+    nextInput = decodeInput((int)(value & 15));
+}
+
+void ReplayPlayer::start(XonixEngine &engine)
+{
+    engine.newGame(replay.level, replay.powerUps, replay.seed);
+    pos = 0;
+    eventsLeft = replay.eventCount;
+    nextTick = 0;
+    readEvent();
+}
+
+bool ReplayPlayer::step(XonixEngine &engine)
+{
+    const EngineState &state = engine.state();
+    if (!state.players[0].alive || state.ticks >= replay.ticks)
+        return false;
+
+    EngineInput input;
+    if (nextTick == state.ticks)
+    {
+        input = nextInput;
+        readEvent();
+    }
+    engine.step(input);
+    return true;
+}
+
+bool verifyReplay(const Replay &replay, XonixEngine &engine)
+{
+    ReplayPlayer player(replay);
+    player.start(engine);
+    while (player.step(engine))
+        ;
+    return engine.state().ticks == replay.getTicks() && engine.state().players[0].score == replay.getScore();
+}
@@ -0,0 +1,98 @@
+// Xonix Game
+// Event-driven redraw for menu screens
+
+#include "../header/ScreenPacer.h"
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+using namespace std;
+
+bool ScreenPacer::reporting = false;
+
+// CPU time used by the whole process so far, in seconds
+static double processCpuSeconds()
+{
+#ifdef _WIN32
+    FILETIME created, exited, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user))
+        return 0;
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return (k.QuadPart + u.QuadPart) * 1e-7;
+#else
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+ScreenPacer::ScreenPacer(const char *name)
+    : name(name), dirty(true), frames(0), events(0), cpuStart(processCpuSeconds())
+{
+}
+
+ScreenPacer::~ScreenPacer()
+{
+    if (!reporting)
+        return;
+
+    // Includes whatever the screen opened from here (a game, another menu)
+    double seconds = wall.getElapsedTime().asSeconds();
+    double cpu = processCpuSeconds() - cpuStart;
+    cout << "[screen] " << name << ": " << frames << " frames, " << events << " events in " << seconds
+         << " s, CPU " << cpu << " s (" << (seconds > 0 ? 100 * cpu / seconds : 0) << "%)" << endl;
+}
+
+bool ScreenPacer::nextEvent(Window &window, Event &event, Time timeout)
+{
+    bool got = window.pollEvent(event);
+    if (!got && !dirty)
+    {
+        if (timeout == Time::Zero)
+        {
+            got = window.waitEvent(event);
+        }
+        else
+        {
+            // No timed waitEvent in SFML 2 - nap in short steps until an event or the deadline
+            Clock waited;
+            while (!(got = window.pollEvent(event)) && window.isOpen() && waited.getElapsedTime() < timeout)
+                sf::sleep(milliseconds(10));
+        }
+    }
+
+    if (got)
+    {
+        events++;
+        if (event.type != Event::MouseMoved)
+            dirty = true;
+    }
+    return got;
+}
+
+void ScreenPacer::invalidate()
+{
+    dirty = true;
+}
+
+bool ScreenPacer::redraw()
+{
+    if (!dirty)
+        return false;
+    dirty = false;
+    frames++;
+    return true;
+}
+
+void ScreenPacer::setReporting(bool on)
+{
+    reporting = on;
+}
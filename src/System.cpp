@@ -2,8 +2,12 @@
 // System - manages players using dynamic array and hash table for O(1) lookup
 
 #include "../header/System.h"
+#include "../header/PlayerStore.h"
+#include "../header/UsernameIndex.h"
+#include "../header/PlayerLog.h"
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 
 using namespace std;
 
@@ -11,16 +15,51 @@ System::System()
 {
     ArrayOfPlayers = nullptr;
     noOfPlayers = 0;
+    capacityOfPlayers = 0;
+    compactedPlayers = 0;
+    nextPlayerId = 0;
     createArrayOfPlayers();
+    openPlayerStore();
     buildHashTable();
 }
 
+// Open data/players.db once per process, migrating the text files on first run,
+// then replay whatever the mutation log holds from the last session
+void System::openPlayerStore()
+{
+    PlayerStore &store = PlayerStore::instance();
+    if (!store.isOpen() && !store.open())
+    {
+        // Index the text profiles first so match history moved over during
+        // migration can resolve opponent usernames
+        buildHashTable();
+
+        // An empty database only for a fresh install - if text profiles could not be
+        // migrated they stay in charge rather than being hidden behind an empty one
+        if (store.migrateFromText() < 0 && (noOfPlayers > 0 || !store.create()))
+            cerr << "Player database unavailable, using text files\n";
+    }
+
+    PlayerLog &log = PlayerLog::instance();
+    if (log.isOpen())
+        return;
+    if (!log.open())
+    {
+        cerr << "Mutation log unavailable, saving full profiles\n";
+        return;
+    }
+    if (log.getPendingCount() > 0)
+        cout << "Recovered " << log.compact() << " player(s) from the mutation log\n";
+}
+
 System::~System()
 {
     if (ArrayOfPlayers)
         delete[] ArrayOfPlayers;
 }
 
+// AllPlayers.txt: a count line covering the compacted part, then one ID per line.
+// Registrations since the last compaction are appended after it
 void System::createArrayOfPlayers()
 {
     ifstream allPlayers("data/AllPlayers.txt");
@@ -32,159 +71,245 @@ void System::createArrayOfPlayers()
         return;
     }
 
-    allPlayers >> noOfPlayers;
+    allPlayers >> compactedPlayers;
     allPlayers.ignore();
 
-    if (noOfPlayers > 0)
+    if (compactedPlayers > 0)
     {
-        ArrayOfPlayers = new string[noOfPlayers];
-        for (int i = 0; i < noOfPlayers; i++)
-            getline(allPlayers, ArrayOfPlayers[i]);
+        capacityOfPlayers = compactedPlayers;
+        ArrayOfPlayers = new string[capacityOfPlayers];
+    }
+
+    string id;
+    while (getline(allPlayers, id))
+    {
+        if (id.empty())
+            continue;
+        if (noOfPlayers == capacityOfPlayers)
+            growArrayOfPlayers();
+        ArrayOfPlayers[noOfPlayers++] = id;
     }
     allPlayers.close();
+
+    nextPlayerId = loadNextPlayerId();
 }
 
-// Build hash table mapping username -> player ID
-void System::buildHashTable()
+// Double the ID array - amortized O(1) per registration
+void System::growArrayOfPlayers()
 {
-    playerHashTable.clear();
-
+    capacityOfPlayers = capacityOfPlayers > 0 ? capacityOfPlayers * 2 : 16;
+    string *temp = new string[capacityOfPlayers];
     for (int i = 0; i < noOfPlayers; i++)
-    {
-        Player *p = returnPlayer(ArrayOfPlayers[i]);
-        if (p)
-        {
-            playerHashTable.insert(p->username, p->ID, i);
-            delete p;
-        }
-    }
+        temp[i] = ArrayOfPlayers[i];
+    if (ArrayOfPlayers)
+        delete[] ArrayOfPlayers;
+    ArrayOfPlayers = temp;
 }
 
-// Load player from file - caller must delete returned pointer
-Player *System::returnPlayer(string id)
+// Next free ID from data/NextPlayerId.txt - recomputed from the ID list only if the file is missing
+int System::loadNextPlayerId()
 {
-    Player *p = new Player;
-    string s = "data/" + id + ".txt";
-    ifstream p1(s);
-    p->ID = id;
+    int next = -1;
+    ifstream counter("data/NextPlayerId.txt");
+    if (counter.is_open())
+        counter >> next;
 
-    if (!p1.is_open())
+    // IDs are appended in increasing order, so the last one guards against a stale counter
+    if (next >= 0)
     {
-        cerr << "Error: File " << s << " not found!" << endl;
-        delete p;
-        return nullptr;
+        if (noOfPlayers > 0 && atoi(ArrayOfPlayers[noOfPlayers - 1].c_str()) >= next)
+            next = atoi(ArrayOfPlayers[noOfPlayers - 1].c_str()) + 1;
+        return next;
     }
 
-    getline(p1, p->username);
-    getline(p1, p->password);
-    getline(p1, p->regTime);
-    p1 >> p->highScore;
-    p1 >> p->highScoreLevel;
-    p1 >> p->powerUps;
-
-    // Load friends into linked list
-    p1 >> p->noOfFriends;
-    p1.ignore();
-    for (int i = 0; i < p->noOfFriends; i++)
+    next = 0;
+    for (int i = 0; i < noOfPlayers; i++)
     {
-        getline(p1, s);
-        p->friendList.insert(s);
+        int existingId = atoi(ArrayOfPlayers[i].c_str());
+        if (existingId >= next)
+            next = existingId + 1;
     }
+    return next;
+}
 
-    // Load match history into stack (reverse order to maintain order)
-    p1 >> p->noOfMatches;
-    p1.ignore();
-    if (p->noOfMatches > 0)
+void System::saveNextPlayerId()
+{
+    ofstream counter("data/NextPlayerId.txt");
+    if (!counter.is_open())
     {
-        string *tempMatches = new string[p->noOfMatches];
-        for (int i = 0; i < p->noOfMatches; i++)
-            getline(p1, tempMatches[i]);
-        for (int i = p->noOfMatches - 1; i >= 0; i--)
-            p->matchHistory.push(tempMatches[i]);
-        delete[] tempMatches;
+        cerr << "Error: couldn't open NextPlayerId.txt for writing\n";
+        return;
     }
+    counter << nextPlayerId << endl;
+}
 
-    // Load friend requests into stack
-    p1 >> p->noOfRequests;
-    p1.ignore();
-    if (p->noOfRequests > 0)
+// Append one ID; rewrite the file once the appended tail outgrows the compacted part
+void System::appendPlayerId(const string &id)
+{
+    if (noOfPlayers > 2 * compactedPlayers + 16)
     {
-        string *tempRequests = new string[p->noOfRequests];
-        for (int i = 0; i < p->noOfRequests; i++)
-            getline(p1, tempRequests[i]);
-        for (int i = p->noOfRequests - 1; i >= 0; i--)
-            p->friendRequest.push(tempRequests[i]);
-        delete[] tempRequests;
+        savePlayers();
+        return;
     }
 
-    if (p1 >> p->preferredTheme)
+    ofstream allPlayers("data/AllPlayers.txt", ios::app);
+    if (!allPlayers.is_open())
     {
-        if (p->preferredTheme < 1 || p->preferredTheme > 5)
-            p->preferredTheme = 1;
+        cerr << "Error: couldn't open AllPlayers.txt for writing\n";
+        return;
     }
-    else
+    allPlayers << id << endl;
+}
+
+// Map the persistent username index; only rebuild when it is missing or stale
+void System::buildHashTable()
+{
+    UsernameIndex &index = UsernameIndex::instance();
+    if ((index.isOpen() || index.open()) && index.getListedCount() == noOfPlayers)
     {
-        p->preferredTheme = 1; // Default to Forest theme
+        playerHashTable.clear();
+        return;
     }
-
-    p1.close();
-    return p;
+    rebuildIndex();
 }
 
-// Validate login using hash table for O(1) lookup
-bool System::isValid(string Username, string Password)
+// Re-derive the index from the player records - the one O(N) pass
+void System::rebuildIndex()
 {
-    string playerId = playerHashTable.getPlayerId(Username);
+    playerHashTable.clear();
 
-    if (!playerId.empty())
+    UsernameIndex &index = UsernameIndex::instance();
+    cout << "Rebuilding username index (" << noOfPlayers << " players)\n";
+    uint32_t capacity = 1024;
+    while (capacity * 7 < (uint32_t)noOfPlayers * 10)
+        capacity *= 2;
+    bool indexed = index.create(UsernameIndex::DEFAULT_PATH, capacity);
+
+    string username;
+    for (int i = 0; i < noOfPlayers; i++)
     {
-        Player *p = returnPlayer(playerId);
-        if (p)
+        if (!readUsername(ArrayOfPlayers[i], username))
+            continue;
+
+        if (indexed)
         {
-            bool valid = (p->password == Password);
-            delete p;
-            return valid;
+            if (!index.insert(username, ArrayOfPlayers[i], i))
+                cerr << "Warning: player " << ArrayOfPlayers[i] << " not indexed (username over "
+                     << STORE_USERNAME_LEN - 1 << " characters)\n";
         }
+        else
+            playerHashTable.insert(username, ArrayOfPlayers[i], i);
     }
 
-    // Fallback to linear search
-    for (int i = 0; i < noOfPlayers; i++)
+    if (indexed)
     {
-        Player *p = returnPlayer(ArrayOfPlayers[i]);
-        if (p && p->username == Username)
-        {
-            bool valid = (p->password == Password);
-            delete p;
-            return valid;
-        }
-        if (p)
-            delete p;
+        index.setListedCount(noOfPlayers);
+        index.flush();
     }
+}
 
-    return false;
+// Usernames come straight from the mapped records - no per-player file opens
+bool System::readUsername(const string &id, string &username)
+{
+    PlayerStore &store = PlayerStore::instance();
+    if (store.isOpen())
+        return store.readUsername(id, username);
+
+    // Username is the first line - no need to parse (or convert) the rest of the profile
+    ifstream file("data/" + id + ".txt");
+    return file.is_open() && getline(file, username) && !username.empty();
 }
 
-string System::returnId(string Username)
+// Offline integrity check - every player must resolve through the index, and nothing else may
+int System::checkIndex()
 {
-    string id = playerHashTable.getPlayerId(Username);
-    if (!id.empty())
-        return id;
+    int problems = 0;
+    int resolved = 0;
+    string username;
 
-    // Fallback to linear search
     for (int i = 0; i < noOfPlayers; i++)
     {
-        Player *p = returnPlayer(ArrayOfPlayers[i]);
-        if (p && p->username == Username)
+        if (!readUsername(ArrayOfPlayers[i], username))
+        {
+            cout << "Player " << ArrayOfPlayers[i] << ": record missing\n";
+            problems++;
+            continue;
+        }
+
+        string indexed = lookupId(username);
+        if (indexed != ArrayOfPlayers[i])
         {
-            id = p->ID;
-            delete p;
-            return id;
+            cout << "Player " << ArrayOfPlayers[i] << " (" << username << "): index has "
+                 << (indexed.empty() ? "no entry" : "ID " + indexed) << endl;
+            problems++;
         }
-        if (p)
-            delete p;
+        else
+            resolved++;
     }
 
-    return "";
+    UsernameIndex &index = UsernameIndex::instance();
+    int entries = index.isOpen() ? index.getCount() : playerHashTable.getCount();
+    if (entries != resolved)
+    {
+        cout << "Index holds " << entries << " entries, " << resolved << " players resolve through it\n";
+        problems++;
+    }
+
+    cout << "Index check: " << noOfPlayers << " players, " << problems << " problem(s)\n";
+    return problems;
+}
+
+// Username -> ID from the mapped index, or the in-memory table if it could not be opened
+string System::lookupId(const string &username)
+{
+    UsernameIndex &index = UsernameIndex::instance();
+    if (index.isOpen())
+        return index.getPlayerId(username);
+    return playerHashTable.getPlayerId(username);
+}
+
+// Mutable copy of a player - caller must delete returned pointer.
+// Sections outside fields are not copied; Player::ensureLoaded brings them in later
+Player *System::returnPlayer(string id, int fields)
+{
+    PlayerView view = viewPlayer(id, fields);
+    if (!view.isValid())
+        return nullptr;
+    return new Player(*view, fields);
+}
+
+// Read-only view served from the shared cache, loads from disk on miss.
+// The cache only keeps complete players, so a projection miss gets a private snapshot
+PlayerView System::viewPlayer(const string &id, int fields)
+{
+    PlayerCache &cache = PlayerCache::instance();
+    PlayerView view = cache.lookup(id);
+    if (view.isValid())
+        return view;
+
+    Player *p = Player::load(id, fields);
+    if (!p)
+        return PlayerView();
+
+    view = p->hasFields(FIELD_ALL) ? cache.insert(*p) : PlayerView::detached(*p);
+    delete p;
+    return view;
+}
+
+// Validate login - the index is authoritative, unknown usernames never touch the disk
+bool System::isValid(string Username, string Password)
+{
+    string playerId = lookupId(Username);
+    if (playerId.empty())
+        return false;
+
+    PlayerView p = viewPlayer(playerId, FIELD_PROFILE);
+    return p.isValid() && p->password == Password;
+}
+
+string System::returnId(string Username)
+{
+    return lookupId(Username);
 }
 
 string System::returnIdByUsername(const string &username)
@@ -194,78 +319,68 @@ string System::returnIdByUsername(const string &username)
 
 bool System::usernameExists(string Username)
 {
-    if (playerHashTable.exists(Username))
-        return true;
-
-    for (int i = 0; i < noOfPlayers; i++)
-    {
-        Player *p = returnPlayer(ArrayOfPlayers[i]);
-        if (p && p->username == Username)
-        {
-            delete p;
-            return true;
-        }
-        if (p)
-            delete p;
-    }
-
-    return false;
+    return !lookupId(Username).empty();
 }
 
-// Register new player - resize array, create file, update hash table
-void System::addPlayer(string regtime, string Username, string Password)
+// Register new player - O(1) ID allocation, append to the ID list and index
+bool System::addPlayer(string regtime, string Username, string Password)
 {
-    // Find next available ID
-    int newId = 0;
-    for (int i = 0; i < noOfPlayers; i++)
+    // The database and the username index both hold names in a fixed-width field
+    if ((int)Username.length() >= STORE_USERNAME_LEN)
     {
-        int existingId = 0;
-        for (int j = 0; j < (int)ArrayOfPlayers[i].length(); j++)
-        {
-            if (ArrayOfPlayers[i][j] >= '0' && ArrayOfPlayers[i][j] <= '9')
-                existingId = existingId * 10 + (ArrayOfPlayers[i][j] - '0');
-        }
-        if (existingId >= newId)
-            newId = existingId + 1;
+        cout << "Error: username " << Username << " is too long\n";
+        return false;
     }
 
-    // Resize dynamic array
-    string *temp = new string[noOfPlayers + 1];
-    if (ArrayOfPlayers)
+    // Re-read the counter so a second System in this process never hands out the same ID
+    int persisted = loadNextPlayerId();
+    if (persisted > nextPlayerId)
+        nextPlayerId = persisted;
+    int newId = nextPlayerId++;
+    saveNextPlayerId();
+    string id = to_string(newId);
+
+    // Index first - a player nobody can look up by name must not be written
+    UsernameIndex &index = UsernameIndex::instance();
+    if (index.isOpen())
     {
-        for (int i = 0; i < noOfPlayers; i++)
-            temp[i] = ArrayOfPlayers[i];
-        delete[] ArrayOfPlayers;
+        if (!index.insert(Username, id, noOfPlayers))
+        {
+            cout << "Error: couldn't index username " << Username << endl;
+            return false;
+        }
     }
+    else
+        playerHashTable.insert(Username, id, noOfPlayers);
 
-    temp[noOfPlayers] = to_string(newId);
-    ArrayOfPlayers = temp;
+    if (noOfPlayers == capacityOfPlayers)
+        growArrayOfPlayers();
+    ArrayOfPlayers[noOfPlayers] = id;
     noOfPlayers++;
+    if (index.isOpen())
+        index.setListedCount(noOfPlayers);
 
     Player *newPlayer = new Player;
     newPlayer->username = Username;
     newPlayer->password = Password;
-    newPlayer->ID = to_string(newId);
+    newPlayer->ID = id;
     newPlayer->regTime = regtime;
     newPlayer->saveToFile();
 
-    playerHashTable.insert(Username, newPlayer->ID, noOfPlayers - 1);
-
-    savePlayers();
+    appendPlayerId(newPlayer->ID);
     delete newPlayer;
 
     cout << "Player " << Username << " registered with ID " << newId << endl;
+    return true;
 }
 
 bool System::sendFriendRequest(const string &senderId, const string &receiverId)
 {
-    Player *sender = returnPlayer(senderId);
-    Player *receiver = returnPlayer(receiverId);
+    PlayerView sender = viewPlayer(senderId, FIELD_PROFILE | FIELD_FRIENDS);
+    Player *receiver = returnPlayer(receiverId, FIELD_PROFILE | FIELD_FRIENDS | FIELD_REQUESTS);
 
-    if (!sender || !receiver)
+    if (!sender.isValid() || !receiver)
     {
-        if (sender)
-            delete sender;
         if (receiver)
             delete receiver;
         cout << "Error: Player not found.\n";
@@ -276,7 +391,6 @@ bool System::sendFriendRequest(const string &senderId, const string &receiverId)
     if (sender->friendList.search(receiverId))
     {
         cout << "You are already friends with this player.\n";
-        delete sender;
         delete receiver;
         return false;
     }
@@ -285,7 +399,6 @@ bool System::sendFriendRequest(const string &senderId, const string &receiverId)
     if (receiver->friendRequest.search(senderId))
     {
         cout << "Friend request already pending.\n";
-        delete sender;
         delete receiver;
         return false;
     }
@@ -293,7 +406,6 @@ bool System::sendFriendRequest(const string &senderId, const string &receiverId)
     // Add request to receiver's pending requests
     receiver->addRequest(senderId);
 
-    delete sender;
     delete receiver;
 
     cout << "Friend request sent successfully!\n";
@@ -303,48 +415,27 @@ bool System::sendFriendRequest(const string &senderId, const string &receiverId)
 bool System::acceptFriendRequest(const string &acceptorId, const string &requesterId)
 {
     // Load acceptor (the one accepting the request)
-    Player *acceptor = returnPlayer(acceptorId);
+    Player *acceptor = returnPlayer(acceptorId, FIELD_PROFILE | FIELD_FRIENDS | FIELD_REQUESTS);
     if (!acceptor)
     {
         cout << "Error: Acceptor player not found.\n";
         return false;
     }
 
-    // Step 1: Remove request from acceptor's pending requests
-    if (acceptor->friendRequest.search(requesterId))
-    {
-        acceptor->friendRequest.remove(requesterId);
-        acceptor->noOfRequests--;
-    }
-
-    // Step 2: Add requester to acceptor's friends list
-    if (!acceptor->friendList.search(requesterId))
-    {
-        acceptor->friendList.insert(requesterId);
-        acceptor->noOfFriends++;
-    }
-
-    // Step 3: Save acceptor's data
-    acceptor->saveToFile();
+    // Step 1-2: Drop the pending request and add requester to acceptor's friends (logged)
+    acceptor->acceptRequest(requesterId);
     delete acceptor;
 
     // Load requester (the one who sent the request)
-    Player *requester = returnPlayer(requesterId);
+    Player *requester = returnPlayer(requesterId, FIELD_PROFILE | FIELD_FRIENDS);
     if (!requester)
     {
         cout << "Error: Requester player not found.\n";
         return false;
     }
 
-    // Step 4: Add acceptor to requester's friends list
-    if (!requester->friendList.search(acceptorId))
-    {
-        requester->friendList.insert(acceptorId);
-        requester->noOfFriends++;
-    }
-
-    // Step 5: Save requester's data
-    requester->saveToFile();
+    // Step 3: Add acceptor to requester's friends list (logged)
+    requester->addFriend(acceptorId);
     delete requester;
 
     cout << "Friend request accepted! Both players are now friends.\n";
@@ -353,7 +444,7 @@ bool System::acceptFriendRequest(const string &acceptorId, const string &request
 
 bool System::rejectFriendRequest(const string &rejecterId, const string &requesterId)
 {
-    Player *rejecter = returnPlayer(rejecterId);
+    Player *rejecter = returnPlayer(rejecterId, FIELD_PROFILE | FIELD_REQUESTS);
 
     if (!rejecter)
     {
@@ -384,6 +475,7 @@ void System::savePlayers()
         allPlayers << ArrayOfPlayers[i] << endl;
     }
     allPlayers.close();
+    compactedPlayers = noOfPlayers;
 }
 
 void System::displayArrayOfPlayers()
@@ -397,9 +489,15 @@ void System::displayArrayOfPlayers()
 
 void System::displayHashTable()
 {
+    UsernameIndex::instance().display();
     playerHashTable.display();
 }
 
+void System::displayCacheStats()
+{
+    PlayerCache::instance().displayStats();
+}
+
 bool System::isIdPresent(const string &id)
 {
     for (int i = 0; i < noOfPlayers; i++)
@@ -419,7 +517,7 @@ bool System::idExist(const string &id)
 
 Player *System::getPlayerByUsername(const string &username)
 {
-    string playerId = playerHashTable.getPlayerId(username);
+    string playerId = lookupId(username);
     if (playerId.empty())
     {
         return nullptr;
@@ -0,0 +1,153 @@
+// Xonix Game
+// Work-stealing thread pool
+
+#include "../header/TaskPool.h"
+
+// Index of the pool worker running on this thread, -1 elsewhere
+static thread_local int currentWorker = -1;
+static thread_local const TaskPool *currentPool = nullptr;
+
+TaskPool::TaskPool(int threads)
+    : queues(nullptr), workers(nullptr), workerCount(0), queued(0), unfinished(0), nextQueue(0), stopping(false)
+{
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0)
+        threads = 1;
+
+    workerCount = threads;
+    queues = new Queue[workerCount];
+    for (int i = 0; i < workerCount; i++)
+    {
+        queues[i].capacity = 64;
+        queues[i].items = new Task[queues[i].capacity];
+        queues[i].head = 0;
+        queues[i].count = 0;
+    }
+
+    workers = new std::thread[workerCount];
+    for (int i = 0; i < workerCount; i++)
+        workers[i] = std::thread(&TaskPool::workerLoop, this, i);
+}
+
+TaskPool::~TaskPool()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (int i = 0; i < workerCount; i++)
+        workers[i].join();
+
+    for (int i = 0; i < workerCount; i++)
+        delete[] queues[i].items;
+    delete[] queues;
+    delete[] workers;
+}
+
+int TaskPool::threadCount() const
+{
+    return workerCount;
+}
+
+void TaskPool::push(int index, const Task &task)
+{
+    Queue &q = queues[index];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.count == q.capacity)
+    {
+        Task *grown = new Task[q.capacity * 2];
+        for (int i = 0; i < q.count; i++)
+            grown[i] = q.items[(q.head + i) % q.capacity];
+        delete[] q.items;
+        q.items = grown;
+        q.capacity *= 2;
+        q.head = 0;
+    }
+    q.items[(q.head + q.count) % q.capacity] = task;
+    q.count++;
+}
+
+bool TaskPool::popBack(int index, Task &task)
+{
+    Queue &q = queues[index];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.count == 0)
+        return false;
+    q.count--;
+    task = q.items[(q.head + q.count) % q.capacity];
+    return true;
+}
+
+bool TaskPool::stealFront(int index, Task &task)
+{
+    Queue &q = queues[index];
+    std::unique_lock<std::mutex> guard(q.lock, std::try_to_lock);
+    if (!guard.owns_lock() || q.count == 0)
+        return false;
+    task = q.items[q.head];
+    q.head = (q.head + 1) % q.capacity;
+    q.count--;
+    return true;
+}
+
+// Own deque first (recently pushed work is still in cache), then walk the others
+bool TaskPool::findTask(int self, Task &task)
+{
+    if (popBack(self, task))
+        return true;
+    for (int i = 1; i < workerCount; i++)
+        if (stealFront((self + i) % workerCount, task))
+            return true;
+    return false;
+}
+
+void TaskPool::submit(TaskFn fn, void *arg)
+{
+    unfinished.fetch_add(1);
+    // Unsigned, so the round robin wraps instead of going negative after 2^31 submits
+    int index = (currentPool == this && currentWorker >= 0) ? currentWorker
+                                                            : (int)(nextQueue.fetch_add(1) % (unsigned)workerCount);
+    queued.fetch_add(1);  // Before the push, so the count never dips below zero
+    push(index, Task{fn, arg});
+
+    // Take the lock so a worker between its check and its wait cannot miss this
+    std::lock_guard<std::mutex> guard(sleepLock);
+    wake.notify_one();
+}
+
+void TaskPool::wait()
+{
+    std::unique_lock<std::mutex> guard(sleepLock);
+    done.wait(guard, [this] { return unfinished.load() == 0; });
+}
+
+void TaskPool::workerLoop(int index)
+{
+    currentWorker = index;
+    currentPool = this;
+
+    while (true)
+    {
+        Task task;
+        if (findTask(index, task))
+        {
+            queued.fetch_sub(1);
+            task.fn(task.arg);
+            if (unfinished.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                done.notify_all();
+            }
+            continue;
+        }
+
+        // A failed try-lock steal can miss work, so sleep only when nothing is queued anywhere
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0)
+            return;
+    }
+}
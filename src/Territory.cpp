@@ -0,0 +1,294 @@
+// Xonix Game
+// Incremental capture - regions grow from the trail in lockstep and merge through union-find
+
+#include "../header/Territory.h"
+#include <climits>
+
+enum RegionState : unsigned char
+{
+    REGION_OPEN,     // Still growing
+    REGION_REACHED,  // Holds an enemy - stays empty
+    REGION_ENCLOSED  // Ran out of cells without meeting an enemy - becomes wall
+};
+
+Territory::Territory()
+    : rows(0), cols(0), capacity(0), synced(false), trail(nullptr), trailCount(0), epoch(0),
+      stamp(nullptr), enemyStamp(nullptr), owner(nullptr), link(nullptr), visited(nullptr), visitedCount(0),
+      parent(nullptr), head(nullptr), tail(nullptr), state(nullptr), active(nullptr)
+{
+}
+
+Territory::~Territory()
+{
+    release();
+}
+
+void Territory::release()
+{
+    delete[] trail;
+    delete[] stamp;
+    delete[] enemyStamp;
+    delete[] owner;
+    delete[] link;
+    delete[] visited;
+    delete[] parent;
+    delete[] head;
+    delete[] tail;
+    delete[] state;
+    delete[] active;
+}
+
+void Territory::allocate(int cells)
+{
+    if (cells <= capacity)
+        return;
+
+    release();
+    trail = new int[cells];
+    stamp = new int[cells]();
+    enemyStamp = new int[cells]();
+    owner = new int[cells];
+    link = new int[cells];
+    visited = new int[cells];
+    parent = new int[cells];
+    head = new int[cells];
+    tail = new int[cells];
+    state = new unsigned char[cells];
+    active = new int[cells];
+    capacity = cells;
+    epoch = 0;
+}
+
+// Stamps from earlier captures go stale on their own; clear them only on wrap-around
+void Territory::nextEpoch()
+{
+    if (epoch == INT_MAX)
+    {
+        for (int i = 0; i < capacity; i++)
+            stamp[i] = enemyStamp[i] = 0;
+        epoch = 0;
+    }
+    epoch++;
+}
+
+void Territory::reset()
+{
+    synced = false;
+    trailCount = 0;
+}
+
+void Territory::layTrail(int cell)
+{
+    if (!synced)
+        return;
+    if (trailCount >= rows * cols)
+    {
+        synced = false;
+        return;
+    }
+    trail[trailCount++] = cell;
+}
+
+int Territory::find(int region)
+{
+    while (parent[region] != region)
+    {
+        parent[region] = parent[parent[region]];  // Path halving
+        region = parent[region];
+    }
+    return region;
+}
+
+// Take a free cell for a region and queue it on the region's frontier
+void Territory::claim(int cell, int region)
+{
+    stamp[cell] = epoch;
+    owner[cell] = region;
+    visited[visitedCount++] = cell;
+
+    link[cell] = -1;
+    if (head[region] < 0)
+        head[region] = cell;
+    else
+        link[tail[region]] = cell;
+    tail[region] = cell;
+
+    if (enemyStamp[cell] == epoch)
+        state[region] = REGION_REACHED;
+}
+
+int Territory::newRegion(int cell)
+{
+    int region = visitedCount;  // One region per seed cell, so ids stay below the cell count
+    parent[region] = region;
+    head[region] = tail[region] = -1;
+    state[region] = REGION_OPEN;
+    claim(cell, region);
+    return region;
+}
+
+// Two regions met: they are one area, so they share an answer and a frontier
+void Territory::merge(int into, int other)
+{
+    parent[other] = into;
+    if (state[other] == REGION_REACHED)
+        state[into] = REGION_REACHED;
+
+    if (head[other] >= 0)
+    {
+        if (head[into] < 0)
+            head[into] = head[other];
+        else
+            link[tail[into]] = head[other];
+        tail[into] = tail[other];
+    }
+}
+
+// The fast path needs an unbroken record and every enemy on a free cell; an enemy standing
+// on a trail (the player is about to die) is left to the full resolve, which ignores it
+bool Territory::canTrack(const int *grid, int rowCount, int colCount, const int *seeds, int seedCount) const
+{
+    if (!synced || rowCount != rows || colCount != cols || seedCount <= 0)
+        return false;
+
+    for (int i = 0; i < seedCount; i++)
+        if (seeds[i] < 0 || seeds[i] >= rows * cols || grid[seeds[i]] != 0)
+            return false;
+
+    for (int i = 0; i < trailCount; i++)
+        if (grid[trail[i]] != 2 && grid[trail[i]] != 3)
+            return false;
+    return true;
+}
+
+// Whole-board capture, then pick up whatever trails are left so the next capture can be local
+int Territory::resync(int *grid, int rowCount, int colCount, int trailValue, const int *seeds, int seedCount)
+{
+    int captured = full.resolveCapture(grid, rowCount, colCount, trailValue, seeds, seedCount);
+
+    allocate(rowCount * colCount);
+    rows = rowCount;
+    cols = colCount;
+    trailCount = 0;
+    for (int i = 0; i < rows * cols; i++)
+        if (grid[i] == 2 || grid[i] == 3)
+            trail[trailCount++] = i;
+    synced = true;
+    return captured;
+}
+
+int Territory::resolveCapture(int *grid, int rowCount, int colCount, int trailValue, const int *seeds, int seedCount)
+{
+    if (!canTrack(grid, rowCount, colCount, seeds, seedCount))
+        return resync(grid, rowCount, colCount, trailValue, seeds, seedCount);
+
+    nextEpoch();
+    visitedCount = 0;
+    for (int i = 0; i < seedCount; i++)
+        enemyStamp[seeds[i]] = epoch;
+
+    // An area no trail touches is unchanged since the last capture and still holds its
+    // enemy, so only the free cells beside a trail can start an enclosed region
+    int activeCount = 0, open = 0;
+    bool anyReached = false;
+    for (int i = 0; i < trailCount; i++)
+    {
+        int cell = trail[i], r = cell / cols, c = cell % cols;
+        int around[4] = {r > 0 ? cell - cols : -1, r + 1 < rows ? cell + cols : -1,
+                         c > 0 ? cell - 1 : -1, c + 1 < cols ? cell + 1 : -1};
+        for (int next : around)
+        {
+            if (next < 0 || grid[next] != 0 || stamp[next] == epoch)
+                continue;
+            int region = newRegion(next);
+            if (state[region] == REGION_OPEN)
+            {
+                active[activeCount++] = region;
+                open++;
+            }
+            else
+                anyReached = true;
+        }
+    }
+
+    // Grow every open region one cell per round, so an enclosed pocket is used up in about
+    // (regions x its size) steps while the big enemy area is explored no further than that
+    while (open > 0)
+    {
+        // The regions split the trailed areas between them, and those areas hold enemies:
+        // once all but one region came up empty, the enemies are in the last one
+        if (open == 1 && !anyReached)
+        {
+            for (int i = 0; i < activeCount; i++)
+                if (parent[active[i]] == active[i] && state[active[i]] == REGION_OPEN)
+                    state[active[i]] = REGION_REACHED;
+            break;
+        }
+
+        int kept = 0;
+        for (int i = 0; i < activeCount; i++)
+        {
+            int region = active[i];
+            if (parent[region] != region || state[region] != REGION_OPEN)
+                continue;
+
+            int cell = head[region];
+            if (cell < 0)
+            {
+                state[region] = REGION_ENCLOSED;
+                open--;
+                continue;
+            }
+            head[region] = link[cell];
+
+            int r = cell / cols, c = cell % cols;
+            int around[4] = {r > 0 ? cell - cols : -1, r + 1 < rows ? cell + cols : -1,
+                             c > 0 ? cell - 1 : -1, c + 1 < cols ? cell + 1 : -1};
+            for (int next : around)
+            {
+                if (next < 0 || grid[next] != 0)
+                    continue;
+                if (stamp[next] != epoch)
+                {
+                    claim(next, region);
+                    continue;
+                }
+                int other = find(owner[next]);
+                if (other != region)
+                {
+                    if (state[other] == REGION_OPEN)
+                        open--;
+                    merge(region, other);
+                }
+            }
+
+            if (state[region] == REGION_OPEN)
+                active[kept++] = region;
+            else
+            {
+                anyReached = true;
+                open--;
+            }
+        }
+        activeCount = kept;
+    }
+
+    // Only claimed cells and trails can change
+    for (int i = 0; i < visitedCount; i++)
+        if (state[find(owner[visited[i]])] == REGION_ENCLOSED)
+            grid[visited[i]] = 1;
+
+    int captured = 0, kept = 0;
+    for (int i = 0; i < trailCount; i++)
+    {
+        if (grid[trail[i]] == trailValue)
+        {
+            grid[trail[i]] = 1;
+            captured++;
+        }
+        else
+            trail[kept++] = trail[i];
+    }
+    trailCount = kept;
+    return captured;
+}
@@ -0,0 +1,139 @@
+// Xonix Game
+// Texture atlas - shelf packing
+
+#include "../header/TextureAtlas.h"
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+TextureAtlas::TextureAtlas() : count(0), built(false)
+{
+}
+
+int TextureAtlas::indexOf(const string &name) const
+{
+    for (int i = 0; i < count; i++)
+        if (names[i] == name)
+            return i;
+    return -1;
+}
+
+bool TextureAtlas::add(const string &name, const string &path)
+{
+    if (built || count == MAX_SPRITES || indexOf(name) >= 0)
+        return false;
+    names[count] = name;
+    paths[count] = path;
+    rects[count] = IntRect();
+    count++;
+    return true;
+}
+
+bool TextureAtlas::build(int width)
+{
+    if (built)
+        return true;
+
+    Image *images = new Image[count];
+    int order[MAX_SPRITES];
+    int placed = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (!images[i].loadFromFile(paths[i]))
+        {
+            cout << "Atlas: failed to load " << paths[i] << endl;
+            continue;
+        }
+
+        // Insertion sort by height, tallest first - shelves waste less that way
+        int j = placed++;
+        while (j > 0 && images[order[j - 1]].getSize().y < images[i].getSize().y)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    // Rows left to right; a sprite that does not fit starts a new row under the tallest one so far
+    int x = 0, y = 0, shelfHeight = 0, usedWidth = 0;
+    for (int k = 0; k < placed; k++)
+    {
+        int i = order[k];
+        int w = (int)images[i].getSize().x, h = (int)images[i].getSize().y;
+        if (x > 0 && x + w > width)
+        {
+            y += shelfHeight + PADDING;
+            x = 0;
+            shelfHeight = 0;
+        }
+        rects[i] = IntRect(x, y, w, h);
+        x += w + PADDING;
+        if (h > shelfHeight)
+            shelfHeight = h;
+        if (x > usedWidth)
+            usedWidth = x;
+    }
+
+    bool ok = true;
+    if (placed > 0)
+    {
+        Image sheet;
+        sheet.create(usedWidth, y + shelfHeight, Color::Transparent);
+        for (int k = 0; k < placed; k++)
+        {
+            int i = order[k];
+            sheet.copy(images[i], rects[i].left, rects[i].top);
+        }
+        ok = texture.loadFromImage(sheet);
+    }
+    delete[] images;
+
+    built = true;
+    return ok;
+}
+
+const Texture &TextureAtlas::getTexture() const
+{
+    return texture;
+}
+
+IntRect TextureAtlas::rect(const string &name) const
+{
+    int i = indexOf(name);
+    return i >= 0 ? rects[i] : IntRect();
+}
+
+IntRect TextureAtlas::rect(const string &name, const IntRect &part) const
+{
+    IntRect whole = rect(name);
+    return IntRect(whole.left + part.left, whole.top + part.top, part.width, part.height);
+}
+
+bool TextureAtlas::save(const string &imagePath, const string &manifestPath) const
+{
+    if (!texture.copyToImage().saveToFile(imagePath))
+        return false;
+
+    ofstream manifest(manifestPath);
+    if (!manifest)
+        return false;
+    for (int i = 0; i < count; i++)
+        manifest << names[i] << " " << rects[i].left << " " << rects[i].top << " " << rects[i].width << " "
+                 << rects[i].height << "\n";
+    return (bool)manifest;
+}
+
+const TextureAtlas &TextureAtlas::sprites()
+{
+    static TextureAtlas atlas;
+    if (!atlas.built)
+    {
+        atlas.add("tiles", "assets/images/tiles.png");
+        atlas.add("enemy", "assets/images/enemy.png");
+        atlas.add("gameover", "assets/images/gameover.png");
+        atlas.build();
+    }
+    return atlas;
+}
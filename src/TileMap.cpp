@@ -0,0 +1,147 @@
+// Xonix Game
+// Batched rendering - board vertex array and sprite batches
+
+#include "../header/TileMap.h"
+
+TileMap::TileMap()
+    : vertices(Quads), texture(nullptr), rows(0), cols(0), tileSize(0), shown(nullptr), tint(Color::White)
+{
+    for (int i = 0; i < TILE_KINDS; i++)
+        hasRect[i] = false;
+}
+
+TileMap::~TileMap()
+{
+    delete[] shown;
+}
+
+void TileMap::create(const Texture &tiles, int newRows, int newCols, int newTileSize)
+{
+    texture = &tiles;
+    rows = newRows;
+    cols = newCols;
+    tileSize = newTileSize;
+
+    delete[] shown;
+    shown = new int[rows * cols];
+    vertices.resize(rows * cols * 4);
+
+    // Positions never change; texture coordinates and colors are filled in by update()
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+        {
+            Vertex *quad = &vertices[(i * cols + j) * 4];
+            float left = (float)(j * tileSize), top = (float)(i * tileSize);
+            quad[0].position = Vector2f(left, top);
+            quad[1].position = Vector2f(left + tileSize, top);
+            quad[2].position = Vector2f(left + tileSize, top + tileSize);
+            quad[3].position = Vector2f(left, top + tileSize);
+            shown[i * cols + j] = -1;
+        }
+}
+
+void TileMap::setTile(int value, const IntRect &rect)
+{
+    if (value < 0 || value >= TILE_KINDS)
+        return;
+    rects[value] = rect;
+    hasRect[value] = true;
+    for (int i = 0; i < rows * cols; i++)
+        shown[i] = -1;
+}
+
+// An empty cell keeps its quad, fully transparent
+void TileMap::setCell(int index, int value)
+{
+    Vertex *quad = &vertices[index * 4];
+    bool visible = value >= 0 && value < TILE_KINDS && hasRect[value];
+    Color color = visible ? tint : Color::Transparent;
+
+    float left = 0, top = 0, right = 0, bottom = 0;
+    if (visible)
+    {
+        const IntRect &rect = rects[value];
+        left = (float)rect.left;
+        top = (float)rect.top;
+        right = left + rect.width;
+        bottom = top + rect.height;
+    }
+
+    quad[0].texCoords = Vector2f(left, top);
+    quad[1].texCoords = Vector2f(right, top);
+    quad[2].texCoords = Vector2f(right, bottom);
+    quad[3].texCoords = Vector2f(left, bottom);
+    for (int k = 0; k < 4; k++)
+        quad[k].color = color;
+    shown[index] = value;
+}
+
+int TileMap::update(const int *grid, const Color &newTint)
+{
+    bool all = newTint != tint;
+    tint = newTint;
+
+    int rewritten = 0;
+    for (int i = 0; i < rows * cols; i++)
+    {
+        if (all || grid[i] != shown[i])
+        {
+            setCell(i, grid[i]);
+            rewritten++;
+        }
+    }
+    return rewritten;
+}
+
+const Texture *TileMap::getTexture() const
+{
+    return texture;
+}
+
+void TileMap::draw(RenderTarget &target, RenderStates states) const
+{
+    states.texture = texture;
+    target.draw(vertices, states);
+}
+
+SpriteBatch::SpriteBatch() : vertices(Quads), texture(nullptr)
+{
+}
+
+void SpriteBatch::clear()
+{
+    vertices.clear();
+}
+
+void SpriteBatch::add(const Sprite &sprite)
+{
+    texture = sprite.getTexture();
+    const Transform &transform = sprite.getTransform();
+    const IntRect &rect = sprite.getTextureRect();
+    float width = (float)rect.width, height = (float)rect.height;
+    float u = (float)rect.left, v = (float)rect.top;
+    Color color = sprite.getColor();
+
+    vertices.append(Vertex(transform.transformPoint(0, 0), color, Vector2f(u, v)));
+    vertices.append(Vertex(transform.transformPoint(width, 0), color, Vector2f(u + width, v)));
+    vertices.append(Vertex(transform.transformPoint(width, height), color, Vector2f(u + width, v + height)));
+    vertices.append(Vertex(transform.transformPoint(0, height), color, Vector2f(u, v + height)));
+}
+
+bool SpriteBatch::isEmpty() const
+{
+    return vertices.getVertexCount() == 0;
+}
+
+const Texture *SpriteBatch::getTexture() const
+{
+    return texture;
+}
+
+void SpriteBatch::draw(RenderTarget &target, RenderStates states) const
+{
+    if (vertices.getVertexCount() == 0)
+        return;
+    states.texture = texture;
+    target.draw(vertices, states);
+}
@@ -0,0 +1,224 @@
+// Xonix Game
+// Persistent username index - linear probing over a mapped slot array
+
+#include "../header/UsernameIndex.h"
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+const char *UsernameIndex::DEFAULT_PATH = "data/usernames.idx";
+
+static const char INDEX_MAGIC[8] = {'X', 'N', 'X', 'U', 'I', 'D', 'X', '1'};
+static const uint32_t INDEX_VERSION = 1;
+
+UsernameIndex::UsernameIndex() {}
+
+UsernameIndex &UsernameIndex::instance()
+{
+    static UsernameIndex index;
+    return index;
+}
+
+IndexHeader *UsernameIndex::header() const
+{
+    return (IndexHeader *)file.bytes();
+}
+
+IndexSlot *UsernameIndex::slot(uint32_t i) const
+{
+    return (IndexSlot *)(file.bytes() + sizeof(IndexHeader)) + i;
+}
+
+// FNV-1a - stable across runs, unlike the in-memory table's modulo hash
+uint32_t UsernameIndex::hashOf(const string &username) const
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < (int)username.length(); i++)
+    {
+        hash ^= (unsigned char)username[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool UsernameIndex::open(const string &indexPath)
+{
+    close();
+    path = indexPath;
+    if (!file.open(path, false))
+        return false;
+
+    IndexHeader *h = header();
+    if (!h || file.getSize() < sizeof(IndexHeader) || memcmp(h->magic, INDEX_MAGIC, 8) != 0 ||
+        h->version != INDEX_VERSION || h->slotSize != sizeof(IndexSlot) ||
+        file.getSize() < sizeof(IndexHeader) + (uint64_t)h->capacity * sizeof(IndexSlot))
+    {
+        cerr << "Warning: " << path << " is not a valid username index\n";
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool UsernameIndex::create(const string &indexPath, uint32_t capacity)
+{
+    close();
+    path = indexPath;
+    remove(path.c_str());
+    if (!file.open(path, true))
+        return false;
+    return initialize(capacity);
+}
+
+bool UsernameIndex::initialize(uint32_t capacity)
+{
+    if (!file.resize(sizeof(IndexHeader) + (uint64_t)capacity * sizeof(IndexSlot)))
+        return false;
+
+    IndexHeader *h = header();
+    memcpy(h->magic, INDEX_MAGIC, 8);
+    h->version = INDEX_VERSION;
+    h->slotSize = sizeof(IndexSlot);
+    h->capacity = capacity;
+    h->count = 0;
+    h->listed = 0;
+    for (uint32_t i = 0; i < capacity; i++)
+    {
+        memset(slot(i), 0, sizeof(IndexSlot));
+        slot(i)->playerId = -1;
+    }
+    return true;
+}
+
+void UsernameIndex::close()
+{
+    file.close();
+}
+
+bool UsernameIndex::isOpen() const
+{
+    return file.isOpen() && file.bytes() != nullptr;
+}
+
+const IndexSlot *UsernameIndex::findSlot(const string &username) const
+{
+    if (!isOpen())
+        return nullptr;
+
+    uint32_t hash = hashOf(username);
+    uint32_t mask = header()->capacity - 1;
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        const IndexSlot *s = slot(i);
+        if (s->playerId < 0)
+            return nullptr;
+        if (s->hash == hash && username == s->username)
+            return s;
+    }
+}
+
+// Double the table in memory, then rewrite the file in one go
+bool UsernameIndex::grow()
+{
+    uint32_t oldCapacity = header()->capacity;
+    uint32_t listed = header()->listed;
+    IndexSlot *old = new IndexSlot[oldCapacity];
+    memcpy(old, slot(0), (size_t)oldCapacity * sizeof(IndexSlot));
+
+    bool ok = initialize(oldCapacity * 2);
+    uint32_t mask = oldCapacity * 2 - 1;
+    for (uint32_t i = 0; ok && i < oldCapacity; i++)
+    {
+        if (old[i].playerId < 0)
+            continue;
+        uint32_t j = old[i].hash & mask;
+        while (slot(j)->playerId >= 0)
+            j = (j + 1) & mask;
+        *slot(j) = old[i];
+        header()->count++;
+    }
+    if (ok)
+        header()->listed = listed;
+    delete[] old;
+    return ok;
+}
+
+bool UsernameIndex::insert(const string &username, const string &playerId, int arrayIndex)
+{
+    if (!isOpen() || (int)username.length() >= STORE_USERNAME_LEN)
+        return false;
+
+    // Keep load factor under 70% so probe chains stay short
+    if ((header()->count + 1) * 10 > header()->capacity * 7 && !grow())
+        return false;
+
+    uint32_t hash = hashOf(username);
+    uint32_t mask = header()->capacity - 1;
+    uint32_t i = hash & mask;
+    while (slot(i)->playerId >= 0)
+    {
+        if (slot(i)->hash == hash && username == slot(i)->username)
+            break;  // Update existing entry
+        i = (i + 1) & mask;
+    }
+
+    IndexSlot *s = slot(i);
+    if (s->playerId < 0)
+        header()->count++;
+    s->hash = hash;
+    s->playerId = atoi(playerId.c_str());
+    s->arrayIndex = arrayIndex;
+    memset(s->username, 0, STORE_USERNAME_LEN);
+    memcpy(s->username, username.c_str(), username.length());
+    return true;
+}
+
+string UsernameIndex::getPlayerId(const string &username) const
+{
+    const IndexSlot *s = findSlot(username);
+    return s ? to_string(s->playerId) : "";
+}
+
+int UsernameIndex::getArrayIndex(const string &username) const
+{
+    const IndexSlot *s = findSlot(username);
+    return s ? s->arrayIndex : -1;
+}
+
+bool UsernameIndex::exists(const string &username) const
+{
+    return findSlot(username) != nullptr;
+}
+
+int UsernameIndex::getCount() const
+{
+    return isOpen() ? (int)header()->count : 0;
+}
+
+int UsernameIndex::getListedCount() const
+{
+    return isOpen() ? (int)header()->listed : -1;
+}
+
+void UsernameIndex::setListedCount(int listed)
+{
+    if (isOpen())
+        header()->listed = (uint32_t)listed;
+}
+
+void UsernameIndex::flush()
+{
+    file.flush();
+}
+
+void UsernameIndex::display() const
+{
+    if (!isOpen())
+        return;
+    cout << "\n===== Username Index (" << path << ") =====\n";
+    cout << "Entries: " << header()->count << " / " << header()->capacity << " slots\n";
+    cout << "================================\n";
+}
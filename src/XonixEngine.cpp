@@ -0,0 +1,410 @@
+// Xonix Game
+// Headless Xonix rules, one or two players - one step() is one SIM_STEP tick of the game
+
+#include "../header/XonixEngine.h"
+
+EngineInput::EngineInput(int dx, int dy, bool usePowerUp) : dx(dx), dy(dy), usePowerUp(usePowerUp) {}
+
+bool EngineState::enemiesFrozen() const
+{
+    for (int i = 0; i < playerCount; i++)
+        if (players[i].powerUpActive)
+            return true;
+    return false;
+}
+
+bool EngineState::anyAlive() const
+{
+    for (int i = 0; i < playerCount; i++)
+        if (players[i].alive)
+            return true;
+    return false;
+}
+
+XonixEngine::XonixEngine()
+{
+    newGame(1, 0, 1);
+}
+
+// Walled board and default difficulty; players and enemies are placed by the caller
+void XonixEngine::resetBoard(int playerCount, uint64_t seed)
+{
+    rng.seed(seed);
+    current.seed = seed;
+
+    for (int i = 0; i < M; i++)
+        for (int j = 0; j < N; j++)
+            current.grid[i][j] = (i == 0 || j == 0 || i == M - 1 || j == N - 1) ? 1 : 0;
+    capture.reset();
+
+    current.playerCount = playerCount;
+    for (int i = 0; i < MAX_PLAYERS; i++)
+        current.players[i] = EnginePlayer();
+
+    current.moveDelay = 0.07f;
+    current.enemySpeed = 1.0f;
+    current.ticks = 0;
+}
+
+void XonixEngine::placePlayer(int index, int x, int y, int powerUps)
+{
+    EnginePlayer &player = current.players[index];
+    player.x = x;
+    player.y = y;
+    player.dx = player.dy = 0;
+    player.alive = true;
+    player.frozen = false;
+    player.constructing = false;
+    player.trail = 2 + index;
+    player.moveTimer = 0;
+
+    player.score = 0;
+    player.bonusCount = 0;
+    player.powerUps = powerUps;
+    player.nextPowerUpScore = 50;
+    player.powerUpsUsed = 0;
+    player.powerUpActive = false;
+    player.powerUpRemainingTime = 0;
+
+    player.captures = 0;
+    player.lastCaptured = 0;
+}
+
+void XonixEngine::newGame(int level, int powerUps, uint64_t seed)
+{
+    resetBoard(1, seed);
+    placePlayer(0, 0, 0, powerUps);
+
+    current.enemyCount = 4;
+    for (int i = 0; i < MAX_ENEMIES; i++)
+    {
+        EngineEnemy &enemy = current.enemies[i];
+        enemy.x = enemy.y = 300;
+        enemy.prevX = enemy.prevY = 300;
+        enemy.dx = 4 - rng.below(8);
+        enemy.dy = 4 - rng.below(8);
+        enemy.frozen = false;
+    }
+
+    setLevel(level);
+}
+
+void XonixEngine::newDuel(int powerUps1, int powerUps2, uint64_t seed)
+{
+    resetBoard(2, seed);
+    placePlayer(0, 0, 0, powerUps1);
+    placePlayer(1, N - 1, M - 1, powerUps2);
+
+    const int startX[4] = {2, 2, N - 3, N - 3};
+    const int startY[4] = {2, M - 3, 2, M - 3};
+    current.enemyCount = 4;
+    for (int i = 0; i < current.enemyCount; i++)
+    {
+        EngineEnemy &enemy = current.enemies[i];
+        enemy.x = enemy.prevX = startX[i] * TILE_SIZE;
+        enemy.y = enemy.prevY = startY[i] * TILE_SIZE;
+        enemy.dx = 4 - rng.below(8);
+        enemy.dy = 4 - rng.below(8);
+        enemy.frozen = false;
+    }
+
+    setLevel(1);
+}
+
+// Adjust difficulty based on level
+void XonixEngine::setLevel(int level)
+{
+    current.level = level;
+    switch (level)
+    {
+    case 1:
+        current.moveDelay = 0.07f;
+        current.enemySpeed = 1.0f;
+        break;
+    case 2:
+        current.moveDelay = 0.06f;
+        current.enemySpeed = 1.2f;
+        current.enemyCount = 5;
+        break;
+    case 3:
+        current.moveDelay = 0.05f;
+        current.enemySpeed = 1.5f;
+        current.enemyCount = 6;
+        break;
+    case 4:
+        current.moveDelay = 0.04f;
+        current.enemySpeed = 1.8f;
+        current.enemyCount = 7;
+        break;
+    case 5:
+        current.moveDelay = 0.03f;
+        current.enemySpeed = 2.0f;
+        current.enemyCount = 10;
+        break;
+    default:
+        break;
+    }
+}
+
+void XonixEngine::restore(const EngineState &saved)
+{
+    current = saved;
+    if (current.playerCount < 1 || current.playerCount > MAX_PLAYERS)
+        current.playerCount = 1;
+    if (current.enemyCount < 0 || current.enemyCount > MAX_ENEMIES)
+        current.enemyCount = current.enemyCount < 0 ? 0 : MAX_ENEMIES;
+    for (int i = 0; i < MAX_ENEMIES; i++)
+    {
+        current.enemies[i].prevX = current.enemies[i].x;
+        current.enemies[i].prevY = current.enemies[i].y;
+    }
+    capture.reset();  // The board was loaded without it
+    rng.seed(current.seed);
+}
+
+// Enemies bounce off walls only - the x step and the y step are checked on their own
+void XonixEngine::moveEnemy(EngineEnemy &enemy)
+{
+    float newX = enemy.x + enemy.dx * current.enemySpeed;
+    float newY = enemy.y + enemy.dy * current.enemySpeed;
+
+    if (newX < 0)
+        newX = 0;
+    if (newX > (N - 1) * TILE_SIZE)
+        newX = (N - 1) * TILE_SIZE;
+    if (newY < 0)
+        newY = 0;
+    if (newY > (M - 1) * TILE_SIZE)
+        newY = (M - 1) * TILE_SIZE;
+
+    int rowOld = enemy.y / TILE_SIZE;
+    int colNewX = int(newX) / TILE_SIZE;
+    if (current.grid[rowOld][colNewX] == 1)
+        enemy.dx = -enemy.dx;
+    else
+        enemy.x = newX;
+
+    int colOld = enemy.x / TILE_SIZE;
+    int rowNewY = int(newY) / TILE_SIZE;
+    if (current.grid[rowNewY][colOld] == 1)
+        enemy.dy = -enemy.dy;
+    else
+        enemy.y = newY;
+}
+
+// Capture step for one player's trail: area reachable by enemies stays empty, the trail (counted)
+// and enclosed areas become walls, another player's trail is left alone - only the regions
+// beside the trail are examined
+int XonixEngine::captureArea(int trail)
+{
+    int seeds[MAX_ENEMIES];
+    for (int i = 0; i < current.enemyCount; i++)
+        seeds[i] = (current.enemies[i].y / TILE_SIZE) * N + current.enemies[i].x / TILE_SIZE;
+    return capture.resolveCapture(&current.grid[0][0], M, N, trail, seeds, current.enemyCount);
+}
+
+void XonixEngine::award(EnginePlayer &player, int captured)
+{
+    /*
+     * Points System Implementation:
+     * - Each tile captured = 1 point
+     * - Capturing >10 tiles in single move = x2 points (double)
+     * - After 3 bonus occurrences: threshold reduces to 5 tiles for double
+     * - After 5 bonus occurrences: capturing >5 tiles = x4 points
+     */
+    int bonusThreshold = (player.bonusCount >= 3) ? 5 : 10;
+    int multiplier = 1;
+
+    if (captured > bonusThreshold)
+    {
+        // Award bonus multiplier for THIS capture
+        if (player.bonusCount >= 5)
+            multiplier = 4; // x4 after 5 bonus occurrences
+        else
+            multiplier = 2; // x2 for bonus capture
+        player.bonusCount++; // Increment AFTER determining multiplier
+    }
+
+    player.score += captured * multiplier;
+
+    /*
+     * Power-up System:
+     * - First power-up at score 50
+     * - Additional at 70, 100, 130, then every +30 points
+     * - Power-ups stack and are stored in inventory
+     */
+    while (player.score >= player.nextPowerUpScore)
+    {
+        player.powerUps++;
+        if (player.nextPowerUpScore == 50)
+            player.nextPowerUpScore = 70;
+        else if (player.nextPowerUpScore == 70)
+            player.nextPowerUpScore = 100;
+        else
+            player.nextPowerUpScore += 30;
+    }
+}
+
+// The player moves one cell every moveDelay and leaves a trail over empty cells. Standing
+// still keeps the timer banked, so the first move after a stop is never a tick late; a frozen
+// player loses the move
+void XonixEngine::movePlayer(EnginePlayer &player)
+{
+    if (!player.alive || player.moveTimer <= current.moveDelay)
+        return;
+    if (player.frozen)
+    {
+        player.moveTimer = 0;
+        return;
+    }
+    if (player.dx == 0 && player.dy == 0)
+        return;
+
+    int x = player.x + player.dx;
+    int y = player.y + player.dy;
+
+    if (x < 0)
+        x = 0;
+    if (x > N - 1)
+        x = N - 1;
+    if (y < 0)
+        y = 0;
+    if (y > M - 1)
+        y = M - 1;
+    player.x = x;
+    player.y = y;
+
+    // Any trail is fatal - this player's own, or the other player's while it is being built
+    if (current.grid[y][x] >= 2)
+        player.alive = false;
+    player.constructing = current.grid[y][x] != 1;
+    if (current.grid[y][x] == 0)
+    {
+        current.grid[y][x] = player.trail;
+        capture.layTrail(y * N + x);
+    }
+    player.moveTimer = 0;
+}
+
+void XonixEngine::step(const EngineInput *inputs)
+{
+    if (!current.anyAlive())
+        return;
+
+    for (int i = 0; i < current.playerCount; i++)
+    {
+        EnginePlayer &player = current.players[i];
+        const EngineInput &input = inputs[i];
+        if (input.dx != 0 || input.dy != 0)
+        {
+            player.dx = input.dx;
+            player.dy = input.dy;
+        }
+
+        // Freeze for FREEZE_TIME - one freeze at a time, whoever started it
+        if (input.usePowerUp && player.alive && player.powerUps > 0 && !current.enemiesFrozen())
+        {
+            player.powerUps--;
+            player.powerUpsUsed++;
+            player.powerUpActive = true;
+            player.powerUpRemainingTime = FREEZE_TIME;
+        }
+    }
+
+    current.ticks++;
+    for (int i = 0; i < current.playerCount; i++)
+    {
+        EnginePlayer &player = current.players[i];
+        player.lastCaptured = 0;
+        player.moveTimer += SIM_STEP;
+
+        if (player.powerUpActive)
+        {
+            player.powerUpRemainingTime -= SIM_STEP;
+            if (player.powerUpRemainingTime <= 0)
+            {
+                player.powerUpActive = false;
+                player.powerUpRemainingTime = 0;
+            }
+        }
+    }
+
+    // A running freeze also holds the other player still
+    for (int i = 0; i < current.playerCount; i++)
+        current.players[i].frozen = current.playerCount == 2 && current.players[1 - i].powerUpActive;
+
+    for (int i = 0; i < current.enemyCount; i++)
+    {
+        current.enemies[i].prevX = current.enemies[i].x;
+        current.enemies[i].prevY = current.enemies[i].y;
+    }
+
+    for (int i = 0; i < current.playerCount; i++)
+        movePlayer(current.players[i]);
+
+    /*
+     * Player-to-Player Collision Rules (duel):
+     * 1. Both constructing (off the wall) on the same cell -> both die
+     * 2. Only one constructing -> that one dies
+     * 3. Both on the wall -> nothing happens
+     * Running into the other player's trail is handled in movePlayer()
+     */
+    if (current.playerCount == 2)
+    {
+        EnginePlayer &first = current.players[0];
+        EnginePlayer &second = current.players[1];
+        if (first.alive && second.alive && first.x == second.x && first.y == second.y)
+        {
+            bool firstDies = first.constructing;
+            bool secondDies = second.constructing;
+            if (firstDies)
+                first.alive = false;
+            if (secondDies)
+                second.alive = false;
+        }
+    }
+
+    bool frozen = current.enemiesFrozen();
+    for (int i = 0; i < current.enemyCount; i++)
+    {
+        current.enemies[i].frozen = frozen;
+        if (!frozen)
+            moveEnemy(current.enemies[i]);
+    }
+
+    // Back on a wall: the player's trail becomes wall and is counted,
+    // enclosed areas are filled but not counted
+    for (int i = 0; i < current.playerCount; i++)
+    {
+        EnginePlayer &player = current.players[i];
+        if (!player.alive || current.grid[player.y][player.x] != 1)
+            continue;
+        player.dx = player.dy = 0;
+
+        int captured = captureArea(player.trail);
+        if (captured > 0)
+            player.captures++;
+        player.lastCaptured = captured;
+        award(player, captured);
+    }
+
+    // An enemy on a trail kills whoever laid it
+    for (int i = 0; i < current.enemyCount; i++)
+    {
+        int cell = current.grid[current.enemies[i].y / TILE_SIZE][current.enemies[i].x / TILE_SIZE];
+        for (int j = 0; j < current.playerCount; j++)
+            if (cell == current.players[j].trail)
+                current.players[j].alive = false;
+    }
+}
+
+void XonixEngine::step(const EngineInput &input)
+{
+    EngineInput inputs[MAX_PLAYERS] = {input, EngineInput()};
+    step(inputs);
+}
+
+const EngineState &XonixEngine::state() const
+{
+    return current;
+}
@@ -4,25 +4,69 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
 #include "../header/Authentication.h"
+#include "../header/PlayerStore.h"
+#include "../header/PlayerLog.h"
+#include "../header/System.h"
+#include "../header/Game.h"
+#include "../header/ScreenPacer.h"
+#include "../header/AssetPreloader.h"
+#include "../header/MusicPlayer.h"
+#include "../header/TextureAtlas.h"
 
 using namespace std;
 using namespace sf;
 
-SoundBuffer buffer;
-Sound background_sound;
+MusicPlayer background_music;
 bool musicEnabled = true;
+bool menuMusic = false;  // The menu playlist is queued (not a theme track)
+
+// Looped in the menus; add tracks here. A theme's own track, if present, plays during its games
+static const string MENU_PLAYLIST[] = {
+    "assets/Sounds/Background_Audio.mp3"};
+static const int MENU_TRACK_COUNT = sizeof(MENU_PLAYLIST) / sizeof(MENU_PLAYLIST[0]);
+
+Clock startupClock;      // Started before main
+float assetsReadyMs = 0;
+
+// Everything the screens load, decoded behind the loading screen; the music streams instead.
+// Arial is left out because the loading screen itself needs it, and the game sprites because
+// they go into the texture atlas
+static const char *const STARTUP_ASSETS[] = {
+    "assets/images/authentication.png",
+    "assets/images/menuBackground.png",
+    "assets/images/inventoryBackground.png",
+    "assets/images/background.jpg",
+    "assets/images/leaderboardBackground.png",
+    "assets/images/BgXonic.png",
+    "assets/images/FriendsBackground.png",
+    "assets/images/historyBackground.png",
+    "assets/images/gameOverBackground.png",
+    "assets/images/setting-background.jpg",
+    "assets/backgrounds/Forest-background.jpg",
+    "assets/backgrounds/desert-background.jpg",
+    "assets/backgrounds/Ocean-background.jpg",
+    "assets/backgrounds/mountain-background.jpg",
+    "assets/backgrounds/city-background.jpg",
+    "assets/fonts/COOPBL.ttf",
+    "assets/fonts/MATURASC.ttf",
+    "assets/fonts/STENCIL.ttf",
+    "assets/fonts/HARLOWSI.ttf"};
+static const int STARTUP_ASSET_COUNT = sizeof(STARTUP_ASSETS) / sizeof(STARTUP_ASSETS[0]);
 
 void toggleBackgroundMusic()
 {
     if (musicEnabled)
     {
-        background_sound.pause();
+        background_music.pause();
         musicEnabled = false;
     }
     else
     {
-        background_sound.play();
+        background_music.play();
         musicEnabled = true;
     }
 }
@@ -36,29 +80,166 @@ void setMusicEnabled(bool enabled)
 {
     musicEnabled = enabled;
     if (enabled)
-        background_sound.play();
+        background_music.play();
     else
-        background_sound.pause();
+        background_music.pause();
+}
+
+void playMenuMusic()
+{
+    if (menuMusic)
+        return;
+    menuMusic = background_music.setPlaylist(MENU_PLAYLIST, MENU_TRACK_COUNT);
+    if (menuMusic && musicEnabled)
+        background_music.play();
 }
 
-int main()
+// Themes without a track of their own keep the menu music going
+void playThemeMusic(const string &path)
 {
-    if (!buffer.loadFromFile("assets/Sounds/Background_Audio.mp3"))
+    if (path.empty() || background_music.isOnlyTrack(path) || !ifstream(path))
+        return;
+
+    menuMusic = false;
+    if (!background_music.setPlaylist(&path, 1))
     {
-        cout << "Error Loading sound!" << endl;
-        return -1;
+        playMenuMusic();
+        return;
+    }
+    if (musicEnabled)
+        background_music.play();
+}
+
+// Called by the login screen each time it draws; reports the first time only
+void markFirstFrame()
+{
+    static bool reported = false;
+    if (reported)
+        return;
+    reported = true;
+    cout << "[startup] First interactive frame after " << startupClock.getElapsedTime().asMilliseconds()
+         << " ms (assets ready at " << (int)assetsReadyMs << " ms)" << endl;
+}
+
+// Progress bar while the preloader decodes; false if the window was closed meanwhile
+static bool showLoadingScreen(RenderWindow &window, AssetPreloader &preloader)
+{
+    AssetRef<Font> font = AssetCache::instance().font("assets/fonts/arial.ttf");
+    Text label("", *font, 18);
+    label.setFillColor(Color::White);
+    label.setPosition(200, 265);
+
+    RectangleShape track(Vector2f(400, 16));
+    track.setPosition(200, 295);
+    track.setFillColor(Color(60, 60, 60));
+    RectangleShape bar;
+    bar.setPosition(200, 295);
+    bar.setFillColor(Color::Cyan);
+
+    preloader.start();
+    while (window.isOpen() && !preloader.isDone())
+    {
+        Event event;
+        while (window.pollEvent(event))
+        {
+            if (event.type == Event::Closed)
+                window.close();
+        }
+
+        preloader.poll();
+        float done = (float)preloader.getLoaded() / preloader.getTotal();
+        bar.setSize(Vector2f(400 * done, 16));
+        label.setString("Loading " + to_string(preloader.getLoaded()) + " / " + to_string(preloader.getTotal()));
+
+        window.clear(Color(20, 20, 20));
+        window.draw(label);
+        window.draw(track);
+        window.draw(bar);
+        window.display();
+    }
+    assetsReadyMs = startupClock.getElapsedTime().asSeconds() * 1000;
+    return window.isOpen();
+}
+
+int main(int argc, char *argv[])
+{
+    // Maintenance commands for the player database
+    if (argc > 1 && strcmp(argv[1], "--migrate-db") == 0)
+        return PlayerStore::instance().migrateFromText() < 0 ? 1 : 0;
+    if (argc > 1 && strcmp(argv[1], "--export-text") == 0)
+    {
+        PlayerStore &store = PlayerStore::instance();
+        if (!store.open())
+            return 1;
+        if (PlayerLog::instance().open())
+            PlayerLog::instance().compact();
+        return store.exportToText() < 0 ? 1 : 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "--check-index") == 0)
+    {
+        System system;
+        return system.checkIndex() == 0 ? 0 : 1;
     }
+    if (argc > 1 && strcmp(argv[1], "--rebuild-index") == 0)
+    {
+        System system;
+        system.rebuildIndex();
+        return system.checkIndex() == 0 ? 0 : 1;
+    }
+
+    // Write the packed sprite atlas and its rects out for inspection
+    if (argc > 1 && strcmp(argv[1], "--dump-atlas") == 0)
+        return TextureAtlas::sprites().save("data/atlas.png", "data/atlas.txt") ? 0 : 1;
 
-    background_sound.setBuffer(buffer);
-    background_sound.setLoop(true);
-    background_sound.setVolume(50);
-    background_sound.play();
+    // Watch a recorded game: Xonix.exe --replay FILE.xrp [SPEED]
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0)
+    {
+        int speed = argc > 3 ? atoi(argv[3]) : 1;
+        if (speed < 1)
+            speed = 1;
+        if (speed > MAX_REPLAY_SPEED)
+            speed = MAX_REPLAY_SPEED;
+
+        RenderWindow window(VideoMode(N * TILE_SIZE, M * TILE_SIZE), "Xonix Replay", Style::Close);
+        SinglePlayer viewer;
+        return viewer.watchReplay(window, argv[2], speed) < 0 ? 1 : 0;
+    }
 
+    // Report frames drawn and CPU used by each menu screen on exit from it,
+    // and what the asset cache loaded when the game closes
+    bool assetStats = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--screen-stats") == 0)
+            ScreenPacer::setReporting(true);
+        else if (strcmp(argv[i], "--asset-stats") == 0)
+            assetStats = true;
+    }
+
+    // Open the window first - decoding happens behind a progress bar
     RenderWindow window(VideoMode(800, 600), "Xonix", Style::Close);
     window.setFramerateLimit(60);
 
+    AssetPreloader preloader(STARTUP_ASSETS, STARTUP_ASSET_COUNT);
+    if (!showLoadingScreen(window, preloader))
+        return 0;
+    TextureAtlas::sprites();  // Pack the game sprites now rather than on the first game
+
+    background_music.setVolume(50);
+    playMenuMusic();
+    if (!menuMusic)
+    {
+        cout << "Error Loading sound!" << endl;
+        return -1;
+    }
+
     AuthenticationSystem authSystem(&window);
     authSystem.authenticationLoop();
 
+    if (assetStats)
+    {
+        AssetCache::instance().displayStats();
+        cout << "Music stream buffer: " << background_music.getBufferBytes() / 1024 << " KB" << endl;
+    }
     return 0;
 }
@@ -0,0 +1,384 @@
+// Xonix Game
+// Difficulty balancing - thousands of headless games per level across every core, as histograms
+// Build: make sim   Run: ./bin/BalanceSim.exe [--games N] [--threads T] [--policy random|scripted] [--minutes M] [--seed S]
+//                   [--record FILE.xrp]   (saves the best game as a replay)
+
+#include "../header/XonixEngine.h"
+#include "../header/TaskPool.h"
+#include "../header/Replay.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+static const int LEVELS = 5;
+static const int GAMES_PER_TASK = 16;
+static const int BINS = 10;
+
+enum Policy
+{
+    POLICY_RANDOM,   // Wanders, turning at random - a floor for how hard each level is
+    POLICY_SCRIPTED  // Bites small rectangles off the wall, freezes enemies that come close
+};
+
+struct GameResult
+{
+    int score;
+    float seconds;
+    bool died;
+    int bonuses;
+    int captures;
+    int powerUpsUsed;
+};
+
+struct Batch
+{
+    int level;
+    int first;  // Index of the first game in this level's results
+    uint64_t seed;
+    int count;
+    Policy policy;
+    long long maxTicks;
+    GameResult *results;
+};
+
+static const int DX[4] = {1, 0, -1, 0};
+static const int DY[4] = {0, 1, 0, -1};
+
+enum Leg
+{
+    LEG_WALL,  // Walking along the wall
+    LEG_IN,    // Away from the wall
+    LEG_SIDE,  // Parallel to it
+    LEG_OUT    // Back until the wall closes the bite
+};
+
+// What a policy remembers between ticks
+struct Pilot
+{
+    int dir;
+    Leg leg;
+    int stepsLeft;
+    int inward;
+    int lastX, lastY;
+};
+
+static bool inside(int x, int y)
+{
+    return x >= 0 && x < N && y >= 0 && y < M;
+}
+
+static EngineInput randomPolicy(const EngineState &s, GameRng &rng, Pilot &pilot)
+{
+    const EnginePlayer &you = s.players[0];
+    if (rng.next() % 16 == 0)
+        pilot.dir = rng.next() % 4;
+    bool freeze = you.powerUps > 0 && rng.next() % 300 == 0;
+    return EngineInput(DX[pilot.dir], DY[pilot.dir], freeze);
+}
+
+static bool enemyNear(const EngineState &s, int cells)
+{
+    const EnginePlayer &you = s.players[0];
+    for (int i = 0; i < s.enemyCount; i++)
+    {
+        int ex = s.enemies[i].x / TILE_SIZE, ey = s.enemies[i].y / TILE_SIZE;
+        if (abs(ex - you.x) <= cells && abs(ey - you.y) <= cells)
+            return true;
+    }
+    return false;
+}
+
+// In 2-4 cells, across 3-8 and back out again - small captures, the way people play
+static EngineInput scriptedPolicy(const EngineState &s, GameRng &rng, Pilot &pilot)
+{
+    const EnginePlayer &you = s.players[0];
+    bool moved = you.x != pilot.lastX || you.y != pilot.lastY;
+    pilot.lastX = you.x;
+    pilot.lastY = you.y;
+
+    if (s.grid[you.y][you.x] == 1)
+    {
+        pilot.leg = LEG_WALL;
+        if (!moved && (you.dx != 0 || you.dy != 0))
+            return EngineInput();
+
+        int open[4], openCount = 0, along[4], alongCount = 0;
+        for (int d = 0; d < 4; d++)
+        {
+            int nx = you.x + DX[d], ny = you.y + DY[d];
+            if (!inside(nx, ny))
+                continue;
+            if (s.grid[ny][nx] == 0)
+                open[openCount++] = d;
+            else if (s.grid[ny][nx] == 1)
+                along[alongCount++] = d;
+        }
+
+        if (openCount > 0 && rng.next() % 4 == 0)
+        {
+            pilot.inward = open[rng.next() % openCount];
+            pilot.dir = pilot.inward;
+            pilot.leg = LEG_IN;
+            pilot.stepsLeft = 2 + rng.next() % 3;
+            return EngineInput(DX[pilot.dir], DY[pilot.dir]);
+        }
+
+        // Keep going along the wall if we can, otherwise take any wall neighbour
+        int nx = you.x + DX[pilot.dir], ny = you.y + DY[pilot.dir];
+        if (!inside(nx, ny) || s.grid[ny][nx] != 1)
+            pilot.dir = alongCount > 0 ? along[rng.next() % alongCount] : rng.next() % 4;
+        return EngineInput(DX[pilot.dir], DY[pilot.dir]);
+    }
+
+    bool freeze = you.powerUps > 0 && !you.powerUpActive && enemyNear(s, 3);
+    if (moved && pilot.leg != LEG_OUT && --pilot.stepsLeft <= 0)
+    {
+        if (pilot.leg == LEG_IN)
+        {
+            // Either side of the way in, whichever has room
+            int side = (pilot.inward + 1 + 2 * (rng.next() % 2)) % 4;
+            if (!inside(you.x + 3 * DX[side], you.y + 3 * DY[side]))
+                side = (side + 2) % 4;
+            pilot.dir = side;
+            pilot.leg = LEG_SIDE;
+            pilot.stepsLeft = 3 + rng.next() % 6;
+        }
+        else
+        {
+            pilot.dir = (pilot.inward + 2) % 4;
+            pilot.leg = LEG_OUT;
+        }
+    }
+    return EngineInput(DX[pilot.dir], DY[pilot.dir], freeze);
+}
+
+// Game i of a level always gets the same seed, however the games are split across threads
+static uint64_t gameSeed(uint64_t runSeed, int level, int game)
+{
+    return ((runSeed * LEVELS + level - 1) << 32) | (uint32_t)game;
+}
+
+// One whole game; with a recording, every input is logged into it as well
+static void playGame(XonixEngine &engine, int level, uint64_t seed, Policy policy, long long maxTicks,
+                     Replay *recording)
+{
+    engine.newGame(level, 0, seed);
+    if (recording)
+        recording->begin(seed, level, 0);
+    GameRng rng(~seed);
+    Pilot pilot = {(int)(rng.next() % 4), LEG_WALL, 0, 0, -1, -1};
+
+    while (engine.state().players[0].alive && engine.state().ticks < maxTicks)
+    {
+        const EngineState &s = engine.state();
+        EngineInput input = policy == POLICY_RANDOM ? randomPolicy(s, rng, pilot) : scriptedPolicy(s, rng, pilot);
+        if (recording)
+            recording->record(s, input);
+        engine.step(input);
+    }
+    if (recording)
+        recording->finish(engine.state().ticks, engine.state().players[0].score);
+}
+
+static void playBatch(void *arg)
+{
+    Batch *batch = (Batch *)arg;
+    XonixEngine engine;
+
+    for (int g = 0; g < batch->count; g++)
+    {
+        int game = batch->first + g;
+        playGame(engine, batch->level, gameSeed(batch->seed, batch->level, game), batch->policy, batch->maxTicks,
+                 nullptr);
+
+        const EngineState &end = engine.state();
+        const EnginePlayer &player = end.players[0];
+        GameResult &r = batch->results[game];
+        r.score = player.score;
+        r.seconds = end.ticks * SIM_STEP;
+        r.died = !player.alive;
+        r.bonuses = player.bonusCount;
+        r.captures = player.captures;
+        r.powerUpsUsed = player.powerUpsUsed;
+    }
+}
+
+// Insertion sort is plenty for a few thousand values
+static void sortValues(double *values, int count)
+{
+    for (int i = 1; i < count; i++)
+    {
+        double v = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > v)
+        {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = v;
+    }
+}
+
+static void printHistogram(const char *label, double *values, int count)
+{
+    sortValues(values, count);
+    double lo = values[0], hi = values[count - 1];
+    double sum = 0;
+    for (int i = 0; i < count; i++)
+        sum += values[i];
+
+    cout << "  " << label << ": min " << lo << "  median " << values[count / 2] << "  mean " << sum / count
+         << "  max " << hi << endl;
+
+    int bins[BINS] = {0};
+    double width = (hi - lo) / BINS;
+    for (int i = 0; i < count; i++)
+    {
+        int b = width > 0 ? (int)((values[i] - lo) / width) : 0;
+        bins[b < BINS ? b : BINS - 1]++;
+    }
+
+    int tallest = 1;
+    for (int b = 0; b < BINS; b++)
+        if (bins[b] > tallest)
+            tallest = bins[b];
+
+    for (int b = 0; b < BINS; b++)
+    {
+        if (width <= 0 && b > 0)
+            break;
+        cout << "    " << setw(8) << lo + b * width << " - " << setw(8) << lo + (b + 1) * width << " |";
+        int bar = bins[b] * 40 / tallest;
+        for (int i = 0; i < bar; i++)
+            cout << '#';
+        cout << ' ' << bins[b] << endl;
+    }
+}
+
+static void report(int level, const GameResult *results, int games, double *scratch)
+{
+    int deaths = 0;
+    long long bonuses = 0, captures = 0, powerUps = 0;
+    for (int i = 0; i < games; i++)
+    {
+        deaths += results[i].died;
+        bonuses += results[i].bonuses;
+        captures += results[i].captures;
+        powerUps += results[i].powerUpsUsed;
+    }
+
+    cout << "Level " << level << ": " << games << " games, " << deaths << " deaths (" << 100.0 * deaths / games
+         << "%), " << (double)captures / games << " captures, " << (double)bonuses / games << " bonus triggers, "
+         << (double)powerUps / games << " freezes per game" << endl;
+
+    for (int i = 0; i < games; i++)
+        scratch[i] = results[i].score;
+    printHistogram("score", scratch, games);
+    for (int i = 0; i < games; i++)
+        scratch[i] = results[i].seconds;
+    printHistogram("seconds", scratch, games);
+    for (int i = 0; i < games; i++)
+        scratch[i] = results[i].bonuses;
+    printHistogram("bonus triggers", scratch, games);
+    cout << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int games = 2000;
+    int threads = 0;
+    double minutes = 5;
+    Policy policy = POLICY_SCRIPTED;
+    uint64_t seed = 1;
+    const char *recordPath = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--games") == 0 && hasValue)
+            games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--minutes") == 0 && hasValue)
+            minutes = atof(argv[++i]);
+        else if (strcmp(argv[i], "--policy") == 0 && hasValue)
+            policy = strcmp(argv[++i], "random") == 0 ? POLICY_RANDOM : POLICY_SCRIPTED;
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+            seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--record") == 0 && hasValue)
+            recordPath = argv[++i];
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [--games N] [--threads T] [--policy random|scripted] [--minutes M] [--seed S] [--record FILE.xrp]" << endl;
+            return 1;
+        }
+    }
+    if (games <= 0)
+        games = 1;
+
+    long long maxTicks = (long long)(minutes * 60 / SIM_STEP);
+    GameResult *results = new GameResult[LEVELS * games];
+    int batchCount = LEVELS * ((games + GAMES_PER_TASK - 1) / GAMES_PER_TASK);
+    Batch *batches = new Batch[batchCount];
+
+    TaskPool pool(threads);
+    auto start = chrono::steady_clock::now();
+
+    int n = 0;
+    for (int level = 1; level <= LEVELS; level++)
+    {
+        for (int first = 0; first < games; first += GAMES_PER_TASK)
+        {
+            Batch &b = batches[n++];
+            b.level = level;
+            b.first = first;
+            b.count = games - first < GAMES_PER_TASK ? games - first : GAMES_PER_TASK;
+            b.seed = seed;
+            b.policy = policy;
+            b.maxTicks = maxTicks;
+            b.results = results + (level - 1) * games;
+            pool.submit(playBatch, &b);
+        }
+    }
+    pool.wait();
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double simulated = 0;
+    for (int i = 0; i < LEVELS * games; i++)
+        simulated += results[i].seconds;
+
+    double *scratch = new double[games];
+    for (int level = 1; level <= LEVELS; level++)
+        report(level, results + (level - 1) * games, games, scratch);
+
+    cout << LEVELS * games << " games (" << (policy == POLICY_RANDOM ? "random" : "scripted") << " policy, seed "
+         << seed << ") on " << pool.threadCount() << " threads in " << elapsed << " s: " << LEVELS * games / elapsed
+         << " games/sec, " << simulated / elapsed << "x real time" << endl;
+
+    // The games are deterministic, so the best one is simply played again with a recorder
+    if (recordPath)
+    {
+        int best = 0;
+        for (int i = 1; i < LEVELS * games; i++)
+            if (results[i].score > results[best].score)
+                best = i;
+
+        int level = best / games + 1;
+        XonixEngine engine;
+        Replay replay;
+        playGame(engine, level, gameSeed(seed, level, best % games), policy, maxTicks, &replay);
+        if (replay.save(recordPath))
+            cout << "Best game (level " << level << ", score " << replay.getScore() << ") saved to " << recordPath
+                 << ": " << replay.getEventCount() << " inputs in " << replay.getEventBytes() << " bytes" << endl;
+    }
+
+    delete[] scratch;
+    delete[] batches;
+    delete[] results;
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Xonix Game
+// Fixed timestep check - plays the same held keys at 1, 3 and 8 ticks per frame the way
+// SinglePlayer::run and Multiplayer::run feed the engine, and fails unless every run of a
+// game ends in the same state
+// Build and run: make test
+
+#include "../header/XonixEngine.h"
+#include <iostream>
+#include <cstring>
+
+using namespace std;
+
+const int TOTAL_TICKS = 24 * 150;  // Input only changes on multiples of 24, a frame start at every rate
+const int FREEZE_TICK = 24 * 5;
+const int SECOND_FREEZE_TICK = 24 * 15;  // Player 2 in a duel
+const int DUEL_SEGMENT = 24 * 4;  // Level 1 is slower, a segment must still cross the field
+
+// Held direction for the frame starting at `tick`: a step along the top or bottom wall, then
+// straight across the field to the other side, capturing a strip each time. Player 2 in a duel
+// mirrors player 1 from the opposite corner
+static EngineInput heldAt(long long tick, int player, int segmentTicks)
+{
+    int sign = player == 0 ? 1 : -1;
+    int segment = (int)(tick / segmentTicks) % 6;
+    if (segment == 0 || segment == 3)
+        return EngineInput(sign, 0);
+    if (segment < 3)
+        return EngineInput(0, sign);
+    return EngineInput(0, -sign);
+}
+
+// Same frame loop as the game: sample once, run the frame's ticks, freeze on the first only
+static void play(XonixEngine &engine, bool duel, int ticksPerFrame)
+{
+    if (duel)
+        engine.newDuel(1, 1, 12345);
+    else
+        engine.newGame(5, 1, 12345);
+
+    int segmentTicks = duel ? DUEL_SEGMENT : 24;
+    EngineInput pending[MAX_PLAYERS];
+    long long tick = 0;
+    while (tick < TOTAL_TICKS && engine.state().anyAlive())
+    {
+        for (int p = 0; p < MAX_PLAYERS; p++)
+            pending[p] = heldAt(tick, p, segmentTicks);
+        if (tick == FREEZE_TICK)
+            pending[0].usePowerUp = true;
+        if (tick == SECOND_FREEZE_TICK)
+            pending[1].usePowerUp = true;
+
+        for (int i = 0; i < ticksPerFrame && tick < TOTAL_TICKS && engine.state().anyAlive(); i++)
+        {
+            engine.step(pending);
+            for (int p = 0; p < MAX_PLAYERS; p++)
+                pending[p].usePowerUp = false;
+            tick++;
+        }
+    }
+}
+
+static bool samePlayer(const EnginePlayer &a, const EnginePlayer &b)
+{
+    return a.x == b.x && a.y == b.y && a.dx == b.dx && a.dy == b.dy && a.alive == b.alive &&
+           a.score == b.score && a.powerUps == b.powerUps && a.powerUpsUsed == b.powerUpsUsed &&
+           a.captures == b.captures;
+}
+
+static bool sameState(const EngineState &a, const EngineState &b)
+{
+    if (memcmp(a.grid, b.grid, sizeof(a.grid)) != 0 || a.ticks != b.ticks)
+        return false;
+    if (a.playerCount != b.playerCount || a.enemyCount != b.enemyCount)
+        return false;
+    for (int i = 0; i < a.playerCount; i++)
+        if (!samePlayer(a.players[i], b.players[i]))
+            return false;
+    for (int i = 0; i < a.enemyCount; i++)
+        if (a.enemies[i].x != b.enemies[i].x || a.enemies[i].y != b.enemies[i].y)
+            return false;
+    return true;
+}
+
+int main()
+{
+    const int RATES[] = {1, 3, 8};
+    XonixEngine reference, engine;
+
+    int failed = 0;
+    for (int duel = 0; duel <= 1; duel++)
+    {
+        play(reference, duel, RATES[0]);
+        const EngineState &expected = reference.state();
+
+        for (int rate : RATES)
+        {
+            play(engine, duel, rate);
+            const EngineState &got = engine.state();
+            bool ok = sameState(expected, got);
+            cout << (duel ? "Duel, " : "Single player, ") << rate << " ticks per frame: ";
+            for (int p = 0; p < got.playerCount; p++)
+                cout << "player " << p + 1 << " at (" << got.players[p].x << ", " << got.players[p].y << ") score "
+                     << got.players[p].score << (got.players[p].alive ? "" : " dead") << ", ";
+            cout << got.ticks << " ticks - " << (ok ? "OK" : "MISMATCH") << endl;
+            if (!ok)
+                failed++;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+// Xonix Game
+// Benchmark - scanline FloodFill and bit-plane capture vs the previous recursive drop()
+// Build: make bench   Run: ./bin/FloodFillBench.exe [size...]   (square boards, default 25x40 plus 128..1024)
+
+#include "../header/FloodFill.h"
+#include "../header/BitGrid.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+using namespace std;
+
+static const int ENEMIES = 10;
+
+// Previous implementation, kept here only as the baseline
+static void drop(int *grid, int rows, int cols, int y, int x)
+{
+    if (y < 0 || y >= rows || x < 0 || x >= cols)
+        return;
+    if (grid[y * cols + x] != 0)
+        return;
+
+    grid[y * cols + x] = -1;
+
+    drop(grid, rows, cols, y - 1, x);
+    drop(grid, rows, cols, y + 1, x);
+    drop(grid, rows, cols, y, x - 1);
+    drop(grid, rows, cols, y, x + 1);
+}
+
+// Border walls, a few player-trail walls cutting off pockets, enemies spread inside
+static void makeBoard(int *grid, int rows, int cols, int *seeds)
+{
+    srand(rows * 7919 + cols);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            bool border = i == 0 || j == 0 || i == rows - 1 || j == cols - 1;
+            grid[i * cols + j] = border || rand() % 100 < 15 ? 1 : 0;
+        }
+    }
+    for (int j = 1; j < cols - 1; j++)
+        grid[(rows / 3) * cols + j] = 2;
+    for (int i = 1; i < rows - 1; i++)
+        grid[i * cols + cols / 2] = 2;
+
+    for (int e = 0; e < ENEMIES; e++)
+    {
+        int r = 1 + rand() % (rows - 2);
+        int c = 1 + rand() % (cols - 2);
+        grid[r * cols + c] = 0;
+        seeds[e] = r * cols + c;
+    }
+}
+
+struct Job
+{
+    int *grid;
+    const int *board;
+    int rows, cols;
+    const int *seeds;
+    int reps;
+    double ms;
+};
+
+static void *runRecursive(void *arg)
+{
+    Job *job = (Job *)arg;
+    size_t bytes = (size_t)job->rows * job->cols * sizeof(int);
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < job->reps; r++)
+    {
+        memcpy(job->grid, job->board, bytes);
+        for (int e = 0; e < ENEMIES; e++)
+            drop(job->grid, job->rows, job->cols, job->seeds[e] / job->cols, job->seeds[e] % job->cols);
+    }
+    job->ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / job->reps;
+    return nullptr;
+}
+
+// Deep recursion needs far more than the default stack on large boards
+static void runWithBigStack(Job &job)
+{
+#ifdef _WIN32
+    runRecursive(&job);  // Stack size is set at link time (see Makefile)
+#else
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, (size_t)1 << 30);
+    pthread_t thread;
+    if (pthread_create(&thread, &attr, runRecursive, &job) == 0)
+        pthread_join(thread, nullptr);
+    else
+        job.ms = -1;
+    pthread_attr_destroy(&attr);
+#endif
+}
+
+// Times include resetting the board, identical for both
+static void bench(int rows, int cols)
+{
+    int cells = rows * cols;
+    int *board = new int[cells];
+    int *a = new int[cells];
+    int *b = new int[cells];
+    int seeds[ENEMIES];
+    makeBoard(board, rows, cols, seeds);
+    int reps = cells <= 4096 ? 20000 : (cells <= 65536 ? 200 : 10);
+
+    Job job = {a, board, rows, cols, seeds, reps, 0};
+    runWithBigStack(job);
+
+    FloodFill fill;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++)
+    {
+        memcpy(b, board, cells * sizeof(int));
+        fill.fill(b, rows, cols, seeds, ENEMIES);
+    }
+    double scanMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / reps;
+
+    bool same = memcmp(a, b, cells * sizeof(int)) == 0;
+    cout << rows << "x" << cols << ": recursive " << job.ms << " ms, scanline " << scanMs
+         << " ms (" << (scanMs > 0 ? job.ms / scanMs : 0) << "x)" << (same ? "" : "  MISMATCH") << endl;
+
+    delete[] board;
+    delete[] a;
+    delete[] b;
+}
+
+// Old capture step: drop() from every enemy, then convert -1/2/0 and count the trail
+static int captureRecursive(int *grid, int rows, int cols, const int *seeds)
+{
+    for (int e = 0; e < ENEMIES; e++)
+        drop(grid, rows, cols, seeds[e] / cols, seeds[e] % cols);
+    int captured = 0;
+    for (int i = 0; i < rows * cols; i++)
+    {
+        if (grid[i] == -1)
+            grid[i] = 0;
+        else if (grid[i] == 2)
+        {
+            grid[i] = 1;
+            captured++;
+        }
+        else if (grid[i] == 0)
+            grid[i] = 1;
+    }
+    return captured;
+}
+
+// Whole capture step, boards up to BitGrid::MAX_COLS wide
+static void benchCapture(int rows, int cols)
+{
+    int cells = rows * cols;
+    int *board = new int[cells];
+    int *a = new int[cells];
+    int *b = new int[cells];
+    int seeds[ENEMIES];
+    makeBoard(board, rows, cols, seeds);
+    const int reps = 20000;
+
+    int capturedA = 0, capturedB = 0;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++)
+    {
+        memcpy(a, board, cells * sizeof(int));
+        capturedA = captureRecursive(a, rows, cols, seeds);
+    }
+    double oldUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / reps;
+
+    BitGrid grid;
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++)
+    {
+        memcpy(b, board, cells * sizeof(int));
+        capturedB = grid.resolveCapture(b, rows, cols, 2, seeds, ENEMIES);
+    }
+    double bitUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / reps;
+
+    bool same = capturedA == capturedB && memcmp(a, b, cells * sizeof(int)) == 0;
+    cout << "capture " << rows << "x" << cols << ": recursive + int scan " << oldUs << " us, bit planes " << bitUs
+         << " us (" << (bitUs > 0 ? oldUs / bitUs : 0) << "x)" << (same ? "" : "  MISMATCH") << endl;
+
+    delete[] board;
+    delete[] a;
+    delete[] b;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; i++)
+            bench(atoi(argv[i]), atoi(argv[i]));
+        return 0;
+    }
+
+    bench(25, 40);  // The game board
+    bench(128, 128);
+    bench(512, 512);
+    bench(1024, 1024);
+
+    benchCapture(25, 40);
+    benchCapture(64, 64);
+    return 0;
+}
@@ -0,0 +1,129 @@
+// Xonix Game
+// Benchmark - dispatched grid kernels vs the scalar reference, after checking they agree
+// Build: make bench   Run: ./bin/GridKernelsBench.exe [boards]   (exit code 1 on any mismatch)
+
+#include "../header/GridKernels.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+// Values the game writes (-1 reach mark, 0 empty, 1 wall, 2/3 trails) plus the odd stray
+static void randomCells(int *cells, int count)
+{
+    static const int values[] = {-1, 0, 1, 2, 3, 0, 1, -1, 7};
+    int bias = rand() % 9;
+    for (int i = 0; i < count; i++)
+        cells[i] = rand() % 4 == 0 ? values[bias] : values[rand() % 9];
+}
+
+// Randomized boards of every width up to 64 (all vector tails), each kernel bit-for-bit
+static int verify(const GridKernels &fast, const GridKernels &ref, int boards)
+{
+    int *a = new int[64 * 64];
+    int *b = new int[64 * 64];
+    int mismatches = 0;
+
+    for (int n = 0; n < boards; n++)
+    {
+        int rows = 1 + rand() % 64;
+        int cols = 1 + rand() % 64;
+        int count = rows * cols;
+        int trailValue = 2 + rand() % 2;
+        randomCells(a, count);
+        memcpy(b, a, count * sizeof(int));
+
+        int capturedA = ref.rewriteCapture(a, count, trailValue);
+        int capturedB = fast.rewriteCapture(b, count, trailValue);
+        if (capturedA != capturedB || memcmp(a, b, count * sizeof(int)) != 0)
+            mismatches++;
+
+        randomCells(a, count);
+        int value = rand() % 5 - 1;
+        if (ref.countValue(a, count, value) != fast.countValue(a, count, value))
+            mismatches++;
+
+        for (int r = 0; r < rows; r++)
+        {
+            uint64_t w1, t1, e1, w2, t2, e2;
+            ref.packRow(a + r * cols, cols, trailValue, &w1, &t1, &e1);
+            fast.packRow(a + r * cols, cols, trailValue, &w2, &t2, &e2);
+            if (w1 != w2 || t1 != t2 || e1 != e2)
+            {
+                mismatches++;
+                break;
+            }
+        }
+    }
+
+    delete[] a;
+    delete[] b;
+    return mismatches;
+}
+
+static double timeRewrite(const GridKernels &k, const int *board, int *work, int count, int reps)
+{
+    int sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++)
+    {
+        memcpy(work, board, count * sizeof(int));
+        sink += k.rewriteCapture(work, count, 2);
+    }
+    double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / reps;
+    return sink == -1 ? 0 : us;
+}
+
+static double timePack(const GridKernels &k, const int *board, int rows, int cols, int reps)
+{
+    uint64_t sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++)
+    {
+        for (int row = 0; row < rows; row++)
+        {
+            uint64_t w, t, e;
+            k.packRow(board + row * cols, cols, 2, &w, &t, &e);
+            sink ^= w ^ t ^ e;
+        }
+    }
+    double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / reps;
+    return sink == 1 ? 0 : us;
+}
+
+int main(int argc, char *argv[])
+{
+    int boards = argc > 1 ? atoi(argv[1]) : 20000;
+    const GridKernels &fast = gridKernels();
+    const GridKernels &ref = scalarGridKernels();
+
+    srand(12345);
+    int mismatches = verify(fast, ref, boards);
+    cout << "kernels: " << fast.name << ", " << boards << " random boards, " << mismatches << " mismatches" << endl;
+    if (mismatches > 0)
+        return 1;
+
+    // The game board and the largest board BitGrid packs
+    const int sizes[][2] = {{25, 40}, {64, 64}};
+    for (const auto &size : sizes)
+    {
+        int rows = size[0], cols = size[1], count = rows * cols;
+        int *board = new int[count];
+        int *work = new int[count];
+        randomCells(board, count);
+
+        const int reps = 200000;
+        double rewriteRef = timeRewrite(ref, board, work, count, reps);
+        double rewriteFast = timeRewrite(fast, board, work, count, reps);
+        double packRef = timePack(ref, board, rows, cols, reps);
+        double packFast = timePack(fast, board, rows, cols, reps);
+        cout << rows << "x" << cols << ": rewrite+count " << rewriteRef << " -> " << rewriteFast << " us, pack "
+             << packRef << " -> " << packFast << " us" << endl;
+
+        delete[] board;
+        delete[] work;
+    }
+    return 0;
+}
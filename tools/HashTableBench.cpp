@@ -0,0 +1,133 @@
+// Xonix Game
+// Benchmark - open-addressing HashTable vs the previous chained table (53 buckets)
+// Build: make bench   Run: ./bin/HashTableBench.exe [entries...]
+
+#include "../data_structures/HashTable.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+// Previous implementation, kept here only as the baseline
+class ChainedHashTable
+{
+private:
+    struct Node
+    {
+        string username;
+        string playerId;
+        int arrayIndex;
+        Node *next;
+    };
+
+    static const int TABLE_SIZE = 53;
+    Node *table[TABLE_SIZE];
+
+    int hashFunction(const string &username) const
+    {
+        unsigned long hash = 0;
+        for (int i = 0; i < (int)username.length(); i++)
+            hash = hash * 31 + username[i];
+        return hash % TABLE_SIZE;
+    }
+
+public:
+    ChainedHashTable()
+    {
+        for (int i = 0; i < TABLE_SIZE; i++)
+            table[i] = nullptr;
+    }
+
+    ~ChainedHashTable()
+    {
+        for (int i = 0; i < TABLE_SIZE; i++)
+        {
+            while (table[i])
+            {
+                Node *next = table[i]->next;
+                delete table[i];
+                table[i] = next;
+            }
+        }
+    }
+
+    // Benchmark keys are unique, so skip the duplicate scan - this flatters the baseline,
+    // but the real update-or-insert is O(n^2 / 53) to fill and never finishes at 1M
+    void insert(const string &username, const string &playerId, int arrayIndex)
+    {
+        int index = hashFunction(username);
+        table[index] = new Node{username, playerId, arrayIndex, table[index]};
+    }
+
+    bool exists(const string &username) const
+    {
+        for (Node *n = table[hashFunction(username)]; n; n = n->next)
+        {
+            if (n->username == username)
+                return true;
+        }
+        return false;
+    }
+};
+
+static double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+template <class Table>
+static void run(const char *name, int entries, const string *keys, int lookups)
+{
+    Table table;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < entries; i++)
+        table.insert(keys[i], to_string(i), i);
+    double insertMs = elapsedMs(start);
+
+    // Half hits, half misses
+    int found = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < lookups; i++)
+    {
+        if (i & 1)
+            found += table.exists(keys[(i * 7919) % entries]);
+        else
+            found += table.exists("missing_" + to_string(i));
+    }
+    double lookupMs = elapsedMs(start);
+
+    cout << "  " << name << ": insert " << insertMs << " ms, "
+         << lookups << " lookups " << lookupMs << " ms ("
+         << (lookupMs * 1e6 / lookups) << " ns/op, " << found << " hits)\n";
+}
+
+int main(int argc, char *argv[])
+{
+    int sizes[16] = {1000, 100000, 1000000};
+    int sizeCount = 3;
+    if (argc > 1)
+    {
+        sizeCount = 0;
+        for (int i = 1; i < argc && sizeCount < 16; i++)
+            sizes[sizeCount++] = atoi(argv[i]);
+    }
+
+    for (int s = 0; s < sizeCount; s++)
+    {
+        int entries = sizes[s];
+        string *keys = new string[entries];
+        for (int i = 0; i < entries; i++)
+            keys[i] = "player" + to_string(i * 2654435761u % 100000007u);
+
+        // Chained lookups are O(n/53), so cap their count to keep the run short
+        int lookups = 200000;
+        cout << entries << " entries\n";
+        run<HashTable>("open addressing", entries, keys, lookups);
+        run<ChainedHashTable>("chained (53)  ", entries, keys, entries > 100000 ? 2000 : lookups);
+
+        delete[] keys;
+    }
+    return 0;
+}
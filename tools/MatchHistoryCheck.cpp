@@ -0,0 +1,167 @@
+// Xonix Game
+// Match history check - appends random games against many opponents and compares every
+// query with a brute-force scan of the same games, fails on any mismatch
+// Build and run: make test
+
+#include "../header/MatchHistory.h"
+#include "../header/GameRng.h"
+#include <iostream>
+#include <cstdio>
+
+using namespace std;
+
+const int GAMES = 5000;
+const int OPPONENTS = 300;
+const int LEVELS = 10;  // Past MATCH_LEVELS, so the shared top chain is covered
+const int CHECKPOINTS[] = {1, 17, 500, GAMES};  // The opponent table grows between them
+const char *PLAYER = "check";
+
+static int failures = 0;
+
+static void expect(bool ok, const char *query, int detail)
+{
+    if (ok)
+        return;
+    if (failures < 10)
+        cout << "  MISMATCH in " << query << " (" << detail << ")" << endl;
+    failures++;
+}
+
+static bool sameRecord(const MatchRecord &a, const MatchRecord &b)
+{
+    return a.timestamp == b.timestamp && a.opponentId == b.opponentId && a.score == b.score &&
+           a.level == b.level && a.result == b.result;
+}
+
+// Newest first, like the queries
+static bool matches(const MatchRecord &r, int32_t opponent, int level, int64_t from, int64_t to)
+{
+    return (opponent == OPPONENT_UNKNOWN || r.opponentId == opponent) && (level < 0 || r.level == level) &&
+           r.timestamp >= from && r.timestamp <= to;
+}
+
+static int bruteForce(const MatchRecord *games, int played, int32_t opponent, int level, int64_t from, int64_t to,
+                      int limit, MatchRecord *out)
+{
+    int n = 0;
+    for (int i = played - 1; i >= 0 && n < limit; i--)
+        if (matches(games[i], opponent, level, from, to))
+            out[n++] = games[i];
+    return n;
+}
+
+static void compare(const char *query, int detail, const MatchRecord *got, int gotCount, const MatchRecord *want,
+                    int wantCount)
+{
+    expect(gotCount == wantCount, query, detail);
+    for (int i = 0; i < gotCount && i < wantCount; i++)
+        expect(sameRecord(got[i], want[i]), query, detail);
+}
+
+static void checkAll(const MatchRecord *games, int played, GameRng &rng, MatchRecord *got, MatchRecord *want)
+{
+    MatchHistory &history = MatchHistory::instance();
+    const int64_t ALL_FROM = INT64_MIN, ALL_TO = INT64_MAX;
+
+    MatchStats s;
+    int wins = 0, losses = 0, solo = 0, best = 0;
+    int64_t total = 0;
+    for (int i = 0; i < played; i++)
+    {
+        wins += games[i].result == MATCH_WIN;
+        losses += games[i].result == MATCH_LOSS;
+        solo += games[i].result == MATCH_SOLO;
+        total += games[i].score;
+        if (games[i].score > best)
+            best = games[i].score;
+    }
+    expect(history.getStats(PLAYER, s) && (int)s.count == played && (int)s.wins == wins &&
+               (int)s.losses == losses && (int)s.solo == solo && s.totalScore == total && s.bestScore == best,
+           "getStats", played);
+
+    int n = history.lastMatches(PLAYER, 50, got);
+    compare("lastMatches", 50, got, n, want, bruteForce(games, played, OPPONENT_UNKNOWN, -1, ALL_FROM, ALL_TO, 50, want));
+
+    for (int32_t opponent = OPPONENT_NONE; opponent <= OPPONENTS; opponent++)
+    {
+        OpponentSummary summary;
+        int expected = bruteForce(games, played, opponent, -1, ALL_FROM, ALL_TO, GAMES, want);
+        int expectedWins = 0;
+        for (int i = 0; i < expected; i++)
+            expectedWins += want[i].result == MATCH_WIN;
+        bool found = history.headToHead(PLAYER, opponent, summary);
+        expect(found == (expected > 0) && (int)summary.games == expected && (int)summary.wins == expectedWins,
+               "headToHead", opponent);
+
+        n = history.byOpponent(PLAYER, opponent, GAMES, got);
+        compare("byOpponent", opponent, got, n, want, expected);
+    }
+
+    for (int level = 0; level <= LEVELS; level++)
+    {
+        n = history.byLevel(PLAYER, level, GAMES, got);
+        compare("byLevel", level, got, n, want, bruteForce(games, played, OPPONENT_UNKNOWN, level, ALL_FROM, ALL_TO, GAMES, want));
+    }
+
+    for (int i = 0; i < 20; i++)
+    {
+        int64_t from = games[rng.below(played)].timestamp - rng.below(3);
+        int64_t to = from + rng.below(200);
+        int limit = 1 + rng.below(100);
+        n = history.inRange(PLAYER, from, to, limit, got);
+        compare("inRange", i, got, n, want, bruteForce(games, played, OPPONENT_UNKNOWN, -1, from, to, limit, want));
+    }
+}
+
+int main()
+{
+    MatchHistory &history = MatchHistory::instance();
+    history.setDataDir("bin/");
+    string base = string("bin/") + PLAYER;
+    remove((base + ".matches").c_str());
+    remove((base + ".opponents").c_str());
+
+    GameRng rng(2024);
+    MatchRecord *games = new MatchRecord[GAMES];
+    MatchRecord *got = new MatchRecord[GAMES];
+    MatchRecord *want = new MatchRecord[GAMES];
+
+    int64_t clock = 1700000000;
+    int checkpoint = 0;
+    for (int played = 1; played <= GAMES; played++)
+    {
+        MatchRecord record = {};
+        clock += rng.below(90);
+        // Now and then a clock step backwards - the history keeps timestamps sorted
+        record.timestamp = rng.below(50) == 0 ? clock - 500 : clock;
+        record.opponentId = rng.below(10) == 0 ? OPPONENT_NONE : 1 + rng.below(OPPONENTS);
+        record.score = rng.below(400);
+        record.level = (int16_t)(1 + rng.below(LEVELS));
+        record.result = record.opponentId == OPPONENT_NONE ? MATCH_SOLO : (rng.below(2) ? MATCH_WIN : MATCH_LOSS);
+        if (!history.append(PLAYER, record))
+        {
+            cout << "append failed at game " << played << endl;
+            return 1;
+        }
+
+        int64_t previous = played > 1 ? games[played - 2].timestamp : record.timestamp;
+        if (record.timestamp < previous)
+            record.timestamp = previous;
+        games[played - 1] = record;
+
+        if (played == CHECKPOINTS[checkpoint])
+        {
+            int before = failures;
+            checkAll(games, played, rng, got, want);
+            cout << played << " games: " << (failures == before ? "OK" : "MISMATCH") << endl;
+            checkpoint++;
+        }
+    }
+
+    remove((base + ".matches").c_str());
+    remove((base + ".opponents").c_str());
+    delete[] games;
+    delete[] got;
+    delete[] want;
+    return failures == 0 ? 0 : 1;
+}
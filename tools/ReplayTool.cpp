@@ -0,0 +1,49 @@
+// Xonix Game
+// Headless replay check - re-simulates each replay as fast as it runs and compares the final
+// score and length with what was recorded; a mismatch means the rules changed under the replay
+// Build: make replay   Run: ./bin/ReplayTool.exe FILE.xrp [FILE.xrp ...]
+
+#include "../header/Replay.h"
+#include <iostream>
+#include <chrono>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "Usage: " << argv[0] << " FILE.xrp [FILE.xrp ...]" << endl;
+        return 1;
+    }
+
+    XonixEngine engine;
+    int failed = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        Replay replay;
+        if (!replay.load(argv[i]))
+        {
+            failed++;
+            continue;
+        }
+
+        auto start = chrono::steady_clock::now();
+        bool ok = verifyReplay(replay, engine);
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        const EngineState &end = engine.state();
+
+        cout << argv[i] << ": level " << replay.getLevel() << ", seed " << replay.getSeed() << ", "
+             << replay.getTicks() * SIM_STEP << " s, " << replay.getEventCount() << " inputs in "
+             << replay.getEventBytes() << " bytes" << endl;
+        cout << "  recorded score " << replay.getScore() << ", replayed " << end.players[0].score << " after "
+             << end.ticks << "/" << replay.getTicks() << " ticks - " << (ok ? "OK" : "MISMATCH");
+        if (elapsed > 0)
+            cout << " (" << end.ticks * SIM_STEP / elapsed << "x real time)";
+        cout << endl;
+
+        if (!ok)
+            failed++;
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+// Xonix Game
+// Benchmark - incremental Territory capture vs the whole-board BitGrid resolve on simulated games
+// Build: make bench   Run: ./bin/TerritoryBench.exe [captures]   (exit code 1 on any mismatch)
+
+#include "../header/Territory.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+static const int ENEMIES = 4;
+
+struct Walker
+{
+    int cell;
+    int dir;
+    int trailValue;
+};
+
+static const int DR[4] = {-1, 1, 0, 0};
+static const int DC[4] = {0, 0, -1, 1};
+
+static void newBoard(int *board, int rows, int cols, int *enemies)
+{
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < cols; c++)
+            board[r * cols + c] = (r == 0 || c == 0 || r == rows - 1 || c == cols - 1) ? 1 : 0;
+    for (int i = 0; i < ENEMIES; i++)
+        enemies[i] = (1 + rand() % (rows - 2)) * cols + 1 + rand() % (cols - 2);
+}
+
+// Enemies bounce off walls only, like the game, so they can wander onto a trail
+static void moveEnemies(const int *board, int rows, int cols, int *enemies)
+{
+    for (int i = 0; i < ENEMIES; i++)
+    {
+        int d = rand() % 4;
+        int r = enemies[i] / cols + DR[d], c = enemies[i] % cols + DC[d];
+        if (r >= 0 && r < rows && c >= 0 && c < cols && board[r * cols + c] != 1)
+            enemies[i] = r * cols + c;
+    }
+}
+
+// Mostly straight runs with the odd turn - long cuts that enclose real areas
+static int stepWalker(Walker &w, int rows, int cols)
+{
+    if (rand() % 8 == 0)
+        w.dir = rand() % 4;
+    int r = w.cell / cols + DR[w.dir], c = w.cell % cols + DC[w.dir];
+    if (r < 0 || r >= rows || c < 0 || c >= cols)
+    {
+        w.dir = rand() % 4;
+        return w.cell;
+    }
+    return r * cols + c;
+}
+
+static void play(int rows, int cols, int players, int target, int &captures, int &mismatches, double &bitUs,
+                 double &trackUs)
+{
+    int cells = rows * cols;
+    int *a = new int[cells];
+    int *b = new int[cells];
+    int enemies[ENEMIES];
+    BitGrid whole;
+    Territory tracker;
+
+    newBoard(a, rows, cols, enemies);
+    memcpy(b, a, cells * sizeof(int));
+    Walker walkers[2] = {{0, 3, 2}, {cells - 1, 2, 3}};
+
+    while (captures < target)
+    {
+        moveEnemies(a, rows, cols, enemies);
+        for (int p = 0; p < players; p++)
+        {
+            Walker &w = walkers[p];
+            int next = stepWalker(w, rows, cols);
+            if (a[next] == 2 || a[next] == 3)
+            {
+                // Crossed a trail: single player starts over, in two player the trail stays behind
+                if (players == 1)
+                {
+                    newBoard(a, rows, cols, enemies);
+                    memcpy(b, a, cells * sizeof(int));
+                    tracker.reset();
+                }
+                w.cell = 0;
+                continue;
+            }
+
+            w.cell = next;
+            if (a[next] == 0)
+            {
+                a[next] = b[next] = w.trailValue;
+                tracker.layTrail(next);
+                continue;
+            }
+
+            auto start = chrono::steady_clock::now();
+            int capturedA = whole.resolveCapture(a, rows, cols, w.trailValue, enemies, ENEMIES);
+            auto mid = chrono::steady_clock::now();
+            int capturedB = tracker.resolveCapture(b, rows, cols, w.trailValue, enemies, ENEMIES);
+            auto end = chrono::steady_clock::now();
+            bitUs += chrono::duration<double, micro>(mid - start).count();
+            trackUs += chrono::duration<double, micro>(end - mid).count();
+            captures++;
+
+            if (capturedA != capturedB || memcmp(a, b, cells * sizeof(int)) != 0)
+            {
+                mismatches++;
+                memcpy(b, a, cells * sizeof(int));
+                tracker.reset();
+            }
+        }
+
+        // Nearly full - start a fresh board
+        int open = 0;
+        for (int i = 0; i < cells; i++)
+            open += a[i] == 0;
+        if (open < cells / 10)
+        {
+            newBoard(a, rows, cols, enemies);
+            memcpy(b, a, cells * sizeof(int));
+            tracker.reset();
+        }
+    }
+
+    delete[] a;
+    delete[] b;
+}
+
+int main(int argc, char *argv[])
+{
+    int target = argc > 1 ? atoi(argv[1]) : 20000;
+    srand(12345);
+
+    // The game board, a two player game, and boards past BitGrid's one-word rows
+    const int configs[][3] = {{25, 40, 1}, {25, 40, 2}, {64, 64, 1}, {200, 200, 1}};
+    int failed = 0;
+    for (const auto &config : configs)
+    {
+        int captures = 0, mismatches = 0;
+        double bitUs = 0, trackUs = 0;
+        play(config[0], config[1], config[2], target, captures, mismatches, bitUs, trackUs);
+        cout << config[0] << "x" << config[1] << (config[2] == 2 ? " two players" : "") << ": " << captures
+             << " captures, bit planes " << bitUs / captures << " us, territory " << trackUs / captures << " us ("
+             << (trackUs > 0 ? bitUs / trackUs : 0) << "x)" << (mismatches ? "  MISMATCH x" : "");
+        if (mismatches)
+            cout << mismatches;
+        cout << endl;
+        failed += mismatches;
+    }
+    return failed > 0 ? 1 : 0;
+}